@@ -0,0 +1,44 @@
+#!/bin/sh
+# Compare the BDD package of ebmc against miniBDD on the BDD
+# regression tests.
+#
+# Usage: compare_bdd.sh <timeout-seconds> [options...]
+# The options are passed to both, e.g., --bdd-forward or --bdd-reorder.
+#
+# Environment:
+#   EBMC          path to ebmc                  (default: ../src/ebmc/ebmc)
+#   EBMC_MINIBDD  path to ebmc built with -DEBMC_MINIBDD in CXXFLAGS
+#                                               (default: ./ebmc-minibdd)
+EBMC=${EBMC:-../src/ebmc/ebmc}
+EBMC_MINIBDD=${EBMC_MINIBDD:-./ebmc-minibdd}
+TESTS=${TESTS:-../regression/ebmc/BDD}
+TIMEOUT=$1
+shift
+# the tests run in their directory
+EBMC=`cd \`dirname "$EBMC"\` && pwd`/`basename "$EBMC"`
+EBMC_MINIBDD=`cd \`dirname "$EBMC_MINIBDD"\` && pwd`/`basename "$EBMC_MINIBDD"`
+printf "%-28s %10s %10s %8s %8s\n" test ce_bdd miniBDD ce_res mini_res
+for desc in "$TESTS"/*.desc; do
+  name=`basename "$desc" .desc`
+  file=`sed -n 2p "$desc"`
+  options=`sed -n 3p "$desc"`
+  # only the tests that use the BDD engine
+  echo "$options" | grep -q -- "--bdd" || continue
+  for package in ce mini; do
+    if [ $package = ce ]; then binary=$EBMC; else binary=$EBMC_MINIBDD; fi
+    start=`perl -MTime::HiRes=time -e 'printf "%.3f", time'`
+    out=`cd "$TESTS" && perl -e 'alarm shift @ARGV; exec @ARGV' $TIMEOUT \
+      "$binary" "$file" $options "$@" 2>&1`
+    status=$?
+    end=`perl -MTime::HiRes=time -e 'printf "%.3f", time'`
+    t=`echo "$end $start" | awk '{printf "%.2f", $1-$2}'`
+    if [ $status = 142 ]; then res=TIMEOUT; t="-"
+    elif [ $status = 0 ] || [ $status = 10 ]; then
+      # the number of properties with a result
+      res=`echo "$out" | grep -c "PROVED\|REFUTED"`
+    else res="err($status)"
+    fi
+    if [ $package = ce ]; then ce_t=$t; ce_r=$res; else mini_t=$t; mini_r=$res; fi
+  done
+  printf "%-28s %10s %10s %8s %8s\n" "$name" "$ce_t" "$mini_t" "$ce_r" "$mini_r"
+done
@@ -0,0 +1,15 @@
+module main(input clk);
+
+  reg [7:0] counter;
+  initial counter = 0;
+
+  always @(posedge clk)
+    counter = counter + 1;
+
+  // fails in the fourth state
+  always assert p1: counter != 3;
+
+  // holds up to bound 10
+  always assert p2: counter != 20;
+
+endmodule
@@ -0,0 +1,16 @@
+module main(input clk);
+
+  reg [7:0] a = 0;
+  reg [7:0] b = 0;
+  reg [7:0] c = 0;
+  always_ff @(posedge clk) a <= a + 1;
+  always_ff @(posedge clk) b <= b + 2;
+  always_ff @(posedge clk) c <= b + 1;
+
+  // the cone is a
+  p0: assert property (a != 5);
+
+  // the cone is b
+  p1: assert property (b[0] == 0);
+
+endmodule
@@ -0,0 +1,13 @@
+module main(input clk, input [1039:0] in);
+
+  // a large cycle with shallow logic, scheduled for BMC
+  reg [1039:0] ring = 0;
+  always_ff @(posedge clk) ring <= {ring[1038:0], ring[1039]} ^ in;
+
+  reg flag = 0;
+  always_ff @(posedge clk) flag <= flag && ring[0];
+
+  // inductive, hence proved by the heuristic
+  p0: assert property (!flag);
+
+endmodule
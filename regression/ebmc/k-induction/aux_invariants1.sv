@@ -0,0 +1,17 @@
+module main(input clk, input en);
+
+  reg [7:0] x, y;
+
+  initial x = 0;
+  initial y = 0;
+
+  always @(posedge clk)
+    if(en) begin
+      x <= x + 1;
+      y <= y + 1;
+    end
+
+  // true, but only inductive given x == y
+  p0: assert property (x == 5 -> y == 5);
+
+endmodule
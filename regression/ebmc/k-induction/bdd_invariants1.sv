@@ -0,0 +1,19 @@
+module main(input clk);
+
+  reg a, b, c;
+
+  initial a = 1;
+  initial b = 0;
+  initial c = 0;
+
+  // a one-hot ring
+  always @(posedge clk) begin
+    a <= c;
+    b <= a;
+    c <= b;
+  end
+
+  // true, but only inductive given that exactly one bit is set
+  p0: assert property (!(a && b));
+
+endmodule
@@ -0,0 +1,28 @@
+module main(input clk);
+
+  reg a, b, c;
+
+  initial a = 0;
+  initial b = 0;
+  initial c = 0;
+
+  always @(posedge clk) begin
+    a <= 0;
+    b <= a;
+    c <= b;
+  end
+
+  // true, and 3-inductive
+  p0: assert property (!c);
+
+  reg [1:0] cnt;
+
+  initial cnt = 0;
+
+  always @(posedge clk)
+    cnt <= cnt + 1;
+
+  // false, found with k=2
+  p1: assert property (cnt != 2);
+
+endmodule
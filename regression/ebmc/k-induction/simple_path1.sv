@@ -0,0 +1,21 @@
+module main(input clk, input i);
+
+  reg [1:0] x;
+
+  initial x = 0;
+
+  // 0 and 1 alternate; 2 is unreachable, and
+  // may stay at 2 forever or move to 3
+  always @(posedge clk)
+    case(x)
+      0: x <= 1;
+      1: x <= 0;
+      2: x <= i ? 3 : 2;
+      3: x <= 3;
+    endcase
+
+  // true, but not k-inductive for any k;
+  // 2-inductive over paths with distinct states
+  p0: assert property (x != 3);
+
+endmodule
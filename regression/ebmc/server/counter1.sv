@@ -0,0 +1,14 @@
+module main(input clk);
+
+  reg [3:0] cnt = 0;
+  reg [3:0] shadow = 0;
+  always_ff @(posedge clk) cnt <= cnt + 1;
+  always_ff @(posedge clk) shadow <= shadow + 1;
+
+  // fails after three cycles
+  p0: assert property (cnt != 3);
+
+  // inductive
+  p1: assert property (cnt == shadow);
+
+endmodule
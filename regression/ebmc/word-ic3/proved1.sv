@@ -0,0 +1,14 @@
+module main(input clk);
+
+  // too wide for the bit-level engines
+  reg [63:0] x;
+
+  initial x = 0;
+
+  always @(posedge clk)
+    if(x != 100)
+      x <= x + 1;
+
+  p0: assert property (x <= 100);
+
+endmodule
@@ -0,0 +1,20 @@
+module main(input clk);
+
+  // The property needs the invariant x == y, which is not
+  // among the initial predicates.
+  reg [31:0] x, y;
+  reg z;
+
+  initial x = 0;
+  initial y = 0;
+  initial z = 0;
+
+  always @(posedge clk) begin
+    x <= x + 1;
+    y <= y + 1;
+    z <= x != y;
+  end
+
+  p0: assert property (!z);
+
+endmodule
@@ -0,0 +1,12 @@
+module main(input clk);
+
+  reg [31:0] x;
+
+  initial x = 0;
+
+  always @(posedge clk)
+    x <= x + 3;
+
+  p0: assert property (x != 9);
+
+endmodule
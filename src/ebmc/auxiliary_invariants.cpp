@@ -0,0 +1,497 @@
+/*******************************************************************\
+
+Module: Auxiliary Invariants
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+#include "auxiliary_invariants.h"
+
+#include <util/std_expr.h>
+
+#include <trans-word-level/instantiate_word_level.h>
+#include <trans-word-level/trans_trace_word_level.h>
+#include <trans-word-level/unwind.h>
+
+#include "ebmc_error.h"
+#include "random_traces.h"
+#include "transition_system.h"
+
+#include <map>
+#include <unordered_map>
+
+/*******************************************************************\
+
+   Class: auxiliary_invariantst
+
+ Purpose: Candidate invariants from simulation, filtered by Houdini
+
+\*******************************************************************/
+
+class auxiliary_invariantst
+{
+public:
+  auxiliary_invariantst(
+    const transition_systemt &_transition_system,
+    const exprt::operandst &_assumptions,
+    const ebmc_solver_factoryt &_solver_factory,
+    message_handlert &_message_handler)
+    : transition_system(_transition_system),
+      assumptions(_assumptions),
+      solver_factory(_solver_factory),
+      ns(_transition_system.symbol_table),
+      message(_message_handler),
+      state_variables(_transition_system.state_variables())
+  {
+  }
+
+  exprt::operandst operator()();
+
+protected:
+  const transition_systemt &transition_system;
+  const exprt::operandst &assumptions;
+  const ebmc_solver_factoryt &solver_factory;
+  const namespacet ns;
+  messaget message;
+  const std::vector<symbol_exprt> state_variables;
+
+  static constexpr std::size_t NUMBER_OF_TRACES = 20;
+  static constexpr std::size_t NUMBER_OF_TRACE_STEPS = 10;
+
+  // Bound on the number of implication candidates, which are
+  // quadratic in the number of Boolean state variables.
+  static constexpr std::size_t MAX_IMPLICATIONS = 1000;
+
+  // the values of the state variables, by sampled state;
+  // nil when unknown
+  std::vector<exprt::operandst> samples;
+
+  void sample();
+  void add_sample(const trans_tracet::statet &);
+  exprt::operandst candidates() const;
+
+  // the candidates that fail are removed
+  void initiation(exprt::operandst &);
+  void consecution(exprt::operandst &);
+
+  bool is_sat(decision_proceduret &, const exprt &assumption);
+};
+
+/*******************************************************************\
+
+Function: auxiliary_invariantst::add_sample
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void auxiliary_invariantst::add_sample(const trans_tracet::statet &state)
+{
+  std::unordered_map<irep_idt, exprt> values;
+
+  for(auto &assignment : state.assignments)
+  {
+    if(assignment.lhs.id() == ID_symbol)
+      values[to_symbol_expr(assignment.lhs).get_identifier()] =
+        assignment.rhs;
+  }
+
+  exprt::operandst sample;
+  sample.reserve(state_variables.size());
+
+  for(auto &var : state_variables)
+  {
+    auto value_it = values.find(var.get_identifier());
+    if(value_it == values.end() || !value_it->second.is_constant())
+      sample.push_back(nil_exprt{});
+    else
+      sample.push_back(value_it->second);
+  }
+
+  samples.push_back(std::move(sample));
+}
+
+/*******************************************************************\
+
+Function: auxiliary_invariantst::sample
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: Obtain reachable states by random simulation. Without
+          inputs, a single trace is taken.
+
+\*******************************************************************/
+
+void auxiliary_invariantst::sample()
+{
+  auto consumer = [this](trans_tracet trace)
+  {
+    for(auto &state : trace.states)
+      add_sample(state);
+  };
+
+  if(!transition_system.inputs().empty())
+  {
+    random_traces(
+      transition_system,
+      consumer,
+      NUMBER_OF_TRACES,
+      NUMBER_OF_TRACE_STEPS,
+      solver_factory,
+      message.get_message_handler());
+    return;
+  }
+
+  const std::size_t no_timeframes = NUMBER_OF_TRACE_STEPS + 1;
+
+  auto solver_wrapper = solver_factory(ns, message.get_message_handler());
+  auto &solver = solver_wrapper.decision_procedure();
+
+  unwind(
+    transition_system.trans_expr,
+    message.get_message_handler(),
+    solver,
+    no_timeframes,
+    ns,
+    true);
+
+  // keep the state variables
+  for(std::size_t t = 0; t < no_timeframes; t++)
+    for(auto &var : state_variables)
+      (void)solver.handle(instantiate(var, t, no_timeframes));
+
+  if(is_sat(solver, true_exprt{}))
+  {
+    consumer(compute_trans_trace(
+      solver, no_timeframes, ns, transition_system.main_symbol->name));
+  }
+}
+
+/*******************************************************************\
+
+Function: auxiliary_invariantst::candidates
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: The predicates that hold in all sampled states
+
+\*******************************************************************/
+
+exprt::operandst auxiliary_invariantst::candidates() const
+{
+  exprt::operandst result;
+
+  if(samples.empty())
+    return result;
+
+  // The values of each variable over all samples. Variables with
+  // unknown values are not used.
+  std::map<exprt::operandst, std::size_t> representatives;
+  std::vector<std::size_t> boolean_representatives;
+
+  for(std::size_t i = 0; i < state_variables.size(); i++)
+  {
+    const auto &var = state_variables[i];
+
+    exprt::operandst signature;
+    signature.reserve(samples.size());
+
+    for(auto &sample : samples)
+      signature.push_back(sample[i]);
+
+    bool unknown = false;
+    for(auto &value : signature)
+      if(value.is_nil())
+        unknown = true;
+
+    if(unknown)
+      continue;
+
+    bool constant = true;
+    for(auto &value : signature)
+      if(value != signature.front())
+        constant = false;
+
+    if(constant)
+    {
+      result.push_back(equal_exprt{var, signature.front()});
+      continue;
+    }
+
+    // the values carry their type, hence equal signatures imply
+    // equal types
+    auto insert_result = representatives.emplace(signature, i);
+
+    if(!insert_result.second)
+    {
+      result.push_back(
+        equal_exprt{var, state_variables[insert_result.first->second]});
+      continue;
+    }
+
+    if(var.type().id() != ID_bool)
+      continue;
+
+    exprt::operandst negated;
+    negated.reserve(signature.size());
+    for(auto &value : signature)
+    {
+      if(value.is_true())
+        negated.push_back(false_exprt{});
+      else
+        negated.push_back(true_exprt{});
+    }
+
+    auto negated_it = representatives.find(negated);
+
+    if(negated_it != representatives.end())
+    {
+      result.push_back(
+        equal_exprt{var, not_exprt{state_variables[negated_it->second]}});
+      continue;
+    }
+
+    boolean_representatives.push_back(i);
+  }
+
+  // implications between the remaining Boolean variables
+  std::size_t number_of_implications = 0;
+
+  for(auto a : boolean_representatives)
+    for(auto b : boolean_representatives)
+    {
+      if(a == b || number_of_implications >= MAX_IMPLICATIONS)
+        continue;
+
+      bool holds = true;
+      for(auto &sample : samples)
+        if(sample[a].is_true() && sample[b].is_false())
+        {
+          holds = false;
+          break;
+        }
+
+      if(holds)
+      {
+        result.push_back(
+          implies_exprt{state_variables[a], state_variables[b]});
+        number_of_implications++;
+      }
+    }
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: auxiliary_invariantst::is_sat
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+bool auxiliary_invariantst::is_sat(
+  decision_proceduret &solver,
+  const exprt &assumption)
+{
+  switch(solver(assumption))
+  {
+  case decision_proceduret::resultt::D_SATISFIABLE:
+    return true;
+
+  case decision_proceduret::resultt::D_UNSATISFIABLE:
+    return false;
+
+  case decision_proceduret::resultt::D_ERROR:
+    throw ebmc_errort() << "Error from decision procedure";
+  }
+
+  UNREACHABLE;
+}
+
+/*******************************************************************\
+
+Function: auxiliary_invariantst::initiation
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: Remove the candidates that fail in some initial state
+
+\*******************************************************************/
+
+void auxiliary_invariantst::initiation(exprt::operandst &candidates)
+{
+  auto solver_wrapper = solver_factory(ns, message.get_message_handler());
+  auto &solver = solver_wrapper.decision_procedure();
+
+  unwind(
+    transition_system.trans_expr,
+    message.get_message_handler(),
+    solver,
+    1,
+    ns,
+    true);
+
+  for(auto &assumption : assumptions)
+    solver.set_to_true(instantiate(assumption, 0, 1));
+
+  exprt::operandst handles;
+  handles.reserve(candidates.size());
+
+  for(auto &candidate : candidates)
+    handles.push_back(solver.handle(instantiate(candidate, 0, 1)));
+
+  // Each model removes at least one candidate.
+  while(!candidates.empty() && is_sat(solver, not_exprt{conjunction(handles)}))
+  {
+    std::size_t j = 0;
+
+    for(std::size_t i = 0; i < candidates.size(); i++)
+    {
+      if(solver.get(handles[i]).is_true())
+      {
+        candidates[j] = std::move(candidates[i]);
+        handles[j] = std::move(handles[i]);
+        j++;
+      }
+    }
+
+    candidates.resize(j);
+    handles.resize(j);
+  }
+}
+
+/*******************************************************************\
+
+Function: auxiliary_invariantst::consecution
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: Remove candidates until the remaining ones are inductive
+
+\*******************************************************************/
+
+void auxiliary_invariantst::consecution(exprt::operandst &candidates)
+{
+  auto solver_wrapper = solver_factory(ns, message.get_message_handler());
+  auto &solver = solver_wrapper.decision_procedure();
+
+  // *no* initial state
+  unwind(
+    transition_system.trans_expr,
+    message.get_message_handler(),
+    solver,
+    2,
+    ns,
+    false);
+
+  for(auto &assumption : assumptions)
+    for(std::size_t t = 0; t < 2; t++)
+      solver.set_to_true(instantiate(assumption, t, 2));
+
+  exprt::operandst current, next;
+  current.reserve(candidates.size());
+  next.reserve(candidates.size());
+
+  for(auto &candidate : candidates)
+  {
+    current.push_back(solver.handle(instantiate(candidate, 0, 2)));
+    next.push_back(solver.handle(instantiate(candidate, 1, 2)));
+  }
+
+  // Each model removes at least one candidate.
+  while(!candidates.empty() &&
+        is_sat(
+          solver,
+          and_exprt{conjunction(current), not_exprt{conjunction(next)}}))
+  {
+    std::size_t j = 0;
+
+    for(std::size_t i = 0; i < candidates.size(); i++)
+    {
+      if(solver.get(next[i]).is_true())
+      {
+        candidates[j] = std::move(candidates[i]);
+        current[j] = std::move(current[i]);
+        next[j] = std::move(next[i]);
+        j++;
+      }
+    }
+
+    candidates.resize(j);
+    current.resize(j);
+    next.resize(j);
+  }
+}
+
+/*******************************************************************\
+
+Function: auxiliary_invariantst::operator()
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+exprt::operandst auxiliary_invariantst::operator()()
+{
+  message.status() << "Mining auxiliary invariants" << messaget::eom;
+
+  sample();
+
+  auto result = candidates();
+
+  message.statistics() << "Auxiliary invariants: " << result.size()
+                       << " candidate(s) from " << samples.size()
+                       << " sampled state(s)" << messaget::eom;
+
+  initiation(result);
+  consecution(result);
+
+  message.statistics() << "Auxiliary invariants: " << result.size()
+                       << " inductive" << messaget::eom;
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: auxiliary_invariants
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+exprt::operandst auxiliary_invariants(
+  const transition_systemt &transition_system,
+  const exprt::operandst &assumptions,
+  const ebmc_solver_factoryt &solver_factory,
+  message_handlert &message_handler)
+{
+  return auxiliary_invariantst{
+    transition_system, assumptions, solver_factory, message_handler}();
+}
@@ -0,0 +1,36 @@
+/*******************************************************************\
+
+Module: Auxiliary Invariants
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// Cheap auxiliary invariants over the state variables, for
+/// strengthening the step case of k-induction
+
+#ifndef CPROVER_EBMC_AUXILIARY_INVARIANTS_H
+#define CPROVER_EBMC_AUXILIARY_INVARIANTS_H
+
+#include <util/expr.h>
+#include <util/message.h>
+
+#include "ebmc_solver_factory.h"
+
+class transition_systemt;
+
+/// Mines candidate invariants from random simulation traces: state
+/// variables that are constant, pairs of state variables that are
+/// equal, and implications between Boolean state variables. A Houdini
+/// pass then removes candidates until the remaining set holds in the
+/// initial states and is inductive, assuming the given state
+/// predicates. Returns the remaining candidates, as state predicates
+/// over the (untimed) state variables.
+[[nodiscard]] exprt::operandst auxiliary_invariants(
+  const transition_systemt &,
+  const exprt::operandst &assumptions,
+  const ebmc_solver_factoryt &,
+  message_handlert &);
+
+#endif // CPROVER_EBMC_AUXILIARY_INVARIANTS_H
@@ -13,7 +13,6 @@ Author: Daniel Kroening, daniel.kroening@inf.ethz.ch
 
 #include <ebmc/liveness_to_safety.h>
 #include <ebmc/transition_system.h>
-#include <solvers/bdd/miniBDD/miniBDD.h>
 #include <solvers/prop/literal_expr.h>
 #include <solvers/sat/satcheck.h>
 #include <temporal-logic/ctl.h>
@@ -26,10 +25,19 @@ Author: Daniel Kroening, daniel.kroening@inf.ethz.ch
 #include <trans-netlist/unwind_netlist.h>
 
 #include "bdd_model_checker.h"
+#include "bdd_reordering.h"
+#include "checkpoint.h"
+#include "coi_hash.h"
+#include "ebmc_bdd.h"
+#include "ebmc_error.h"
+#include "engine_budget.h"
 #include "netlist.h"
 
 #include <algorithm>
 #include <iostream>
+#include <set>
+#include <sstream>
+#include <unordered_map>
 
 /*******************************************************************\
 
@@ -71,9 +79,9 @@ protected:
 
   // the Manager must appear before any BDDs
   // to do the cleanup in the right order
-  mini_bdd_mgrt mgr;
+  ebmc_bdd_mgrt mgr;
   
-  typedef mini_bddt BDD;
+  typedef ebmc_bddt BDD;
   
   struct atomic_propositiont
   {
@@ -109,9 +117,32 @@ protected:
   
   typedef std::map<bv_varidt, vart, ordering> varst;
   varst vars;
+
+  // for --checkpoint and --resume, with --bdd-forward
+  std::optional<checkpointert> checkpointer;
+
+  std::vector<std::string> forward_checkpoint_state(
+    const propertyt &,
+    unsigned iteration,
+    const BDD &reached,
+    const BDD &frontier) const;
+
+  bool restore_forward_checkpoint(
+    const propertyt &,
+    unsigned &iteration,
+    BDD &reached,
+    BDD &frontier);
   
   void allocate_vars(const var_mapt &);
+  std::vector<bv_varidt> fanin_order() const;
   void build_BDDs();
+
+  // Dynamic reordering, once the number of nodes has grown beyond
+  // the threshold
+  static constexpr std::size_t initial_reorder_threshold = 10000;
+  std::size_t reorder_threshold = initial_reorder_threshold;
+  bool reorder_needed();
+  void reorder(const std::vector<BDD *> &);
   
   inline BDD aig2bdd(
     literalt l,
@@ -134,6 +165,7 @@ protected:
     unsigned number_of_timeframes);
 
   void check_AGp(propertyt &);
+  void check_AGp_forward(propertyt &);
   void check_CTL(propertyt &);
   BDD CTL(const exprt &, bdd_model_checkert &);
 };
@@ -186,12 +218,22 @@ property_checker_resultt bdd_enginet::operator()()
       }
     }
 
+    if(has_checkpoint_options(cmdline))
+    {
+      checkpointer.emplace(
+        cmdline,
+        "bdd-forward",
+        netlist_hash(netlist),
+        message.get_message_handler());
+      checkpointer->restore_results(properties);
+    }
+
     message.status() << "Building BDD for netlist" << messaget::eom;
 
     allocate_vars(netlist.var_map);
     build_BDDs();
 
-    message.statistics() << "BDD nodes: " << mgr.number_of_nodes()
+    message.statistics() << "BDD nodes: " << number_of_live_nodes(mgr)
                          << messaget::eom;
 
     if(cmdline.isset("show-bdds"))
@@ -299,13 +341,180 @@ void bdd_enginet::allocate_vars(const var_mapt &var_map)
     }
   }
   
-  // now allocate BBD variables
-  for(auto &it : vars)
+  // now allocate BBD variables, with the next-state variable
+  // right after the current-state variable
+  for(const auto &id : fanin_order())
+  {
+    auto &var = vars.at(id);
+    std::string s = id.as_string();
+    var.current_bdd = mgr.Var(s);
+    var.next_bdd = mgr.Var(s + "'");
+  }
+}
+
+/*******************************************************************\
+
+Function: bdd_enginet::fanin_order
+
+  Inputs:
+
+ Outputs: the variables, in the order of a depth-first traversal of
+          the fan-in of the properties
+
+ Purpose: static variable ordering; the traversal continues into the
+          next-state functions of the latches it reaches
+
+\*******************************************************************/
+
+std::vector<bv_varidt> bdd_enginet::fanin_order() const
+{
+  std::unordered_map<literalt::var_not, bv_varidt> node_vars;
+
+  for(const auto &[id, var] : vars)
+    node_vars.emplace(var.current_aig.var_no(), id);
+
+  std::vector<literalt> roots;
+
+  for(const auto &[_, atomic_proposition] : atomic_propositions)
+    roots.push_back(atomic_proposition.l);
+
+  for(auto *literals :
+      {&netlist.constraints, &netlist.transition, &netlist.initial})
+  {
+    roots.insert(roots.end(), literals->begin(), literals->end());
+  }
+
+  std::vector<bv_varidt> order;
+  std::set<bv_varidt, ordering> placed;
+  std::vector<bool> visited(netlist.nodes.size(), false);
+
+  // the roots grow as latches are reached
+  for(std::size_t i = 0; i < roots.size(); i++)
   {
-    std::string s=it.first.as_string();
-    it.second.current_bdd = mgr.Var(s);
-    it.second.next_bdd = mgr.Var(s + "'");
+    std::vector<literalt> stack{roots[i]};
+
+    while(!stack.empty())
+    {
+      literalt l = stack.back();
+      stack.pop_back();
+
+      if(l.is_constant() || visited[l.var_no()])
+        continue;
+
+      visited[l.var_no()] = true;
+      const netlistt::nodet &n = netlist.nodes[l.var_no()];
+
+      if(n.is_and())
+      {
+        // a before b
+        stack.push_back(n.b);
+        stack.push_back(n.a);
+      }
+      else
+      {
+        auto node_var = node_vars.find(l.var_no());
+        if(
+          node_var != node_vars.end() &&
+          placed.insert(node_var->second).second)
+        {
+          order.push_back(node_var->second);
+          if(!vars.at(node_var->second).is_input)
+            roots.push_back(netlist.var_map.get_next(node_var->second));
+        }
+      }
+    }
   }
+
+  // the variables that are not in the fan-in
+  for(const auto &[id, _] : vars)
+    if(placed.insert(id).second)
+      order.push_back(id);
+
+  return order;
+}
+
+/*******************************************************************\
+
+Function: bdd_enginet::reorder_needed
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+bool bdd_enginet::reorder_needed()
+{
+  return cmdline.isset("bdd-reorder") &&
+         number_of_live_nodes(mgr) > reorder_threshold;
+}
+
+/*******************************************************************\
+
+Function: bdd_enginet::reorder
+
+  Inputs: the BDDs of the caller, besides those of the engine
+
+ Outputs:
+
+ Purpose: sift the variables, keeping each current-state variable
+          together with its next-state variable, and rename the
+          variables of all BDDs accordingly
+
+\*******************************************************************/
+
+void bdd_enginet::reorder(const std::vector<BDD *> &extra)
+{
+  std::vector<BDD *> bdds = extra;
+
+  for(auto &[_, var] : vars)
+  {
+    bdds.push_back(&var.current_bdd);
+    bdds.push_back(&var.next_bdd);
+  }
+
+  for(auto &variable : transition_relation.variables)
+  {
+    bdds.push_back(&variable.current);
+    bdds.push_back(&variable.next);
+  }
+
+  for(auto *list :
+      {&transition_relation.transition_conjuncts,
+       &transition_relation.constraint_conjuncts,
+       &initial_BDDs})
+  {
+    for(auto &bdd : *list)
+      bdds.push_back(&bdd);
+  }
+
+  for(auto &[_, atomic_proposition] : atomic_propositions)
+    bdds.push_back(&atomic_proposition.bdd);
+
+  std::vector<BDD> roots;
+  roots.reserve(bdds.size());
+  for(auto *bdd : bdds)
+    roots.push_back(*bdd);
+
+  std::vector<std::vector<unsigned>> groups;
+  for(const auto &variable : transition_relation.variables)
+    groups.push_back({variable.current.var(), variable.next.var()});
+
+  const std::size_t nodes_before = number_of_live_nodes(mgr);
+
+  auto mapping = sift(roots, groups);
+
+  roots.clear();
+  permute(bdds, mapping);
+
+  message.statistics() << "Reordered BDD variables: " << nodes_before
+                       << " nodes before, " << number_of_live_nodes(mgr)
+                       << " nodes after" << messaget::eom;
+
+  reorder_threshold =
+    std::max(initial_reorder_threshold, 2 * number_of_live_nodes(mgr));
 }
 
 /*******************************************************************\
@@ -430,12 +639,19 @@ void bdd_enginet::check_property(propertyt &property)
   if(property.is_failure())
     return;
 
+  // settled by the run the checkpoint was written by
+  if(property.is_proved() || property.is_refuted())
+    return;
+
   message.status() << "Checking " << property.name << messaget::eom;
   property.status=propertyt::statust::UNKNOWN;
 
   if(is_AGp(property.normalized_expr))
   {
-    check_AGp(property);
+    if(cmdline.isset("bdd-forward"))
+      check_AGp_forward(property);
+    else
+      check_AGp(property);
   }
   else if(is_CTL(property.normalized_expr))
   {
@@ -459,10 +675,11 @@ Function: bdd_enginet::check_AGp
 
 void bdd_enginet::check_AGp(propertyt &property)
 {
-  bdd_model_checkert model_checker(transition_relation);
+  std::optional<bdd_model_checkert> model_checker;
+  model_checker.emplace(transition_relation);
 
   const exprt &sub_expr = to_unary_expr(property.normalized_expr).op();
-  BDD p = CTL(sub_expr, model_checker);
+  BDD p = CTL(sub_expr, *model_checker);
 
   // Start with !p, and go backwards until saturation or we hit an
   // initial state.
@@ -477,6 +694,8 @@ void bdd_enginet::check_AGp(propertyt &property)
 
   while(true)
   {
+    cancellation_point();
+
     iteration++;
     message.statistics() << "Iteration " << iteration << messaget::eom;
 
@@ -486,7 +705,7 @@ void bdd_enginet::check_AGp(propertyt &property)
     for(const auto &i : initial_BDDs)
       intersection = intersection & i;
 
-    peak_bdd_nodes = std::max(peak_bdd_nodes, mgr.number_of_nodes());
+    peak_bdd_nodes = std::max(peak_bdd_nodes, number_of_live_nodes(mgr));
 
     if(!intersection.is_false())
     {
@@ -504,8 +723,16 @@ void bdd_enginet::check_AGp(propertyt &property)
       break;
     }
 
+    if(reorder_needed())
+    {
+      // the clusters of the model checker are rebuilt
+      model_checker.reset();
+      reorder({&states});
+      model_checker.emplace(transition_relation);
+    }
+
     // EX(states) gives us the pre-image
-    BDD pre_image = model_checker.EX(states);
+    BDD pre_image = model_checker->EX(states);
 
     // compute union
     BDD set_union = states | pre_image;
@@ -528,12 +755,273 @@ void bdd_enginet::check_AGp(propertyt &property)
 
     states = set_union;
 
-    peak_bdd_nodes = std::max(peak_bdd_nodes, mgr.number_of_nodes());
+    peak_bdd_nodes = std::max(peak_bdd_nodes, number_of_live_nodes(mgr));
+  }
+}
+
+/*******************************************************************\
+
+Function: bdd_enginet::check_AGp_forward
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: forward reachability from the initial states, computing
+          the image of the frontier only
+
+\*******************************************************************/
+
+void bdd_enginet::check_AGp_forward(propertyt &property)
+{
+  std::optional<bdd_model_checkert> model_checker;
+  model_checker.emplace(transition_relation);
+
+  const exprt &sub_expr = to_unary_expr(property.normalized_expr).op();
+  BDD p = CTL(sub_expr, *model_checker);
+
+  BDD bad = !p;
+
+  for(const auto &c : transition_relation.constraint_conjuncts)
+    bad = bad & c;
+
+  BDD reached = mgr.True();
+
+  for(const auto &i : initial_BDDs)
+    reached = reached & i;
+
+  // The frontier is the set of states first reached in the previous
+  // iteration. Any BDD that agrees with it on the states not reached
+  // before will do.
+  BDD frontier = reached;
+  unsigned iteration = 0;
+
+  if(
+    checkpointer.has_value() &&
+    restore_forward_checkpoint(property, iteration, reached, frontier))
+  {
+    message.status() << "Resuming at iteration " << iteration + 1
+                     << messaget::eom;
+  }
+
+  while(true)
+  {
+    cancellation_point();
+
+    iteration++;
+    message.statistics() << "Iteration " << iteration << messaget::eom;
+
+    // do we have a bad state?
+    if(!(frontier & bad).is_false())
+    {
+      if(property.is_exists_path())
+      {
+        property.proved("BDD");
+        message.status() << "Path-exists property proved" << messaget::eom;
+      }
+      else
+      {
+        property.refuted("BDD");
+        message.status() << "Property refuted" << messaget::eom;
+      }
+      compute_counterexample(property, iteration);
+      break;
+    }
+
+    if(reorder_needed())
+    {
+      // the clusters of the model checker are rebuilt
+      model_checker.reset();
+      reorder({&bad, &reached, &frontier});
+      model_checker.emplace(transition_relation);
+    }
+
+    BDD new_states = model_checker->image(frontier) & !reached;
+
+    // have we saturated?
+    if(new_states.is_false())
+    {
+      if(property.is_exists_path())
+      {
+        property.refuted("BDD");
+        message.status() << "Path-exists property refuted" << messaget::eom;
+      }
+      else
+      {
+        property.proved("BDD");
+        message.status() << "Property proved" << messaget::eom;
+      }
+      break;
+    }
+
+    // The states reached before are don't-cares for the frontier.
+    BDD simplified = simplify(new_states, !reached);
+
+    frontier =
+      bdd_size(simplified) < bdd_size(new_states) ? simplified : new_states;
+
+    reached = reached | new_states;
+
+    message.statistics() << "Frontier: " << bdd_size(frontier)
+                         << " nodes, reached: " << bdd_size(reached)
+                         << " nodes" << messaget::eom;
+
+    if(checkpointer.has_value() && checkpointer->is_due())
+    {
+      checkpointer->save(
+        properties,
+        forward_checkpoint_state(property, iteration, reached, frontier));
+    }
   }
 }
 
 /*******************************************************************\
 
+Function: bdd_enginet::forward_checkpoint_state
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: The reached states and the frontier are written as a
+          shared list of nodes, each after its children, with the
+          variables given by their names. Reference 0 is false,
+          1 is true, and n+2 is the n-th node.
+
+\*******************************************************************/
+
+std::vector<std::string> bdd_enginet::forward_checkpoint_state(
+  const propertyt &property,
+  unsigned iteration,
+  const BDD &reached,
+  const BDD &frontier) const
+{
+  std::map<unsigned, std::string> labels;
+
+  for(const auto &[id, var] : vars)
+  {
+    labels[var.current_bdd.var()] = id.as_string();
+    labels[var.next_bdd.var()] = id.as_string() + "'";
+  }
+
+  std::vector<std::string> nodes;
+  std::map<unsigned, std::size_t> refs;
+
+  auto ref = [&](const BDD &f, auto &self) -> std::size_t
+  {
+    if(f.is_false())
+      return 0;
+    else if(f.is_true())
+      return 1;
+
+    auto r_it = refs.find(f.node_number());
+    if(r_it != refs.end())
+      return r_it->second;
+
+    auto low = self(f.low(), self);
+    auto high = self(f.high(), self);
+
+    nodes.push_back(
+      "node " + std::to_string(low) + ' ' + std::to_string(high) + ' ' +
+      labels.at(f.var()));
+
+    auto r = nodes.size() + 1;
+    refs.emplace(f.node_number(), r);
+    return r;
+  };
+
+  auto reached_ref = ref(reached, ref);
+  auto frontier_ref = ref(frontier, ref);
+
+  std::vector<std::string> state;
+  state.push_back("property " + id2string(property.identifier));
+  state.push_back("iteration " + std::to_string(iteration));
+  state.insert(state.end(), nodes.begin(), nodes.end());
+  state.push_back("reached " + std::to_string(reached_ref));
+  state.push_back("frontier " + std::to_string(frontier_ref));
+
+  return state;
+}
+
+/*******************************************************************\
+
+Function: bdd_enginet::restore_forward_checkpoint
+
+  Inputs:
+
+ Outputs: true if the checkpoint is for the given property
+
+ Purpose: rebuilds the BDDs written by forward_checkpoint_state
+
+\*******************************************************************/
+
+bool bdd_enginet::restore_forward_checkpoint(
+  const propertyt &property,
+  unsigned &iteration,
+  BDD &reached,
+  BDD &frontier)
+{
+  const auto &state = checkpointer->resumed_state();
+
+  if(
+    state.empty() ||
+    state.front() != "property " + id2string(property.identifier))
+  {
+    return false;
+  }
+
+  std::map<std::string, BDD> variables;
+
+  for(const auto &[id, var] : vars)
+  {
+    variables.emplace(id.as_string(), var.current_bdd);
+    variables.emplace(id.as_string() + "'", var.next_bdd);
+  }
+
+  std::vector<BDD> refs = {mgr.False(), mgr.True()};
+
+  auto get_ref = [&refs](std::size_t r) -> const BDD &
+  {
+    if(r >= refs.size())
+      throw ebmc_errort() << "malformed BDD checkpoint";
+    return refs[r];
+  };
+
+  for(const auto &line : state)
+  {
+    std::istringstream in(line);
+    std::string keyword;
+    in >> keyword;
+
+    std::size_t r;
+
+    if(keyword == "iteration")
+      in >> iteration;
+    else if(keyword == "reached" && in >> r)
+      reached = get_ref(r);
+    else if(keyword == "frontier" && in >> r)
+      frontier = get_ref(r);
+    else if(keyword == "node")
+    {
+      std::size_t low, high;
+      std::string label;
+      in >> low >> high >> std::ws;
+      std::getline(in, label);
+
+      auto v_it = variables.find(label);
+      if(v_it == variables.end())
+        throw ebmc_errort() << "unknown BDD variable in checkpoint: " << label;
+
+      const BDD &x = v_it->second;
+      refs.push_back((x & get_ref(high)) | (!x & get_ref(low)));
+    }
+  }
+
+  return true;
+}
+
+/*******************************************************************\
+
 Function: bdd_enginet::check_CTL
 
   Inputs:
@@ -0,0 +1,592 @@
+/*******************************************************************\
+
+Module: Reachable-State Invariants from BDDs
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+#include "bdd_invariants.h"
+
+#include <util/bitvector_expr.h>
+#include <util/cmdline.h>
+#include <util/invariant.h>
+#include <util/string2int.h>
+
+#include <trans-netlist/aig_prop.h>
+#include <trans-netlist/ldg.h>
+
+#include "bdd_model_checker.h"
+#include "ebmc_error.h"
+
+#include <algorithm>
+#include <optional>
+#include <tuple>
+#include <unordered_map>
+
+/*******************************************************************\
+
+   Class: bdd_invariantst
+
+ Purpose: Forward reachability over the selected latches, with all
+          other latches and the inputs abstracted as free inputs
+
+\*******************************************************************/
+
+class bdd_invariantst
+{
+public:
+  bdd_invariantst(const netlistt &_netlist, message_handlert &message_handler)
+    : netlist(_netlist), message(message_handler)
+  {
+  }
+
+  /// the states reachable over the selected latches, if the fixed
+  /// point is reached and the states are not all states
+  std::optional<ebmc_bddt> reachable(std::size_t max_latches);
+
+  /// the BDD over the selected latches, added to the given netlist
+  literalt bdd2aig(netlistt &, const ebmc_bddt &);
+
+  /// the BDD over the selected latches, as a predicate over the
+  /// variables of the netlist
+  std::optional<exprt> bdd2expr(const ebmc_bddt &) const;
+
+  // an AND node whose BDD is larger is replaced by a free input
+  static constexpr std::size_t cut_threshold = 2000;
+
+  // the reachability gives up once the manager holds more nodes
+  static constexpr std::size_t node_limit = 1000000;
+
+protected:
+  const netlistt &netlist;
+  messaget message;
+
+  // declared first, as all BDDs must be destroyed before it
+  ebmc_bdd_mgrt mgr;
+
+  bdd_transition_relationt transition_relation;
+  bdd_varsett inputs;
+
+  // the BDDs of the AIG nodes
+  std::unordered_map<literalt::var_not, ebmc_bddt> BDDs;
+
+  // the current-state literal of each state variable of the BDDs
+  std::unordered_map<unsigned, literalt> state_literals;
+
+  std::size_t number_of_cuts = 0;
+
+  struct latcht
+  {
+    literalt current, next;
+  };
+
+  std::vector<latcht> select_latches(std::size_t max_latches) const;
+  ebmc_bddt free_input();
+  ebmc_bddt aig2bdd(literalt);
+};
+
+/*******************************************************************\
+
+Function: bdd_invariantst::select_latches
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: pick the control latches: the bits of narrow variables
+          first, and among those the ones with the most latches in
+          their fan-out according to the latch dependency graph
+
+\*******************************************************************/
+
+std::vector<bdd_invariantst::latcht>
+bdd_invariantst::select_latches(std::size_t max_latches) const
+{
+  ldgt ldg;
+  ldg.compute(netlist);
+
+  // width, fan-out, latch
+  std::vector<std::tuple<std::size_t, std::size_t, latcht>> candidates;
+
+  for(auto var_it : netlist.var_map.sorted())
+  {
+    const var_mapt::vart &var = var_it->second;
+
+    if(!var.is_latch())
+      continue;
+
+    for(const auto &bit : var.bits)
+    {
+      if(bit.current.is_constant())
+        continue;
+
+      const auto fanout = ldg[bit.current.var_no()].out.size();
+      candidates.emplace_back(
+        var.bits.size(), fanout, latcht{bit.current, bit.next});
+    }
+  }
+
+  // stable, to keep the order of the variable map among equals
+  std::stable_sort(
+    candidates.begin(),
+    candidates.end(),
+    [](const auto &a, const auto &b)
+    {
+      if(std::get<0>(a) != std::get<0>(b))
+        return std::get<0>(a) < std::get<0>(b);
+      return std::get<1>(a) > std::get<1>(b);
+    });
+
+  if(candidates.size() > max_latches)
+    candidates.resize(max_latches);
+
+  std::vector<latcht> result;
+
+  for(const auto &candidate : candidates)
+    result.push_back(std::get<2>(candidate));
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: bdd_invariantst::free_input
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: a new input variable of the transition relation
+
+\*******************************************************************/
+
+ebmc_bddt bdd_invariantst::free_input()
+{
+  const auto number = std::to_string(transition_relation.variables.size());
+  auto current = mgr.Var("i" + number);
+  auto next = mgr.Var("i" + number + "'");
+  inputs.insert(current.var());
+  transition_relation.variables.push_back({current, next, true});
+  return current;
+}
+
+/*******************************************************************\
+
+Function: bdd_invariantst::aig2bdd
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the BDD of the literal over the selected latches; the other
+          variable nodes become free inputs, and so do the AND nodes
+          whose BDD exceeds the cut threshold
+
+\*******************************************************************/
+
+ebmc_bddt bdd_invariantst::aig2bdd(literalt l)
+{
+  if(l.is_true())
+    return mgr.True();
+  if(l.is_false())
+    return mgr.False();
+
+  std::vector<literalt::var_not> stack{l.var_no()};
+
+  while(!stack.empty())
+  {
+    const auto v = stack.back();
+
+    if(BDDs.find(v) != BDDs.end())
+    {
+      stack.pop_back();
+      continue;
+    }
+
+    const auto &node = netlist.nodes[v];
+
+    if(!node.is_and())
+    {
+      BDDs.emplace(v, free_input());
+      stack.pop_back();
+      continue;
+    }
+
+    // the children first
+    bool ready = true;
+
+    for(auto child : {node.a, node.b})
+      if(!child.is_constant() && BDDs.find(child.var_no()) == BDDs.end())
+      {
+        stack.push_back(child.var_no());
+        ready = false;
+      }
+
+    if(!ready)
+      continue;
+
+    auto operand = [this](literalt child)
+    {
+      if(child.is_constant())
+        return child.is_true() ? mgr.True() : mgr.False();
+      auto result = BDDs.at(child.var_no());
+      return child.sign() ? !result : result;
+    };
+
+    ebmc_bddt result = operand(node.a) & operand(node.b);
+
+    // an over-approximation, as the input may take any value
+    if(bdd_size(result) > cut_threshold)
+    {
+      result = free_input();
+      number_of_cuts++;
+    }
+
+    BDDs.emplace(v, result);
+    stack.pop_back();
+  }
+
+  auto result = BDDs.at(l.var_no());
+  return l.sign() ? !result : result;
+}
+
+/*******************************************************************\
+
+Function: bdd_invariantst::bdd2aig
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: add the BDD over the state variables to the netlist, with a
+          multiplexer for each node
+
+\*******************************************************************/
+
+literalt bdd_invariantst::bdd2aig(netlistt &dest, const ebmc_bddt &root)
+{
+  aig_prop_baset prop(dest, message.get_message_handler());
+
+  std::unordered_map<unsigned, literalt> literals;
+
+  auto literal_of = [&literals](const ebmc_bddt &f) -> std::optional<literalt>
+  {
+    if(f.is_constant())
+      return const_literal(f.is_true());
+    auto entry = literals.find(f.node_number());
+    if(entry == literals.end())
+      return {};
+    return entry->second;
+  };
+
+  std::vector<ebmc_bddt> stack{root};
+
+  while(!stack.empty())
+  {
+    const ebmc_bddt f = stack.back();
+
+    if(literal_of(f).has_value())
+    {
+      stack.pop_back();
+      continue;
+    }
+
+    auto low = literal_of(f.low()), high = literal_of(f.high());
+
+    if(!low.has_value())
+      stack.push_back(f.low());
+    else if(!high.has_value())
+      stack.push_back(f.high());
+    else
+    {
+      literalt condition = state_literals.at(f.var());
+      literals.emplace(f.node_number(), prop.lselect(condition, *high, *low));
+      stack.pop_back();
+    }
+  }
+
+  return *literal_of(root);
+}
+
+/*******************************************************************\
+
+Function: bdd_invariantst::reachable
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::optional<ebmc_bddt>
+bdd_invariantst::reachable(std::size_t max_latches)
+{
+  const auto latches = select_latches(max_latches);
+
+  if(latches.empty())
+    return {};
+
+  message.statistics() << "BDD invariants: " << latches.size()
+                       << " of " << netlist.var_map.latches.size()
+                       << " latches" << messaget::eom;
+
+  // the selected latches go first, with the next-state variable
+  // right after the current-state variable
+  for(const auto &latch : latches)
+  {
+    const auto label = std::to_string(latch.current.var_no());
+    auto current = mgr.Var("l" + label);
+    auto next = mgr.Var("l" + label + "'");
+    transition_relation.variables.push_back({current, next, false});
+    state_literals.emplace(current.var(), latch.current);
+    BDDs.emplace(
+      latch.current.var_no(), latch.current.sign() ? !current : current);
+  }
+
+  for(std::size_t i = 0; i < latches.size(); i++)
+  {
+    transition_relation.transition_conjuncts.push_back(
+      aig2bdd(latches[i].next) == transition_relation.variables[i].next);
+  }
+
+  for(literalt l : netlist.transition)
+    transition_relation.transition_conjuncts.push_back(aig2bdd(l));
+
+  ebmc_bddt constraints = mgr.True();
+
+  for(literalt l : netlist.constraints)
+  {
+    transition_relation.constraint_conjuncts.push_back(aig2bdd(l));
+    constraints = constraints & transition_relation.constraint_conjuncts.back();
+  }
+
+  ebmc_bddt initial = constraints;
+
+  for(literalt l : netlist.initial)
+    initial = initial & aig2bdd(l);
+
+  if(number_of_cuts != 0)
+  {
+    message.statistics() << "BDD invariants: " << number_of_cuts
+                         << " cut points" << messaget::eom;
+  }
+
+  bdd_model_checkert model_checker(transition_relation);
+
+  ebmc_bddt reached = inputs.empty() ? initial : exists(initial, inputs);
+  ebmc_bddt frontier = reached;
+  std::size_t iteration = 0;
+
+  while(!frontier.is_false())
+  {
+    iteration++;
+
+    ebmc_bddt new_states = model_checker.image(frontier) & !reached;
+    frontier = simplify(new_states, !reached);
+    reached = reached | new_states;
+
+    if(number_of_live_nodes(mgr) > node_limit)
+    {
+      message.statistics() << "BDD invariants: giving up after "
+                           << iteration << " iterations" << messaget::eom;
+      return {};
+    }
+  }
+
+  message.statistics() << "BDD invariants: fixed point after " << iteration
+                       << " iterations, " << bdd_size(reached) << " nodes"
+                       << messaget::eom;
+
+  // nothing learned
+  if(reached.is_true())
+    return {};
+
+  return reached;
+}
+
+/*******************************************************************\
+
+Function: bdd_invariantst::bdd2expr
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the BDD over the state variables as an expression over the
+          bits of the variables of the netlist, with a case split for
+          each node
+
+\*******************************************************************/
+
+std::optional<exprt> bdd_invariantst::bdd2expr(const ebmc_bddt &root) const
+{
+  // the bit of the variable of the netlist for the state literal
+  auto bit_expr = [this](literalt l) -> std::optional<exprt>
+  {
+    const auto &varid = netlist.var_map.reverse(l.var_no());
+    const auto &var = netlist.var_map.map.at(varid.id);
+
+    exprt result;
+
+    if(var.type.id() == ID_bool)
+      result = symbol_exprt{varid.id, var.type};
+    else if(
+      var.type.id() == ID_unsignedbv || var.type.id() == ID_signedbv ||
+      var.type.id() == ID_bv)
+    {
+      result = extractbit_exprt{symbol_exprt{varid.id, var.type}, varid.bit_nr};
+    }
+    else
+      return {};
+
+    if(l.sign())
+      return not_exprt{result};
+    else
+      return result;
+  };
+
+  std::unordered_map<unsigned, exprt> exprs;
+
+  auto expr_of = [&exprs](const ebmc_bddt &f) -> std::optional<exprt>
+  {
+    if(f.is_constant())
+      return f.is_true() ? exprt{true_exprt{}} : exprt{false_exprt{}};
+    auto entry = exprs.find(f.node_number());
+    if(entry == exprs.end())
+      return {};
+    return entry->second;
+  };
+
+  std::vector<ebmc_bddt> stack{root};
+
+  while(!stack.empty())
+  {
+    const ebmc_bddt f = stack.back();
+
+    if(expr_of(f).has_value())
+    {
+      stack.pop_back();
+      continue;
+    }
+
+    auto low = expr_of(f.low()), high = expr_of(f.high());
+
+    if(!low.has_value())
+      stack.push_back(f.low());
+    else if(!high.has_value())
+      stack.push_back(f.high());
+    else
+    {
+      auto condition = bit_expr(state_literals.at(f.var()));
+
+      if(!condition.has_value())
+        return {};
+
+      exprt result;
+
+      if(high->is_true() && low->is_false())
+        result = *condition;
+      else if(high->is_false() && low->is_true())
+        result = not_exprt{*condition};
+      else if(low->is_false())
+        result = and_exprt{*condition, *high};
+      else if(high->is_false())
+        result = and_exprt{not_exprt{*condition}, *low};
+      else
+        result = if_exprt{*condition, *high, *low};
+
+      exprs.emplace(f.node_number(), std::move(result));
+      stack.pop_back();
+    }
+  }
+
+  return *expr_of(root);
+}
+
+/*******************************************************************\
+
+Function: add_bdd_invariants
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+bool add_bdd_invariants(
+  netlistt &netlist,
+  std::size_t max_latches,
+  message_handlert &message_handler)
+{
+  bdd_invariantst bdd_invariants{netlist, message_handler};
+
+  auto reached = bdd_invariants.reachable(max_latches);
+
+  if(!reached.has_value())
+    return false;
+
+  netlist.constraints.push_back(bdd_invariants.bdd2aig(netlist, *reached));
+
+  return true;
+}
+
+/*******************************************************************\
+
+Function: bdd_invariant_predicate
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::optional<exprt> bdd_invariant_predicate(
+  const netlistt &netlist,
+  std::size_t max_latches,
+  message_handlert &message_handler)
+{
+  bdd_invariantst bdd_invariants{netlist, message_handler};
+
+  auto reached = bdd_invariants.reachable(max_latches);
+
+  if(!reached.has_value())
+    return {};
+
+  return bdd_invariants.bdd2expr(*reached);
+}
+
+/*******************************************************************\
+
+Function: bdd_invariant_latches
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::optional<std::size_t> bdd_invariant_latches(const cmdlinet &cmdline)
+{
+  if(!cmdline.isset("bdd-invariants"))
+    return {};
+
+  if(!cmdline.isset("bdd-invariant-latches"))
+    return 100;
+
+  auto value_opt =
+    string2optional_size_t(cmdline.get_value("bdd-invariant-latches"));
+
+  if(!value_opt.has_value())
+    throw ebmc_errort() << "failed to parse --bdd-invariant-latches";
+
+  return value_opt;
+}
@@ -0,0 +1,52 @@
+/*******************************************************************\
+
+Module: Reachable-State Invariants from BDDs
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// An over-approximation of the reachable states, computed with BDDs
+/// over a small set of control latches, as a constraint for the
+/// SAT-based engines that work on the netlist
+
+#ifndef CPROVER_EBMC_BDD_INVARIANTS_H
+#define CPROVER_EBMC_BDD_INVARIANTS_H
+
+#include <util/expr.h>
+#include <util/message.h>
+
+#include <cstddef>
+#include <optional>
+
+class cmdlinet;
+class netlistt;
+
+/// The maximum number of latches given with --bdd-invariants and
+/// --bdd-invariant-latches; nothing without --bdd-invariants
+std::optional<std::size_t> bdd_invariant_latches(const cmdlinet &);
+
+/// Selects up to max_latches control latches using the latch
+/// dependency graph, preferring narrow variables and latches that many
+/// other latches depend on. All other latches and the inputs are
+/// treated as free inputs, and the states reachable over the selected
+/// latches are computed by forward reachability with BDDs. Once the
+/// fixed point is reached within the budget, it is added to the
+/// constraints of the netlist. Returns true if a constraint was added.
+bool add_bdd_invariants(
+  netlistt &,
+  std::size_t max_latches,
+  message_handlert &);
+
+/// The states reachable over the selected latches, computed as with
+/// add_bdd_invariants, as a predicate over the state variables of the
+/// transition system of the netlist, for the word-level engines.
+/// Returns nothing when nothing is learned, or when a selected latch
+/// is not a bit of a Boolean or bit-vector variable.
+std::optional<exprt> bdd_invariant_predicate(
+  const netlistt &,
+  std::size_t max_latches,
+  message_handlert &);
+
+#endif // CPROVER_EBMC_BDD_INVARIANTS_H
@@ -8,50 +8,156 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "bdd_model_checker.h"
 
-bdd_model_checkert::bdd_model_checkert(
-  const bdd_transition_relationt &_transition_relation)
-  : transition_relation(_transition_relation)
-{
-}
+#include "engine_budget.h"
 
-mini_bddt bdd_model_checkert::current_to_next(const mini_bddt &bdd) const
+#include <algorithm>
+#include <unordered_set>
+
+bdd_model_checkert::bdd_model_checkert(
+  const bdd_transition_relationt &_transition_relation,
+  std::size_t _cluster_threshold)
+  : transition_relation(_transition_relation),
+    cluster_threshold(_cluster_threshold)
 {
-  mini_bddt tmp = bdd;
+  // The pre-image quantifies the next-state variables and the
+  // current-state inputs.
+  std::unordered_set<unsigned> quantified;
 
   for(const auto &v : transition_relation.variables)
-    tmp = substitute(tmp, v.current.var(), v.next);
+  {
+    next_map[v.current.var()] = v.next.var();
+    current_map[v.next.var()] = v.current.var();
 
-  return tmp;
+    quantified.insert(v.next.var());
+    if(v.is_input)
+    {
+      quantified.insert(v.current.var());
+      inputs.insert(v.current.var());
+    }
+  }
+
+  pre_image_schedule = partition(quantified);
 }
 
-mini_bddt bdd_model_checkert::project_next(const mini_bddt &bdd) const
+bdd_model_checkert::schedulet bdd_model_checkert::partition(
+  const std::unordered_set<unsigned> &quantified) const
 {
-  mini_bddt tmp = bdd;
+  schedulet schedule;
+  auto &clusters = schedule.clusters;
 
-  for(const auto &v : transition_relation.variables)
-    tmp = exists(tmp, v.next.var());
+  struct conjunctt
+  {
+    ebmc_bddt bdd;
+    std::vector<unsigned> support;
+  };
 
-  return tmp;
-}
+  std::vector<conjunctt> conjuncts;
 
-mini_bddt bdd_model_checkert::project_inputs(const mini_bddt &bdd) const
-{
-  mini_bddt tmp = bdd;
+  for(auto *list :
+      {&transition_relation.transition_conjuncts,
+       &transition_relation.constraint_conjuncts})
+  {
+    for(const auto &c : *list)
+      if(!c.is_true())
+        conjuncts.push_back({c, support(c)});
+  }
 
-  for(const auto &v : transition_relation.variables)
-    if(v.is_input)
-      tmp = exists(tmp, v.current.var());
+  // the number of remaining conjuncts that depend on each variable
+  std::vector<std::size_t> occurrences;
+
+  for(const auto &c : conjuncts)
+    for(auto v : c.support)
+    {
+      if(v >= occurrences.size())
+        occurrences.resize(v + 1, 0);
+      occurrences[v]++;
+    }
 
-  return tmp;
+  auto occurs = [&occurrences](unsigned v)
+  { return v < occurrences.size() && occurrences[v] != 0; };
+
+  for(auto v : quantified)
+    if(!occurs(v))
+      schedule.quantify_first.insert(v);
+
+  // Order the conjuncts greedily: next is the conjunct after which the
+  // most variables can be quantified, and among those, the one with
+  // the smallest support.
+  std::vector<conjunctt> ordered;
+  ordered.reserve(conjuncts.size());
+
+  while(!conjuncts.empty())
+  {
+    std::size_t best = 0, best_dead = 0;
+
+    for(std::size_t i = 0; i < conjuncts.size(); i++)
+    {
+      std::size_t dead = 0;
+      for(auto v : conjuncts[i].support)
+        if(occurrences[v] == 1 && quantified.count(v) != 0)
+          dead++;
+
+      if(
+        i == 0 || dead > best_dead ||
+        (dead == best_dead &&
+         conjuncts[i].support.size() < conjuncts[best].support.size()))
+      {
+        best = i;
+        best_dead = dead;
+      }
+    }
+
+    for(auto v : conjuncts[best].support)
+      occurrences[v]--;
+
+    ordered.push_back(std::move(conjuncts[best]));
+    conjuncts.erase(conjuncts.begin() + best);
+  }
+
+  // Merge consecutive conjuncts into clusters up to the threshold.
+  for(const auto &c : ordered)
+  {
+    if(!clusters.empty())
+    {
+      auto merged = clusters.back().relation & c.bdd;
+      if(bdd_size(merged) <= cluster_threshold)
+      {
+        clusters.back().relation = merged;
+        continue;
+      }
+    }
+
+    clusters.push_back({c.bdd, bdd_varsett{}});
+  }
+
+  // Each variable is quantified after the last cluster that
+  // depends on it.
+  std::unordered_set<unsigned> seen;
+
+  for(auto it = clusters.rbegin(); it != clusters.rend(); it++)
+  {
+    for(auto v : support(it->relation))
+      if(quantified.count(v) != 0 && seen.insert(v).second)
+        it->quantify.insert(v);
+  }
+
+  return schedule;
+}
+
+ebmc_bddt bdd_model_checkert::current_to_next(const ebmc_bddt &bdd) const
+{
+  return permute(bdd, next_map);
 }
 
-mini_bddt bdd_model_checkert::fixedpoint(
-  std::function<mini_bddt(mini_bddt)> tau,
-  mini_bddt x)
+ebmc_bddt bdd_model_checkert::fixedpoint(
+  std::function<ebmc_bddt(ebmc_bddt)> tau,
+  ebmc_bddt x)
 {
   while(true)
   {
-    mini_bddt image = tau(x);
+    cancellation_point();
+
+    ebmc_bddt image = tau(x);
 
     if((image == x).is_true())
       return x;
@@ -60,42 +166,65 @@ mini_bddt bdd_model_checkert::fixedpoint(
   }
 }
 
-mini_bddt bdd_model_checkert::EX(mini_bddt f)
+ebmc_bddt bdd_model_checkert::EX(ebmc_bddt f)
 {
   for(const auto &c : transition_relation.constraint_conjuncts)
     f = f & c;
 
-  mini_bddt p_next = current_to_next(f);
+  ebmc_bddt result =
+    exists(current_to_next(f), pre_image_schedule.quantify_first);
 
-  mini_bddt conjunction = p_next;
+  for(const auto &cluster : pre_image_schedule.clusters)
+    result = and_exists(result, cluster.relation, cluster.quantify);
 
-  for(const auto &t : transition_relation.transition_conjuncts)
-    conjunction = conjunction & t;
+  return result;
+}
 
-  for(const auto &c : transition_relation.constraint_conjuncts)
-    conjunction = conjunction & c;
+ebmc_bddt bdd_model_checkert::image(ebmc_bddt f)
+{
+  if(!image_schedule.has_value())
+  {
+    // The image quantifies all current-state variables.
+    std::unordered_set<unsigned> quantified;
+
+    for(const auto &v : transition_relation.variables)
+      quantified.insert(v.current.var());
+
+    image_schedule = partition(quantified);
+
+    constraints = manager(f).True();
+    for(const auto &c : transition_relation.constraint_conjuncts)
+      constraints = constraints & c;
+  }
+
+  // the constraints are among the clusters
+  ebmc_bddt result = exists(f, image_schedule->quantify_first);
+
+  for(const auto &cluster : image_schedule->clusters)
+    result = and_exists(result, cluster.relation, cluster.quantify);
 
-  return project_inputs(project_next(conjunction));
+  // The successors must satisfy the constraints for some input.
+  return and_exists(permute(result, current_map), constraints, inputs);
 }
 
-mini_bddt bdd_model_checkert::EF(mini_bddt f)
+ebmc_bddt bdd_model_checkert::EF(ebmc_bddt f)
 {
-  return fixedpoint([this](mini_bddt x) { return x | EX(x); }, f);
+  return fixedpoint([this](ebmc_bddt x) { return x | EX(x); }, f);
 }
 
-mini_bddt bdd_model_checkert::EG(mini_bddt f)
+ebmc_bddt bdd_model_checkert::EG(ebmc_bddt f)
 {
-  return fixedpoint([this](mini_bddt x) { return x & EX(x); }, f);
+  return fixedpoint([this](ebmc_bddt x) { return x & EX(x); }, f);
 }
 
-mini_bddt bdd_model_checkert::EU(mini_bddt f1, mini_bddt f2)
+ebmc_bddt bdd_model_checkert::EU(ebmc_bddt f1, ebmc_bddt f2)
 {
   return fixedpoint(
-    [this, f1, f2](mini_bddt x) { return x | f2 | (f1 & EX(x)); }, f2);
+    [this, f1, f2](ebmc_bddt x) { return x | f2 | (f1 & EX(x)); }, f2);
 }
 
-mini_bddt bdd_model_checkert::AU(mini_bddt f1, mini_bddt f2)
+ebmc_bddt bdd_model_checkert::AU(ebmc_bddt f1, ebmc_bddt f2)
 {
   return fixedpoint(
-    [this, f1, f2](mini_bddt x) { return x | f2 | (f1 & AX(x)); }, f2);
+    [this, f1, f2](ebmc_bddt x) { return x | f2 | (f1 & AX(x)); }, f2);
 }
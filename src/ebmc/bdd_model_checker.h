@@ -9,9 +9,12 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_EBMC_BDD_MODEL_CHECKER_H
 #define CPROVER_EBMC_BDD_MODEL_CHECKER_H
 
-#include <solvers/bdd/miniBDD/miniBDD.h>
+#include "bdd_operations.h"
 
 #include <functional>
+#include <map>
+#include <optional>
+#include <unordered_set>
 #include <vector>
 
 /// Represents a transition relation for BDD-based model checking.
@@ -21,46 +24,93 @@ struct bdd_transition_relationt
 {
   struct variable_pairt
   {
-    mini_bddt current;
-    mini_bddt next;
+    ebmc_bddt current;
+    ebmc_bddt next;
     bool is_input = false;
   };
 
   std::vector<variable_pairt> variables;
-  std::vector<mini_bddt> transition_conjuncts;
-  std::vector<mini_bddt> constraint_conjuncts;
+  std::vector<ebmc_bddt> transition_conjuncts;
+  std::vector<ebmc_bddt> constraint_conjuncts;
 };
 
 /// BDD-based CTL model checking.
 /// Provides functions for each CTL operator, computing the set of
 /// states (as a BDD) that satisfies the given formula.
+/// The conjuncts of the transition relation are partitioned into
+/// clusters of bounded size, and the pre-image quantifies each
+/// next-state and input variable as soon as no remaining cluster
+/// depends on it. The image for forward reachability is computed the
+/// same way, quantifying the current-state variables.
 class bdd_model_checkert
 {
 public:
-  explicit bdd_model_checkert(const bdd_transition_relationt &);
+  /// the default bound on the size of a cluster, in BDD nodes
+  static constexpr std::size_t default_cluster_threshold = 5000;
+
+  explicit bdd_model_checkert(
+    const bdd_transition_relationt &,
+    std::size_t cluster_threshold = default_cluster_threshold);
 
   // CTL operators
-  mini_bddt EX(mini_bddt);
-  mini_bddt EF(mini_bddt);
-  mini_bddt EG(mini_bddt);
-  mini_bddt EU(mini_bddt, mini_bddt);
-  mini_bddt AU(mini_bddt, mini_bddt);
+  ebmc_bddt EX(ebmc_bddt);
+  ebmc_bddt EF(ebmc_bddt);
+  ebmc_bddt EG(ebmc_bddt);
+  ebmc_bddt EU(ebmc_bddt, ebmc_bddt);
+  ebmc_bddt AU(ebmc_bddt, ebmc_bddt);
 
   // clang-format off
-  mini_bddt AX(mini_bddt f) { return !EX(!f); }
-  mini_bddt AF(mini_bddt f) { return !EG(!f); }
-  mini_bddt AG(mini_bddt f) { return !EF(!f); }
-  mini_bddt ER(mini_bddt f1, mini_bddt f2) { return !AU(!f1, !f2); }
-  mini_bddt AR(mini_bddt f1, mini_bddt f2) { return !EU(!f1, !f2); }
+  ebmc_bddt AX(ebmc_bddt f) { return !EX(!f); }
+  ebmc_bddt AF(ebmc_bddt f) { return !EG(!f); }
+  ebmc_bddt AG(ebmc_bddt f) { return !EF(!f); }
+  ebmc_bddt ER(ebmc_bddt f1, ebmc_bddt f2) { return !AU(!f1, !f2); }
+  ebmc_bddt AR(ebmc_bddt f1, ebmc_bddt f2) { return !EU(!f1, !f2); }
   // clang-format on
 
+  /// The successors of the given states. The states and the result
+  /// do not constrain the inputs.
+  ebmc_bddt image(ebmc_bddt);
+
+  std::size_t number_of_clusters() const
+  {
+    return pre_image_schedule.clusters.size();
+  }
+
 protected:
   const bdd_transition_relationt &transition_relation;
 
-  mini_bddt current_to_next(const mini_bddt &) const;
-  mini_bddt project_inputs(const mini_bddt &) const;
-  mini_bddt project_next(const mini_bddt &) const;
-  mini_bddt fixedpoint(std::function<mini_bddt(mini_bddt)>, mini_bddt);
+  struct clustert
+  {
+    ebmc_bddt relation;
+    // the variables no later cluster depends on
+    bdd_varsett quantify;
+  };
+
+  struct schedulet
+  {
+    std::vector<clustert> clusters;
+    // the variables to be quantified that no cluster depends on
+    bdd_varsett quantify_first;
+  };
+
+  const std::size_t cluster_threshold;
+  schedulet pre_image_schedule;
+
+  // built on the first use of image()
+  std::optional<schedulet> image_schedule;
+
+  // the conjunction of the constraints
+  ebmc_bddt constraints;
+  bdd_varsett inputs;
+
+  // current-state variable to next-state variable, and back
+  std::map<unsigned, unsigned> next_map;
+  std::map<unsigned, unsigned> current_map;
+
+  schedulet partition(const std::unordered_set<unsigned> &quantified) const;
+
+  ebmc_bddt current_to_next(const ebmc_bddt &) const;
+  ebmc_bddt fixedpoint(std::function<ebmc_bddt(ebmc_bddt)>, ebmc_bddt);
 };
 
 #endif // CPROVER_EBMC_BDD_MODEL_CHECKER_H
@@ -0,0 +1,341 @@
+/*******************************************************************\
+
+Module: Quantification and Renaming for BDDs
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+#include "bdd_operations.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+
+bdd_varsett::bdd_varsett(const std::vector<unsigned> &vars)
+{
+  for(auto var : vars)
+    insert(var);
+}
+
+void bdd_varsett::insert(unsigned var)
+{
+  if(contains(var))
+    return;
+
+  if(var >= members.size())
+    members.resize(var + 1, false);
+
+  members[var] = true;
+  size++;
+
+  if(var > max_var)
+    max_var = var;
+}
+
+/*******************************************************************\
+
+   Class: bdd_existst
+
+ Purpose: exists vars. f, and exists vars. (f & g), with a computed
+          table for the given variables
+
+\*******************************************************************/
+
+class bdd_existst
+{
+public:
+  explicit bdd_existst(const bdd_varsett &_vars) : vars(_vars)
+  {
+  }
+
+  ebmc_bddt exists(const ebmc_bddt &);
+  ebmc_bddt and_exists(const ebmc_bddt &, const ebmc_bddt &);
+
+protected:
+  const bdd_varsett &vars;
+
+  std::unordered_map<unsigned, ebmc_bddt> exists_table;
+  std::unordered_map<std::uint64_t, ebmc_bddt> and_exists_table;
+
+  // nothing to quantify below variable v
+  bool below(unsigned v) const
+  {
+    return vars.empty() || v > vars.max();
+  }
+};
+
+ebmc_bddt bdd_existst::exists(const ebmc_bddt &f)
+{
+  if(f.is_constant() || below(f.var()))
+    return f;
+
+  auto entry = exists_table.find(f.node_number());
+  if(entry != exists_table.end())
+    return entry->second;
+
+  auto &mgr = manager(f);
+  ebmc_bddt result;
+
+  if(vars.contains(f.var()))
+  {
+    ebmc_bddt low = exists(f.low());
+    result = low.is_true() ? low : low | exists(f.high());
+  }
+  else
+    result = mgr.mk(f.var(), exists(f.low()), exists(f.high()));
+
+  exists_table.emplace(f.node_number(), result);
+
+  return result;
+}
+
+ebmc_bddt bdd_existst::and_exists(const ebmc_bddt &f, const ebmc_bddt &g)
+{
+  if(f.is_false() || g.is_false())
+    return f.is_false() ? f : g;
+
+  if(f.is_true())
+    return exists(g);
+
+  if(g.is_true() || f.node_number() == g.node_number())
+    return exists(f);
+
+  const unsigned top = std::min(f.var(), g.var());
+
+  if(below(top))
+    return f & g;
+
+  // the operation is commutative
+  unsigned a = f.node_number(), b = g.node_number();
+  const std::uint64_t key = a < b ? (std::uint64_t(a) << 32) | b
+                                  : (std::uint64_t(b) << 32) | a;
+
+  auto entry = and_exists_table.find(key);
+  if(entry != and_exists_table.end())
+    return entry->second;
+
+  const ebmc_bddt &f0 = f.var() == top ? f.low() : f;
+  const ebmc_bddt &f1 = f.var() == top ? f.high() : f;
+  const ebmc_bddt &g0 = g.var() == top ? g.low() : g;
+  const ebmc_bddt &g1 = g.var() == top ? g.high() : g;
+
+  auto &mgr = manager(f);
+  ebmc_bddt result;
+
+  if(vars.contains(top))
+  {
+    ebmc_bddt low = and_exists(f0, g0);
+    result = low.is_true() ? low : low | and_exists(f1, g1);
+  }
+  else
+    result = mgr.mk(top, and_exists(f0, g0), and_exists(f1, g1));
+
+  and_exists_table.emplace(key, result);
+
+  return result;
+}
+
+ebmc_bddt exists(const ebmc_bddt &f, const bdd_varsett &vars)
+{
+  return bdd_existst{vars}.exists(f);
+}
+
+ebmc_bddt
+and_exists(const ebmc_bddt &f, const ebmc_bddt &g, const bdd_varsett &vars)
+{
+  return bdd_existst{vars}.and_exists(f, g);
+}
+
+/*******************************************************************\
+
+   Class: bdd_permutet
+
+ Purpose: simultaneous renaming, with a computed table
+
+\*******************************************************************/
+
+class bdd_permutet
+{
+public:
+  explicit bdd_permutet(const std::map<unsigned, unsigned> &_mapping)
+    : mapping(_mapping)
+  {
+  }
+
+  ebmc_bddt operator()(const ebmc_bddt &);
+
+protected:
+  const std::map<unsigned, unsigned> &mapping;
+  std::unordered_map<unsigned, ebmc_bddt> table;
+};
+
+ebmc_bddt bdd_permutet::operator()(const ebmc_bddt &f)
+{
+  if(f.is_constant())
+    return f;
+
+  auto entry = table.find(f.node_number());
+  if(entry != table.end())
+    return entry->second;
+
+  auto &mgr = manager(f);
+  auto low = (*this)(f.low());
+  auto high = (*this)(f.high());
+
+  auto mapping_it = mapping.find(f.var());
+  unsigned var = mapping_it == mapping.end() ? f.var() : mapping_it->second;
+
+  ebmc_bddt result;
+
+  // The constants have a variable number larger than any variable.
+  if(var < low.var() && var < high.var())
+    result = mgr.mk(var, low, high);
+  else
+  {
+    // the mapping does not preserve the order here
+    ebmc_bddt v = mgr.mk(var, mgr.False(), mgr.True());
+    result = (v & high) | (!v & low);
+  }
+
+  table.emplace(f.node_number(), result);
+
+  return result;
+}
+
+ebmc_bddt
+permute(const ebmc_bddt &f, const std::map<unsigned, unsigned> &mapping)
+{
+  return bdd_permutet{mapping}(f);
+}
+
+void permute(
+  const std::vector<ebmc_bddt *> &bdds,
+  const std::map<unsigned, unsigned> &mapping)
+{
+  bdd_permutet permute{mapping};
+
+  // The computed table is indexed by node number. The original BDDs
+  // are kept until the end, so that their nodes are not reused.
+  std::vector<ebmc_bddt> originals;
+  originals.reserve(bdds.size());
+
+  for(auto *bdd : bdds)
+  {
+    originals.push_back(*bdd);
+    *bdd = permute(*bdd);
+  }
+}
+
+std::vector<unsigned> support(const ebmc_bddt &bdd)
+{
+  std::vector<unsigned> result;
+  std::unordered_set<unsigned> visited;
+  std::vector<ebmc_bddt> stack{bdd};
+
+  while(!stack.empty())
+  {
+    const ebmc_bddt node = stack.back();
+    stack.pop_back();
+
+    if(node.is_constant() || !visited.insert(node.node_number()).second)
+      continue;
+
+    result.push_back(node.var());
+    stack.push_back(node.low());
+    stack.push_back(node.high());
+  }
+
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+
+  return result;
+}
+
+std::size_t bdd_size(const ebmc_bddt &bdd)
+{
+  std::unordered_set<unsigned> visited;
+  std::vector<ebmc_bddt> stack{bdd};
+
+  while(!stack.empty())
+  {
+    const ebmc_bddt node = stack.back();
+    stack.pop_back();
+
+    if(!visited.insert(node.node_number()).second || node.is_constant())
+      continue;
+
+    stack.push_back(node.low());
+    stack.push_back(node.high());
+  }
+
+  return visited.size();
+}
+
+/*******************************************************************\
+
+   Class: bdd_simplifyt
+
+ Purpose: generalized cofactor, with a computed table
+
+\*******************************************************************/
+
+class bdd_simplifyt
+{
+public:
+  ebmc_bddt operator()(const ebmc_bddt &f, const ebmc_bddt &care);
+
+protected:
+  std::unordered_map<std::uint64_t, ebmc_bddt> table;
+};
+
+ebmc_bddt bdd_simplifyt::operator()(
+  const ebmc_bddt &f,
+  const ebmc_bddt &care)
+{
+  if(care.is_true() || f.is_constant())
+    return f;
+
+  if(care.is_false())
+    return care;
+
+  if(f.node_number() == care.node_number())
+    return manager(f).True();
+
+  const std::uint64_t key =
+    (std::uint64_t(f.node_number()) << 32) | care.node_number();
+
+  auto entry = table.find(key);
+  if(entry != table.end())
+    return entry->second;
+
+  const unsigned top = std::min(f.var(), care.var());
+  auto &mgr = manager(f);
+  ebmc_bddt result;
+
+  if(care.var() == top && care.low().is_false())
+    result = (*this)(f.var() == top ? f.high() : f, care.high());
+  else if(care.var() == top && care.high().is_false())
+    result = (*this)(f.var() == top ? f.low() : f, care.low());
+  else if(f.var() != top)
+  {
+    // f does not depend on the top variable of the care set
+    result = (*this)(f, care.low() | care.high());
+  }
+  else
+  {
+    const ebmc_bddt &care0 = care.var() == top ? care.low() : care;
+    const ebmc_bddt &care1 = care.var() == top ? care.high() : care;
+    result = mgr.mk(top, (*this)(f.low(), care0), (*this)(f.high(), care1));
+  }
+
+  table.emplace(key, result);
+
+  return result;
+}
+
+ebmc_bddt simplify(const ebmc_bddt &f, const ebmc_bddt &care)
+{
+  return bdd_simplifyt{}(f, care);
+}
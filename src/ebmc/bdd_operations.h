@@ -0,0 +1,82 @@
+/*******************************************************************\
+
+Module: Quantification and Renaming for BDDs
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// Single-pass quantification over a set of variables, the relational
+/// product, simultaneous renaming of variables, and simplification
+/// with a care set, for the BDD package of the BDD engine.
+/// The BDD packages only offer quantification and substitution for one
+/// variable at a time, each of which traverses the entire BDD.
+
+#ifndef CPROVER_EBMC_BDD_OPERATIONS_H
+#define CPROVER_EBMC_BDD_OPERATIONS_H
+
+#include "ebmc_bdd.h"
+
+#include <map>
+#include <vector>
+
+/// A set of BDD variables, for quantification
+class bdd_varsett
+{
+public:
+  bdd_varsett() = default;
+  explicit bdd_varsett(const std::vector<unsigned> &);
+
+  void insert(unsigned var);
+
+  bool contains(unsigned var) const
+  {
+    return var < members.size() && members[var];
+  }
+
+  bool empty() const
+  {
+    return size == 0;
+  }
+
+  // the largest variable in the set; the set must not be empty
+  unsigned max() const
+  {
+    return max_var;
+  }
+
+protected:
+  std::vector<bool> members;
+  std::size_t size = 0;
+  unsigned max_var = 0;
+};
+
+/// exists vars. f
+ebmc_bddt exists(const ebmc_bddt &f, const bdd_varsett &vars);
+
+/// exists vars. (f & g), without building f & g
+ebmc_bddt
+and_exists(const ebmc_bddt &f, const ebmc_bddt &g, const bdd_varsett &);
+
+/// Replace the variables by the variables they are mapped to, all at
+/// once. Variables that are not mapped are kept.
+ebmc_bddt permute(const ebmc_bddt &, const std::map<unsigned, unsigned> &);
+
+/// Rename the variables of all given BDDs in place, sharing the work
+/// between them
+void permute(
+  const std::vector<ebmc_bddt *> &,
+  const std::map<unsigned, unsigned> &);
+
+/// A BDD that agrees with f wherever care holds, and is usually
+/// smaller than f (Coudert and Madre's restrict operator)
+ebmc_bddt simplify(const ebmc_bddt &f, const ebmc_bddt &care);
+
+/// the variables the BDD depends on, sorted
+std::vector<unsigned> support(const ebmc_bddt &);
+
+/// the number of nodes of the BDD, including the constants
+std::size_t bdd_size(const ebmc_bddt &);
+
+#endif // CPROVER_EBMC_BDD_OPERATIONS_H
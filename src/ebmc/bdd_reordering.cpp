@@ -0,0 +1,463 @@
+/*******************************************************************\
+
+Module: Variable Reordering for BDDs
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+#include "bdd_reordering.h"
+
+#include <util/invariant.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+
+/*******************************************************************\
+
+   Class: siftert
+
+ Purpose: A copy of a set of BDDs with a unique table per variable,
+          which allows swapping adjacent levels in place. The
+          variables are numbered by their position in the original
+          order.
+
+\*******************************************************************/
+
+class siftert
+{
+public:
+  siftert(
+    const std::vector<ebmc_bddt> &roots,
+    const std::vector<std::vector<unsigned>> &groups,
+    double max_growth);
+
+  std::map<unsigned, unsigned> operator()();
+
+protected:
+  const double max_growth;
+
+  struct nodet
+  {
+    unsigned var;
+    unsigned low, high;
+    std::size_t references;
+  };
+
+  // nodes 0 and 1 are the constants
+  std::vector<nodet> nodes;
+  std::vector<unsigned> free_nodes;
+  std::size_t size = 0;
+
+  // the unique table of each variable
+  using unique_tablet = std::unordered_map<std::uint64_t, unsigned>;
+  std::vector<unique_tablet> unique_tables;
+
+  std::vector<std::size_t> var_level, level_var;
+
+  // the original number of the variable at each level
+  std::vector<unsigned> original;
+
+  // the groups, in the order of their levels
+  std::vector<std::size_t> group_width;
+  std::vector<std::size_t> group_order;
+
+  static std::uint64_t key(unsigned low, unsigned high)
+  {
+    return (std::uint64_t(low) << 32) | high;
+  }
+
+  unsigned make(unsigned var, unsigned low, unsigned high);
+  void dereference(unsigned);
+  void swap(std::size_t level);
+  void swap_groups(std::size_t position);
+  void sift(std::size_t group);
+
+  std::size_t first_level(std::size_t position) const
+  {
+    std::size_t level = 0;
+    for(std::size_t i = 0; i < position; i++)
+      level += group_width[group_order[i]];
+    return level;
+  }
+};
+
+siftert::siftert(
+  const std::vector<ebmc_bddt> &roots,
+  const std::vector<std::vector<unsigned>> &groups,
+  double _max_growth)
+  : max_growth(_max_growth)
+{
+  // the groups, sorted by their first variable
+  std::vector<const std::vector<unsigned> *> sorted;
+  for(const auto &group : groups)
+    if(!group.empty())
+      sorted.push_back(&group);
+
+  std::sort(
+    sorted.begin(),
+    sorted.end(),
+    [](const std::vector<unsigned> *a, const std::vector<unsigned> *b)
+    { return a->front() < b->front(); });
+
+  std::unordered_map<unsigned, unsigned> var_numbers;
+
+  for(auto *group : sorted)
+  {
+    group_order.push_back(group_width.size());
+    group_width.push_back(group->size());
+
+    for(auto var : *group)
+    {
+      PRECONDITION(original.empty() || original.back() < var);
+      var_numbers.emplace(var, original.size());
+      original.push_back(var);
+    }
+  }
+
+  const unsigned number_of_vars = original.size();
+
+  unique_tables.resize(number_of_vars);
+
+  for(std::size_t i = 0; i < number_of_vars; i++)
+  {
+    var_level.push_back(i);
+    level_var.push_back(i);
+  }
+
+  // the constants are below all variables
+  var_level.push_back(number_of_vars);
+  nodes.push_back({number_of_vars, 0, 0, 0});
+  nodes.push_back({number_of_vars, 1, 1, 0});
+
+  // copy the BDDs, children first
+  std::unordered_map<unsigned, unsigned> copies;
+  std::vector<ebmc_bddt> stack;
+
+  auto copy_of = [&copies](const ebmc_bddt &f) -> unsigned
+  {
+    if(f.is_constant())
+      return f.is_true() ? 1 : 0;
+    auto entry = copies.find(f.node_number());
+    return entry == copies.end() ? unsigned(-1) : entry->second;
+  };
+
+  for(const auto &root : roots)
+  {
+    stack.push_back(root);
+
+    while(!stack.empty())
+    {
+      const ebmc_bddt f = stack.back();
+
+      if(copy_of(f) != unsigned(-1))
+      {
+        stack.pop_back();
+        continue;
+      }
+
+      auto low = copy_of(f.low()), high = copy_of(f.high());
+
+      if(low == unsigned(-1))
+        stack.push_back(f.low());
+      else if(high == unsigned(-1))
+        stack.push_back(f.high());
+      else
+      {
+        auto var = var_numbers.find(f.var());
+        PRECONDITION(var != var_numbers.end());
+        copies.emplace(f.node_number(), make(var->second, low, high));
+        stack.pop_back();
+      }
+    }
+
+    // the external reference
+    nodes[copy_of(root)].references++;
+  }
+}
+
+/*******************************************************************\
+
+Function: siftert::make
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: find or add the node, which is unreferenced if new
+
+\*******************************************************************/
+
+unsigned siftert::make(unsigned var, unsigned low, unsigned high)
+{
+  if(low == high)
+    return low;
+
+  auto &unique_table = unique_tables[var];
+  auto entry = unique_table.find(key(low, high));
+  if(entry != unique_table.end())
+    return entry->second;
+
+  unsigned id;
+
+  if(free_nodes.empty())
+  {
+    id = nodes.size();
+    nodes.push_back({var, low, high, 0});
+  }
+  else
+  {
+    id = free_nodes.back();
+    free_nodes.pop_back();
+    nodes[id] = {var, low, high, 0};
+  }
+
+  nodes[low].references++;
+  nodes[high].references++;
+  unique_table.emplace(key(low, high), id);
+  size++;
+
+  return id;
+}
+
+/*******************************************************************\
+
+Function: siftert::dereference
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: free the node and its descendants once unreferenced
+
+\*******************************************************************/
+
+void siftert::dereference(unsigned id)
+{
+  std::vector<unsigned> stack{id};
+
+  while(!stack.empty())
+  {
+    unsigned n = stack.back();
+    stack.pop_back();
+
+    // the constants are never freed
+    if(n < 2)
+      continue;
+
+    PRECONDITION(nodes[n].references != 0);
+
+    if(--nodes[n].references != 0)
+      continue;
+
+    const nodet &node = nodes[n];
+    unique_tables[node.var].erase(key(node.low, node.high));
+    stack.push_back(node.low);
+    stack.push_back(node.high);
+    free_nodes.push_back(n);
+    size--;
+  }
+}
+
+/*******************************************************************\
+
+Function: siftert::swap
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: swap the variables at the given level and the level below,
+          keeping the identity of the nodes above
+
+\*******************************************************************/
+
+void siftert::swap(std::size_t level)
+{
+  const unsigned x = level_var[level], y = level_var[level + 1];
+
+  // The nodes of x that do not depend on y stay as they are.
+  std::vector<unsigned> dependent;
+
+  for(const auto &entry : unique_tables[x])
+  {
+    const nodet &node = nodes[entry.second];
+    if(nodes[node.low].var == y || nodes[node.high].var == y)
+      dependent.push_back(entry.second);
+  }
+
+  for(auto id : dependent)
+    unique_tables[x].erase(key(nodes[id].low, nodes[id].high));
+
+  for(auto id : dependent)
+  {
+    const unsigned f0 = nodes[id].low, f1 = nodes[id].high;
+
+    auto cofactors = [this, y](unsigned f)
+    {
+      return nodes[f].var == y ? std::make_pair(nodes[f].low, nodes[f].high)
+                               : std::make_pair(f, f);
+    };
+
+    auto [f00, f01] = cofactors(f0);
+    auto [f10, f11] = cofactors(f1);
+
+    // The node now branches on y first; its function is unchanged.
+    unsigned low = make(x, f00, f10);
+    nodes[low].references++;
+    unsigned high = make(x, f01, f11);
+    nodes[high].references++;
+
+    dereference(f0);
+    dereference(f1);
+
+    nodes[id].var = y;
+    nodes[id].low = low;
+    nodes[id].high = high;
+    unique_tables[y].emplace(key(low, high), id);
+  }
+
+  std::swap(level_var[level], level_var[level + 1]);
+  var_level[x] = level + 1;
+  var_level[y] = level;
+}
+
+/*******************************************************************\
+
+Function: siftert::swap_groups
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: swap the group at the given position with the next one
+
+\*******************************************************************/
+
+void siftert::swap_groups(std::size_t position)
+{
+  const std::size_t first = first_level(position);
+  const std::size_t upper = group_width[group_order[position]];
+  const std::size_t lower = group_width[group_order[position + 1]];
+
+  // move the variables of the upper group down, the last one first
+  for(std::size_t i = upper; i != 0; i--)
+    for(std::size_t j = 0; j < lower; j++)
+      swap(first + i - 1 + j);
+
+  std::swap(group_order[position], group_order[position + 1]);
+}
+
+/*******************************************************************\
+
+Function: siftert::sift
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: move the group through all positions, towards the nearer
+          end first, and leave it where the BDDs are smallest
+
+\*******************************************************************/
+
+void siftert::sift(std::size_t group)
+{
+  const std::size_t number_of_groups = group_order.size();
+
+  std::size_t position =
+    std::find(group_order.begin(), group_order.end(), group) -
+    group_order.begin();
+
+  std::size_t best_size = size, best_position = position;
+
+  auto step = [&](bool down)
+  {
+    if(down)
+      swap_groups(position++);
+    else
+      swap_groups(--position);
+
+    if(size < best_size)
+    {
+      best_size = size;
+      best_position = position;
+    }
+  };
+
+  const bool down_first = position >= number_of_groups / 2;
+
+  for(bool down : {down_first, !down_first})
+  {
+    while(down ? position + 1 < number_of_groups : position > 0)
+    {
+      step(down);
+      if(size > max_growth * best_size)
+        break;
+    }
+  }
+
+  while(position < best_position)
+    step(true);
+
+  while(position > best_position)
+    step(false);
+}
+
+/*******************************************************************\
+
+Function: siftert::operator()
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::map<unsigned, unsigned> siftert::operator()()
+{
+  // the variables with the most nodes go first
+  auto nodes_of = [this](std::size_t group)
+  {
+    std::size_t first = first_level(
+      std::find(group_order.begin(), group_order.end(), group) -
+      group_order.begin());
+    std::size_t result = 0;
+    for(std::size_t i = 0; i < group_width[group]; i++)
+      result += unique_tables[level_var[first + i]].size();
+    return result;
+  };
+
+  std::vector<std::pair<std::size_t, std::size_t>> by_size;
+
+  for(std::size_t group = 0; group < group_width.size(); group++)
+    by_size.emplace_back(nodes_of(group), group);
+
+  std::sort(by_size.rbegin(), by_size.rend());
+
+  for(const auto &entry : by_size)
+    sift(entry.second);
+
+  // The variable at each level takes the number of that level.
+  std::map<unsigned, unsigned> mapping;
+
+  for(std::size_t level = 0; level < level_var.size(); level++)
+  {
+    unsigned from = original[level_var[level]], to = original[level];
+    if(from != to)
+      mapping[from] = to;
+  }
+
+  return mapping;
+}
+
+std::map<unsigned, unsigned> sift(
+  const std::vector<ebmc_bddt> &roots,
+  const std::vector<std::vector<unsigned>> &groups,
+  double max_growth)
+{
+  return siftert{roots, groups, max_growth}();
+}
@@ -0,0 +1,36 @@
+/*******************************************************************\
+
+Module: Variable Reordering for BDDs
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// Dynamic variable reordering by sifting. In the BDD packages, the
+/// number of a variable is its position in the order. Sifting is
+/// therefore done on a private copy of the BDDs that supports swapping
+/// adjacent levels in place, and the resulting order is then applied
+/// to the BDDs of the manager by renaming the variables with permute().
+
+#ifndef CPROVER_EBMC_BDD_REORDERING_H
+#define CPROVER_EBMC_BDD_REORDERING_H
+
+#include "bdd_operations.h"
+
+#include <map>
+#include <vector>
+
+/// Sifting (Rudell) on the given BDDs. Each group of variables is moved
+/// as a block, e.g., a current-state variable with its next-state
+/// variable. The groups must cover the variables the BDDs depend on,
+/// and the variables of each group must be in increasing order. A group
+/// stops moving in one direction once the number of nodes exceeds
+/// max_growth times the smallest number seen. Returns the renaming
+/// that yields the new order.
+std::map<unsigned, unsigned> sift(
+  const std::vector<ebmc_bddt> &roots,
+  const std::vector<std::vector<unsigned>> &groups,
+  double max_growth = 1.2);
+
+#endif // CPROVER_EBMC_BDD_REORDERING_H
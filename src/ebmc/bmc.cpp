@@ -14,6 +14,7 @@ Author: Daniel Kroening, dkr@amazon.com
 #include <trans-word-level/unwind.h>
 
 #include "ebmc_error.h"
+#include "engine_budget.h"
 
 #include <chrono>
 #include <fstream>
@@ -130,6 +131,8 @@ void bmc_with_iterative_constraint_strengthening(
     // This constraint is strenthened in each iteration.
     solver.set_to_true(disjunction(disjuncts));
 
+    cancellation_point();
+
     decision_proceduret::resultt dec_result = solver();
 
     switch(dec_result)
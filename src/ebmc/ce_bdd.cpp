@@ -0,0 +1,527 @@
+/*******************************************************************\
+
+Module: BDD Package with Complement Edges
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+#include "ce_bdd.h"
+
+#include <util/invariant.h>
+
+#include <algorithm>
+#include <ostream>
+#include <unordered_map>
+
+void ce_bddt::reference()
+{
+  if(mgr != nullptr)
+    mgr->nodes[edge >> 1].references++;
+}
+
+void ce_bddt::clear()
+{
+  if(mgr != nullptr)
+  {
+    mgr->nodes[edge >> 1].references--;
+    mgr = nullptr;
+  }
+}
+
+unsigned ce_bddt::var() const
+{
+  return mgr->var_of(edge);
+}
+
+ce_bddt ce_bddt::low() const
+{
+  return ce_bddt(mgr, mgr->low_of(edge));
+}
+
+ce_bddt ce_bddt::high() const
+{
+  return ce_bddt(mgr, mgr->high_of(edge));
+}
+
+ce_bddt ce_bddt::operator&(const ce_bddt &other) const
+{
+  mgr->maybe_collect_garbage();
+  return ce_bddt(mgr, mgr->and_edge(edge, other.edge));
+}
+
+ce_bddt ce_bddt::operator|(const ce_bddt &other) const
+{
+  // De Morgan
+  mgr->maybe_collect_garbage();
+  return ce_bddt(mgr, mgr->and_edge(edge ^ 1, other.edge ^ 1) ^ 1);
+}
+
+ce_bddt ce_bddt::operator^(const ce_bddt &other) const
+{
+  mgr->maybe_collect_garbage();
+  return ce_bddt(mgr, mgr->xor_edge(edge, other.edge));
+}
+
+ce_bddt ce_bddt::operator==(const ce_bddt &other) const
+{
+  mgr->maybe_collect_garbage();
+  return ce_bddt(mgr, mgr->xor_edge(edge, other.edge) ^ 1);
+}
+
+/*******************************************************************\
+
+Function: ce_bdd_mgrt::ce_bdd_mgrt
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+ce_bdd_mgrt::ce_bdd_mgrt() : gc_threshold(1 << 16)
+{
+  // the constant true; its children are never used
+  nodes.push_back({terminal_var, 0, 0, 0});
+  unique_table.resize(1 << 16, 0);
+  cache.resize(1 << 16, {opt::NONE, 0, 0, 0});
+}
+
+/*******************************************************************\
+
+Function: ce_bdd_mgrt::Var
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: a new variable, after all existing ones in the order
+
+\*******************************************************************/
+
+ce_bddt ce_bdd_mgrt::Var(const std::string &label)
+{
+  var_table.push_back({label});
+  return mk(var_table.size() - 1, False(), True());
+}
+
+ce_bddt ce_bdd_mgrt::mk(unsigned var, const ce_bddt &low, const ce_bddt &high)
+{
+  PRECONDITION(var < low.var() && var < high.var());
+  maybe_collect_garbage();
+  return ce_bddt(this, mk_edge(var, low.edge, high.edge));
+}
+
+/*******************************************************************\
+
+Function: ce_bdd_mgrt::mk_edge
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: find or add the node; the high edge of a node is never
+          complemented, which makes the representation canonical
+
+\*******************************************************************/
+
+ce_bdd_mgrt::edget
+ce_bdd_mgrt::mk_edge(unsigned var, edget low, edget high)
+{
+  if(low == high)
+    return low;
+
+  const edget complement = high & 1;
+  low ^= complement;
+  high ^= complement;
+
+  const std::size_t mask = unique_table.size() - 1;
+  std::size_t slot = hash(var, low, high) & mask;
+
+  while(unique_table[slot] != 0)
+  {
+    const nodet &node = nodes[unique_table[slot]];
+    if(node.var == var && node.low == low && node.high == high)
+      return (unique_table[slot] << 1) | complement;
+    slot = (slot + 1) & mask;
+  }
+
+  std::uint32_t n;
+
+  if(free_nodes.empty())
+  {
+    n = nodes.size();
+    nodes.push_back({var, low, high, 0});
+  }
+  else
+  {
+    n = free_nodes.back();
+    free_nodes.pop_back();
+    nodes[n] = {var, low, high, 0};
+  }
+
+  // at most half full; the new node is among those rehashed
+  if(2 * (unique_entries + 1) > unique_table.size())
+    resize_unique_table(2 * unique_table.size());
+  else
+  {
+    unique_table[slot] = n;
+    unique_entries++;
+  }
+
+  return (n << 1) | complement;
+}
+
+void ce_bdd_mgrt::insert_unique(std::uint32_t n)
+{
+  const nodet &node = nodes[n];
+  const std::size_t mask = unique_table.size() - 1;
+  std::size_t slot = hash(node.var, node.low, node.high) & mask;
+
+  while(unique_table[slot] != 0)
+    slot = (slot + 1) & mask;
+
+  unique_table[slot] = n;
+  unique_entries++;
+}
+
+void ce_bdd_mgrt::resize_unique_table(std::size_t size)
+{
+  unique_table.assign(size, 0);
+  unique_entries = 0;
+
+  for(std::uint32_t n = 1; n < nodes.size(); n++)
+    if(nodes[n].var != free_var)
+      insert_unique(n);
+}
+
+/*******************************************************************\
+
+Function: ce_bdd_mgrt::and_edge
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+ce_bdd_mgrt::edget ce_bdd_mgrt::and_edge(edget f, edget g)
+{
+  if(f == g || g == ce_bddt::true_edge)
+    return f;
+
+  if(f == ce_bddt::true_edge)
+    return g;
+
+  if(
+    f == (g ^ 1) || f == ce_bddt::false_edge || g == ce_bddt::false_edge)
+  {
+    return ce_bddt::false_edge;
+  }
+
+  // the operation is commutative
+  if(f > g)
+    std::swap(f, g);
+
+  const std::size_t slot =
+    hash(unsigned(opt::AND), f, g) & (cache.size() - 1);
+
+  if(cache[slot].op == opt::AND && cache[slot].a == f && cache[slot].b == g)
+    return cache[slot].result;
+
+  const unsigned top = std::min(var_of(f), var_of(g));
+  const bool f_top = var_of(f) == top, g_top = var_of(g) == top;
+
+  edget low =
+    and_edge(f_top ? low_of(f) : f, g_top ? low_of(g) : g);
+  edget high =
+    and_edge(f_top ? high_of(f) : f, g_top ? high_of(g) : g);
+  edget result = mk_edge(top, low, high);
+
+  cache[slot] = {opt::AND, f, g, result};
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: ce_bdd_mgrt::xor_edge
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+ce_bdd_mgrt::edget ce_bdd_mgrt::xor_edge(edget f, edget g)
+{
+  // !f ^ g = !(f ^ g)
+  const edget complement = (f ^ g) & 1;
+  f &= ~edget(1);
+  g &= ~edget(1);
+
+  if(f == g)
+    return ce_bddt::false_edge ^ complement;
+
+  if(f == ce_bddt::true_edge)
+    return g ^ 1 ^ complement;
+
+  if(g == ce_bddt::true_edge)
+    return f ^ 1 ^ complement;
+
+  if(f > g)
+    std::swap(f, g);
+
+  const std::size_t slot =
+    hash(unsigned(opt::XOR), f, g) & (cache.size() - 1);
+
+  if(cache[slot].op == opt::XOR && cache[slot].a == f && cache[slot].b == g)
+    return cache[slot].result ^ complement;
+
+  const unsigned top = std::min(var_of(f), var_of(g));
+  const bool f_top = var_of(f) == top, g_top = var_of(g) == top;
+
+  edget low =
+    xor_edge(f_top ? low_of(f) : f, g_top ? low_of(g) : g);
+  edget high =
+    xor_edge(f_top ? high_of(f) : f, g_top ? high_of(g) : g);
+  edget result = mk_edge(top, low, high);
+
+  cache[slot] = {opt::XOR, f, g, result};
+
+  return result ^ complement;
+}
+
+/*******************************************************************\
+
+Function: ce_bdd_mgrt::maybe_collect_garbage
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void ce_bdd_mgrt::maybe_collect_garbage()
+{
+  if(nodes.size() - free_nodes.size() > gc_threshold)
+    collect_garbage();
+}
+
+/*******************************************************************\
+
+Function: ce_bdd_mgrt::collect_garbage
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: mark the nodes reachable from a ce_bddt, and put the others
+          on the free list
+
+\*******************************************************************/
+
+void ce_bdd_mgrt::collect_garbage()
+{
+  std::vector<bool> marked(nodes.size(), false);
+  std::vector<std::uint32_t> stack;
+
+  for(std::uint32_t n = 1; n < nodes.size(); n++)
+    if(nodes[n].var != free_var && nodes[n].references != 0)
+      stack.push_back(n);
+
+  while(!stack.empty())
+  {
+    std::uint32_t n = stack.back();
+    stack.pop_back();
+
+    if(n == 0 || marked[n])
+      continue;
+
+    marked[n] = true;
+    stack.push_back(index(nodes[n].low));
+    stack.push_back(index(nodes[n].high));
+  }
+
+  for(std::uint32_t n = 1; n < nodes.size(); n++)
+    if(!marked[n] && nodes[n].var != free_var)
+    {
+      nodes[n].var = free_var;
+      free_nodes.push_back(n);
+    }
+
+  const std::size_t live = nodes.size() - 1 - free_nodes.size();
+
+  // The table is rebuilt without the freed nodes, at most a quarter
+  // full, and shrinks when it is mostly empty.
+  std::size_t size = unique_table.size();
+  while(size > (1 << 16) && 8 * live < size)
+    size /= 2;
+  while(4 * live > size)
+    size *= 2;
+
+  resize_unique_table(size);
+
+  // The cached results may refer to freed nodes. The cache grows with
+  // the number of nodes.
+  std::size_t cache_size = cache.size();
+  while(cache_size < live && cache_size < (1 << 22))
+    cache_size *= 2;
+
+  cache.assign(cache_size, {opt::NONE, 0, 0, 0});
+
+  gc_threshold = std::max(std::size_t(1) << 16, 2 * live);
+}
+
+/*******************************************************************\
+
+Function: ce_bdd_mgrt::number_of_nodes
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::size_t ce_bdd_mgrt::number_of_nodes() const
+{
+  return nodes.size() - 1 - free_nodes.size();
+}
+
+/*******************************************************************\
+
+Function: ce_bdd_mgrt::DumpTable
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void ce_bdd_mgrt::DumpTable(std::ostream &out) const
+{
+  out << "# Var Low High\n";
+
+  for(std::uint32_t n = 1; n < nodes.size(); n++)
+  {
+    const nodet &node = nodes[n];
+
+    if(node.var == free_var)
+      continue;
+
+    auto edge = [](edget e)
+    { return (is_complement(e) ? "~" : "") + std::to_string(index(e)); };
+
+    out << n << ' ' << node.var << ' ' << edge(node.low) << ' '
+        << edge(node.high) << '\n';
+  }
+}
+
+/*******************************************************************\
+
+Function: restrict
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: f with var set to the given value
+
+\*******************************************************************/
+
+static ce_bddt restrict(
+  const ce_bddt &f,
+  unsigned var,
+  bool value,
+  std::unordered_map<unsigned, ce_bddt> &table)
+{
+  if(f.var() > var)
+    return f;
+
+  if(f.var() == var)
+    return value ? f.high() : f.low();
+
+  auto entry = table.find(f.node_number());
+  if(entry != table.end())
+    return entry->second;
+
+  ce_bddt result = f.manager().mk(
+    f.var(),
+    restrict(f.low(), var, value, table),
+    restrict(f.high(), var, value, table));
+
+  table.emplace(f.node_number(), result);
+
+  return result;
+}
+
+ce_bddt exists(const ce_bddt &f, unsigned var)
+{
+  std::unordered_map<unsigned, ce_bddt> table0, table1;
+  return restrict(f, var, false, table0) | restrict(f, var, true, table1);
+}
+
+ce_bddt substitute(const ce_bddt &f, unsigned var, const ce_bddt &g)
+{
+  std::unordered_map<unsigned, ce_bddt> table0, table1;
+  ce_bddt f0 = restrict(f, var, false, table0);
+  ce_bddt f1 = restrict(f, var, true, table1);
+  return (g & f1) | (!g & f0);
+}
+
+/*******************************************************************\
+
+Function: cubes
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static void
+cubes(const ce_bddt &u, const std::string &path, std::string &result)
+{
+  if(u.is_false())
+    return;
+
+  if(u.is_true())
+  {
+    result += path;
+    result += '\n';
+    return;
+  }
+
+  const std::string &label = u.manager().var_table[u.var()].label;
+  const std::string separator = path.empty() ? "" : " & ";
+
+  cubes(u.low(), path + separator + '!' + label, result);
+  cubes(u.high(), path + separator + label, result);
+}
+
+std::string cubes(const ce_bddt &u)
+{
+  if(u.is_false())
+    return "false\n";
+
+  if(u.is_true())
+    return "true\n";
+
+  std::string result;
+  cubes(u, "", result);
+  return result;
+}
@@ -0,0 +1,280 @@
+/*******************************************************************\
+
+Module: BDD Package with Complement Edges
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// A BDD package for model checking, with the interface of miniBDD.
+/// Edges carry a complement bit, so negation is free and f and !f
+/// share all nodes. The nodes are 16 bytes each, four to a cache line.
+/// The unique table uses open addressing, the computed table is a
+/// direct-mapped cache that loses entries on collisions, and the nodes
+/// that no BDD refers to are reclaimed by mark-and-sweep.
+
+#ifndef CPROVER_EBMC_CE_BDD_H
+#define CPROVER_EBMC_CE_BDD_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+class ce_bdd_mgrt;
+
+/// A reference to a BDD node, possibly complemented
+class ce_bddt
+{
+public:
+  ce_bddt() = default;
+
+  ce_bddt(const ce_bddt &other) : mgr(other.mgr), edge(other.edge)
+  {
+    reference();
+  }
+
+  ce_bddt(ce_bddt &&other) noexcept : mgr(other.mgr), edge(other.edge)
+  {
+    other.mgr = nullptr;
+  }
+
+  ce_bddt &operator=(const ce_bddt &other)
+  {
+    ce_bddt tmp(other);
+    swap(tmp);
+    return *this;
+  }
+
+  ce_bddt &operator=(ce_bddt &&other) noexcept
+  {
+    swap(other);
+    return *this;
+  }
+
+  ~ce_bddt()
+  {
+    clear();
+  }
+
+  void swap(ce_bddt &other) noexcept
+  {
+    std::swap(mgr, other.mgr);
+    std::swap(edge, other.edge);
+  }
+
+  bool is_initialized() const
+  {
+    return mgr != nullptr;
+  }
+
+  void clear();
+
+  // the constants have a variable number larger than any variable
+  unsigned var() const;
+  ce_bddt low() const;
+  ce_bddt high() const;
+
+  /// a number that identifies the function in its manager
+  unsigned node_number() const
+  {
+    return edge;
+  }
+
+  bool is_constant() const
+  {
+    return (edge >> 1) == 0;
+  }
+
+  bool is_true() const
+  {
+    return edge == true_edge;
+  }
+
+  bool is_false() const
+  {
+    return edge == false_edge;
+  }
+
+  ce_bddt operator!() const
+  {
+    return ce_bddt(mgr, edge ^ 1);
+  }
+
+  ce_bddt operator&(const ce_bddt &) const;
+  ce_bddt operator|(const ce_bddt &) const;
+  ce_bddt operator^(const ce_bddt &) const;
+  ce_bddt operator==(const ce_bddt &) const;
+
+  ce_bdd_mgrt &manager() const
+  {
+    return *mgr;
+  }
+
+protected:
+  friend class ce_bdd_mgrt;
+
+  // an edge is a node index with the complement flag as lowest bit
+  static constexpr std::uint32_t true_edge = 0;
+  static constexpr std::uint32_t false_edge = 1;
+
+  ce_bdd_mgrt *mgr = nullptr;
+  std::uint32_t edge = 0;
+
+  ce_bddt(ce_bdd_mgrt *_mgr, std::uint32_t _edge) : mgr(_mgr), edge(_edge)
+  {
+    reference();
+  }
+
+  void reference();
+};
+
+/// The manager of the BDD nodes. All BDDs of a manager must have been
+/// destroyed before the manager.
+class ce_bdd_mgrt
+{
+public:
+  ce_bdd_mgrt();
+
+  ce_bdd_mgrt(const ce_bdd_mgrt &) = delete;
+  ce_bdd_mgrt &operator=(const ce_bdd_mgrt &) = delete;
+
+  ce_bddt Var(const std::string &label);
+
+  ce_bddt True() const
+  {
+    return ce_bddt(const_cast<ce_bdd_mgrt *>(this), ce_bddt::true_edge);
+  }
+
+  ce_bddt False() const
+  {
+    return ce_bddt(const_cast<ce_bdd_mgrt *>(this), ce_bddt::false_edge);
+  }
+
+  /// the node with the given variable and children; the variable must
+  /// be smaller than the variables of the children
+  ce_bddt mk(unsigned var, const ce_bddt &low, const ce_bddt &high);
+
+  /// the number of nodes in the table, excluding the constant; this
+  /// includes the nodes that are garbage but not yet collected
+  std::size_t number_of_nodes() const;
+
+  /// puts the nodes that are not reachable from a BDD on the free
+  /// list; this clears the computed table
+  void collect_garbage();
+
+  void DumpTable(std::ostream &) const;
+
+  struct var_table_entryt
+  {
+    std::string label;
+  };
+
+  using var_tablet = std::vector<var_table_entryt>;
+  var_tablet var_table;
+
+  static constexpr unsigned terminal_var =
+    std::numeric_limits<unsigned>::max();
+
+protected:
+  friend class ce_bddt;
+
+  using edget = std::uint32_t;
+
+  struct alignas(16) nodet
+  {
+    std::uint32_t var;
+    edget low, high;
+    // the number of ce_bddt referring to the node
+    std::uint32_t references;
+  };
+
+  static_assert(sizeof(nodet) == 16, "four nodes per cache line");
+
+  // node 0 is the constant true
+  std::vector<nodet> nodes;
+  std::vector<std::uint32_t> free_nodes;
+
+  // marks a node on the free list
+  static constexpr unsigned free_var = terminal_var - 1;
+
+  static edget index(edget e)
+  {
+    return e >> 1;
+  }
+
+  static bool is_complement(edget e)
+  {
+    return (e & 1) != 0;
+  }
+
+  // the unique table, with open addressing and linear probing;
+  // 0 marks an empty slot
+  std::vector<std::uint32_t> unique_table;
+  std::size_t unique_entries = 0;
+
+  static std::size_t hash(unsigned var, edget low, edget high)
+  {
+    std::uint64_t h = (std::uint64_t(var) << 40) ^ (std::uint64_t(low) << 20) ^
+                      high;
+    return std::size_t((h * 0x9E3779B97F4A7C15ull) >> 16);
+  }
+
+  void insert_unique(std::uint32_t node);
+  void resize_unique_table(std::size_t);
+
+  // the computed table, direct mapped and lossy
+  enum class opt : std::uint32_t
+  {
+    NONE,
+    AND,
+    XOR
+  };
+
+  struct cache_entryt
+  {
+    opt op;
+    edget a, b, result;
+  };
+
+  std::vector<cache_entryt> cache;
+
+  // low and high of an edge, complemented if the edge is
+  edget low_of(edget e) const
+  {
+    return nodes[index(e)].low ^ (e & 1);
+  }
+
+  edget high_of(edget e) const
+  {
+    return nodes[index(e)].high ^ (e & 1);
+  }
+
+  unsigned var_of(edget e) const
+  {
+    return nodes[index(e)].var;
+  }
+
+  edget mk_edge(unsigned var, edget low, edget high);
+  edget and_edge(edget, edget);
+  edget xor_edge(edget, edget);
+
+  // Garbage collection happens only when an operation starts, as the
+  // operations hold their intermediate results as plain edges.
+  std::size_t gc_threshold;
+  void maybe_collect_garbage();
+};
+
+/// exists var. f
+ce_bddt exists(const ce_bddt &f, unsigned var);
+
+/// f with var replaced by g
+ce_bddt substitute(const ce_bddt &f, unsigned var, const ce_bddt &g);
+
+/// the cubes of the BDD, one per line
+std::string cubes(const ce_bddt &);
+
+#endif // CPROVER_EBMC_CE_BDD_H
@@ -0,0 +1,303 @@
+/*******************************************************************\
+
+Module: Checkpoints of Engine Runs
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+#include "checkpoint.h"
+
+#include <util/prefix.h>
+#include <util/string2int.h>
+
+#include "ebmc_error.h"
+#include "property_results.h"
+
+#include <cstdio>
+#include <fstream>
+
+/*******************************************************************\
+
+Function: checkpointt::write
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void checkpointt::write(const std::string &file_name) const
+{
+  const auto temporary = file_name + ".tmp";
+
+  {
+    std::ofstream out(temporary);
+
+    out << "ebmc-checkpoint 1\n";
+    out << "engine " << engine << '\n';
+    out << "design " << design << '\n';
+
+    for(const auto &property : results)
+      out << "result " << property_results_to_line(property) << '\n';
+
+    for(const auto &line : state)
+      out << "state " << line << '\n';
+
+    if(!out)
+      throw ebmc_errort() << "failed to write checkpoint " << temporary;
+  }
+
+  if(std::rename(temporary.c_str(), file_name.c_str()) != 0)
+    throw ebmc_errort() << "failed to write checkpoint " << file_name;
+}
+
+/*******************************************************************\
+
+Function: checkpointt::read
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+checkpointt checkpointt::read(const std::string &file_name)
+{
+  std::ifstream in(file_name);
+
+  if(!in)
+    throw ebmc_errort() << "failed to open checkpoint " << file_name;
+
+  std::string line;
+
+  if(!std::getline(in, line) || line != "ebmc-checkpoint 1")
+    throw ebmc_errort() << file_name << " is not a checkpoint";
+
+  checkpointt checkpoint;
+
+  while(std::getline(in, line))
+  {
+    if(has_prefix(line, "engine "))
+      checkpoint.engine = line.substr(7);
+    else if(has_prefix(line, "design "))
+      checkpoint.design = line.substr(7);
+    else if(has_prefix(line, "result "))
+      checkpoint.results.push_back(property_results_from_line(line.substr(7)));
+    else if(has_prefix(line, "state "))
+      checkpoint.state.push_back(line.substr(6));
+    else
+      throw ebmc_errort() << "malformed checkpoint " << file_name;
+  }
+
+  return checkpoint;
+}
+
+/*******************************************************************\
+
+Function: checkpointert::checkpointert
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+checkpointert::checkpointert(
+  const cmdlinet &cmdline,
+  std::string _engine,
+  std::string _design,
+  message_handlert &message_handler)
+  : interval(300),
+    last_save(std::chrono::steady_clock::now()),
+    engine(std::move(_engine)),
+    design(std::move(_design)),
+    message(message_handler)
+{
+  if(cmdline.isset("checkpoint"))
+    file_name = cmdline.get_value("checkpoint");
+
+  if(cmdline.isset("checkpoint-interval"))
+  {
+    auto seconds =
+      string2optional_size_t(cmdline.get_value("checkpoint-interval"));
+
+    if(!seconds.has_value())
+      throw ebmc_errort() << "failed to parse --checkpoint-interval";
+
+    interval = std::chrono::seconds(*seconds);
+  }
+
+  if(cmdline.isset("resume"))
+  {
+    const auto resume_file_name = cmdline.get_value("resume");
+    resumed = checkpointt::read(resume_file_name);
+
+    if(resumed.engine != engine)
+    {
+      throw ebmc_errort() << "the checkpoint " << resume_file_name
+                          << " is for the engine " << resumed.engine;
+    }
+
+    if(resumed.design != design)
+    {
+      throw ebmc_errort() << "the checkpoint " << resume_file_name
+                          << " is for a different design";
+    }
+
+    message.status() << "Resuming from " << resume_file_name << " with "
+                     << resumed.results.size() << " results"
+                     << messaget::eom;
+  }
+}
+
+/*******************************************************************\
+
+Function: checkpointert::restore_results
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void checkpointert::restore_results(ebmc_propertiest &properties) const
+{
+  for(const auto &result : resumed.results)
+  {
+    for(auto &property : properties.properties)
+    {
+      if(property.identifier == result.identifier && property.is_unknown())
+        property.copy_results_from(result);
+    }
+  }
+}
+
+/*******************************************************************\
+
+Function: checkpointert::is_due
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+bool checkpointert::is_due() const
+{
+  return file_name.has_value() &&
+         std::chrono::steady_clock::now() - last_save >= interval;
+}
+
+/*******************************************************************\
+
+Function: checkpointert::save
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void checkpointert::save(
+  const ebmc_propertiest &properties,
+  std::vector<std::string> state)
+{
+  PRECONDITION(file_name.has_value());
+
+  using statust = ebmc_propertiest::propertyt::statust;
+
+  checkpointt checkpoint;
+  checkpoint.engine = engine;
+  checkpoint.design = design;
+  checkpoint.state = std::move(state);
+
+  for(const auto &property : properties.properties)
+  {
+    if(
+      property.is_proved() || property.is_refuted() ||
+      property.status == statust::REFUTED_WITH_BOUND)
+    {
+      checkpoint.results.push_back(property);
+    }
+  }
+
+  checkpoint.write(*file_name);
+  last_save = std::chrono::steady_clock::now();
+
+  message.statistics() << "Checkpoint written to " << *file_name
+                       << messaget::eom;
+}
+
+/*******************************************************************\
+
+Function: has_checkpoint_options
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+bool has_checkpoint_options(const cmdlinet &cmdline)
+{
+  return cmdline.isset("checkpoint") || cmdline.isset("resume");
+}
+
+/*******************************************************************\
+
+Function: check_checkpoint_options
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void check_checkpoint_options(const cmdlinet &cmdline)
+{
+  if(!has_checkpoint_options(cmdline) && !cmdline.isset("checkpoint-interval"))
+    return;
+
+  if(!has_checkpoint_options(cmdline))
+    throw ebmc_errort() << "--checkpoint-interval requires --checkpoint";
+
+  // a single engine run writes the checkpoint
+  for(const char *option :
+      {"portfolio", "workers", "cluster-properties", "schedule-properties"})
+  {
+    if(cmdline.isset(option))
+    {
+      throw ebmc_errort() << "--checkpoint and --resume do not support --"
+                          << option;
+    }
+  }
+
+  const bool supported =
+    cmdline.isset("new-ic3") ||
+    (cmdline.isset("bdd") && cmdline.isset("bdd-forward")) ||
+    (cmdline.isset("k-induction") && cmdline.isset("max-bound"));
+
+  if(!supported)
+  {
+    throw ebmc_errort() << "--checkpoint and --resume require --new-ic3, "
+                        << "--bdd with --bdd-forward, or --k-induction "
+                        << "with --max-bound";
+  }
+}
@@ -0,0 +1,97 @@
+/*******************************************************************\
+
+Module: Checkpoints of Engine Runs
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// --checkpoint FILE, --checkpoint-interval S and --resume FILE: the
+/// state of a long engine run is written to a file periodically, and
+/// a later run on the same design continues from it. The design is
+/// identified by the hash of its netlist.
+
+#ifndef CPROVER_EBMC_CHECKPOINT_H
+#define CPROVER_EBMC_CHECKPOINT_H
+
+#include <util/cmdline.h>
+#include <util/message.h>
+
+#include "ebmc_properties.h"
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <vector>
+
+/// The contents of a checkpoint file
+struct checkpointt
+{
+  std::string engine;
+
+  // the hash of the netlist
+  std::string design;
+
+  // the properties that have a result already
+  std::vector<ebmc_propertiest::propertyt> results;
+
+  // the state of the engine, as lines of text
+  std::vector<std::string> state;
+
+  /// Writes to a temporary file first, and then renames it, so that
+  /// a run that is stopped while writing leaves the previous one.
+  void write(const std::string &file_name) const;
+
+  /// Throws ebmc_errort when the file can't be read or is malformed
+  static checkpointt read(const std::string &file_name);
+};
+
+/// Writes the checkpoints of an engine run, and provides the one to
+/// resume from
+class checkpointert
+{
+public:
+  /// Reads the checkpoint given with --resume, if any, and throws
+  /// ebmc_errort if it is for another engine or another design.
+  checkpointert(
+    const cmdlinet &,
+    std::string engine,
+    std::string design,
+    message_handlert &);
+
+  /// The engine state to resume from; empty when not resuming
+  const std::vector<std::string> &resumed_state() const
+  {
+    return resumed.state;
+  }
+
+  /// Copies the results from the checkpoint into the properties that
+  /// have none yet
+  void restore_results(ebmc_propertiest &) const;
+
+  /// True when --checkpoint is given and the interval has elapsed
+  /// since the last checkpoint
+  bool is_due() const;
+
+  /// Writes a checkpoint with the results of the properties and the
+  /// given engine state
+  void save(const ebmc_propertiest &, std::vector<std::string> state);
+
+protected:
+  std::optional<std::string> file_name;
+  std::chrono::seconds interval;
+  std::chrono::steady_clock::time_point last_save;
+  const std::string engine, design;
+  checkpointt resumed;
+  messaget message;
+};
+
+/// Is any of the checkpoint options given?
+bool has_checkpoint_options(const cmdlinet &);
+
+/// Throws ebmc_errort when the checkpoint options are given without
+/// an engine that supports them
+void check_checkpoint_options(const cmdlinet &);
+
+#endif // CPROVER_EBMC_CHECKPOINT_H
@@ -0,0 +1,937 @@
+/*******************************************************************\
+
+Module: Structural Hash of the Cone of Influence
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+#include "coi_hash.h"
+
+#include <solvers/prop/literal_expr.h>
+#include <trans-netlist/netlist.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <tuple>
+#include <unordered_map>
+
+/*******************************************************************\
+
+Function: hash_mix
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: combine a value into a hash, with the finalizer of
+          splitmix64; unlike std::hash, this is the same for every
+          run and every platform
+
+\*******************************************************************/
+
+static std::uint64_t hash_mix(std::uint64_t h, std::uint64_t value)
+{
+  std::uint64_t x = h ^ (value + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2));
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+  return x ^ (x >> 31);
+}
+
+/*******************************************************************\
+
+Function: hash_string
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: FNV-1a
+
+\*******************************************************************/
+
+static std::uint64_t hash_string(const std::string &s)
+{
+  std::uint64_t h = 0xcbf29ce484222325ull;
+
+  for(unsigned char ch : s)
+  {
+    h ^= ch;
+    h *= 0x100000001b3ull;
+  }
+
+  return h;
+}
+
+/*******************************************************************\
+
+   Class: coi_hashert
+
+ Purpose: Computes the cones of influence and their hashes
+
+\*******************************************************************/
+
+class coi_hashert
+{
+public:
+  coi_hashert(const netlistt &, const ebmc_propertiest &);
+
+  std::uint64_t operator()(const exprt &property);
+
+  /// the current-state latch bits in the cone of the property, sorted
+  std::vector<literalt::var_not> state_bits(const exprt &property);
+
+protected:
+  const netlistt &netlist;
+
+  // the name of the variable nodes: identifier, bit, next state
+  using namet = std::tuple<irep_idt, std::size_t, bool>;
+  std::unordered_map<literalt::var_not, namet> names;
+
+  // current-state variable to next-state literal, and vice versa
+  std::unordered_map<literalt::var_not, literalt> next_of;
+  std::unordered_map<literalt::var_not, literalt::var_not> current_of;
+
+  // The constraints, split into their conjuncts, and the assumptions.
+  // These are included in the cone when they share a variable with it.
+  struct itemt
+  {
+    char kind;
+    std::vector<literalt> literals;
+    const exprt *expr = nullptr;
+  };
+
+  std::vector<itemt> items;
+  std::unordered_map<literalt::var_not, std::vector<std::size_t>> leaf_items;
+
+  // the items without variables are in every cone
+  std::vector<std::size_t> global_items;
+
+  // reset after each property
+  std::vector<bool> in_cone;
+  std::vector<literalt::var_not> cone;
+  std::vector<bool> item_included;
+
+  // valid for one property
+  std::unordered_map<literalt::var_not, std::uint64_t> node_hashes;
+  std::size_t number_of_free_nodes = 0;
+
+  void add_conjuncts(char kind, literalt);
+  static void collect_literals(const exprt &, std::vector<literalt> &);
+  std::vector<literalt::var_not> leaves(const std::vector<literalt> &) const;
+  void compute_cone(const std::vector<literalt> &roots);
+
+  std::uint64_t node_hash(literalt::var_not);
+  std::uint64_t literal_hash(literalt);
+  std::uint64_t expr_hash(const exprt &);
+};
+
+/*******************************************************************\
+
+Function: coi_hashert::coi_hashert
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+coi_hashert::coi_hashert(
+  const netlistt &_netlist,
+  const ebmc_propertiest &properties)
+  : netlist(_netlist),
+    in_cone(_netlist.number_of_nodes(), false)
+{
+  for(const auto &[identifier, var] : netlist.var_map.map)
+  {
+    // the other kinds of variables alias nodes of these
+    if(!var.is_latch() && !var.is_input())
+      continue;
+
+    for(std::size_t bit_nr = 0; bit_nr < var.bits.size(); bit_nr++)
+    {
+      const auto &bit = var.bits[bit_nr];
+
+      if(bit.current.is_constant())
+        continue;
+
+      names.emplace(bit.current.var_no(), namet{identifier, bit_nr, false});
+
+      if(bit.next.is_constant())
+        continue;
+
+      next_of.emplace(bit.current.var_no(), bit.next);
+
+      // inputs have a variable node for the next state
+      if(var.is_input() && netlist.get_node(bit.next).is_var())
+      {
+        names.emplace(bit.next.var_no(), namet{identifier, bit_nr, true});
+        current_of.emplace(bit.next.var_no(), bit.current.var_no());
+      }
+    }
+  }
+
+  for(auto l : netlist.initial)
+    add_conjuncts('I', l);
+
+  for(auto l : netlist.transition)
+    add_conjuncts('T', l);
+
+  for(auto l : netlist.constraints)
+    add_conjuncts('C', l);
+
+  for(const auto &property : properties.properties)
+  {
+    if(!property.is_assumption())
+      continue;
+
+    auto netlist_property = netlist.properties.find(property.identifier);
+
+    if(
+      netlist_property == netlist.properties.end() ||
+      !netlist_property->second.has_value())
+    {
+      continue;
+    }
+
+    itemt item{'A', {}, &*netlist_property->second};
+    collect_literals(*item.expr, item.literals);
+    items.push_back(std::move(item));
+  }
+
+  for(std::size_t i = 0; i < items.size(); i++)
+  {
+    auto item_leaves = leaves(items[i].literals);
+
+    // e.g., a constraint that is false
+    if(item_leaves.empty())
+      global_items.push_back(i);
+
+    for(auto v : item_leaves)
+      leaf_items[v].push_back(i);
+  }
+
+  item_included.resize(items.size(), false);
+}
+
+/*******************************************************************\
+
+Function: coi_hashert::add_conjuncts
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: split the constraint into its conjuncts, as the initial
+          state is given as a single conjunction over all latches
+
+\*******************************************************************/
+
+void coi_hashert::add_conjuncts(char kind, literalt l)
+{
+  std::vector<literalt> stack{l};
+
+  while(!stack.empty())
+  {
+    const literalt top = stack.back();
+    stack.pop_back();
+
+    if(top.is_true())
+      continue;
+
+    if(!top.is_constant() && !top.sign() && netlist.get_node(top).is_and())
+    {
+      stack.push_back(netlist.get_node(top).b);
+      stack.push_back(netlist.get_node(top).a);
+    }
+    else
+      items.push_back(itemt{kind, {top}});
+  }
+}
+
+/*******************************************************************\
+
+Function: coi_hashert::collect_literals
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void coi_hashert::collect_literals(
+  const exprt &expr,
+  std::vector<literalt> &dest)
+{
+  if(expr.id() == ID_literal)
+    dest.push_back(to_literal_expr(expr).get_literal());
+  else
+  {
+    for(const auto &op : expr.operands())
+      collect_literals(op, dest);
+  }
+}
+
+/*******************************************************************\
+
+Function: coi_hashert::leaves
+
+  Inputs:
+
+ Outputs: the variable nodes the literals depend on
+
+ Purpose:
+
+\*******************************************************************/
+
+std::vector<literalt::var_not>
+coi_hashert::leaves(const std::vector<literalt> &literals) const
+{
+  std::vector<literalt::var_not> result, stack;
+  std::unordered_map<literalt::var_not, bool> seen;
+
+  for(auto l : literals)
+    if(!l.is_constant())
+      stack.push_back(l.var_no());
+
+  while(!stack.empty())
+  {
+    const auto v = stack.back();
+    stack.pop_back();
+
+    if(!seen.emplace(v, true).second)
+      continue;
+
+    const auto &node = netlist.nodes[v];
+
+    if(node.is_and())
+    {
+      for(auto child : {node.a, node.b})
+        if(!child.is_constant())
+          stack.push_back(child.var_no());
+    }
+    else
+      result.push_back(v);
+  }
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: coi_hashert::compute_cone
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the nodes the roots depend on, following the latches into
+          their next-state functions, and the constraints that share
+          a variable with the cone
+
+\*******************************************************************/
+
+void coi_hashert::compute_cone(const std::vector<literalt> &roots)
+{
+  // reset
+  for(auto v : cone)
+    in_cone[v] = false;
+  cone.clear();
+  std::fill(item_included.begin(), item_included.end(), false);
+
+  for(auto i : global_items)
+    item_included[i] = true;
+
+  std::vector<literalt::var_not> stack;
+
+  auto push = [&stack](literalt l)
+  {
+    if(!l.is_constant())
+      stack.push_back(l.var_no());
+  };
+
+  for(auto l : roots)
+    push(l);
+
+  while(!stack.empty())
+  {
+    const auto v = stack.back();
+    stack.pop_back();
+
+    if(in_cone[v])
+      continue;
+
+    in_cone[v] = true;
+    cone.push_back(v);
+
+    const auto &node = netlist.nodes[v];
+
+    if(node.is_and())
+    {
+      push(node.a);
+      push(node.b);
+      continue;
+    }
+
+    if(auto next = next_of.find(v); next != next_of.end())
+      push(next->second);
+
+    if(auto current = current_of.find(v); current != current_of.end())
+      stack.push_back(current->second);
+
+    if(auto item_list = leaf_items.find(v); item_list != leaf_items.end())
+    {
+      for(auto i : item_list->second)
+      {
+        if(item_included[i])
+          continue;
+
+        item_included[i] = true;
+
+        for(auto l : items[i].literals)
+          push(l);
+      }
+    }
+  }
+}
+
+/*******************************************************************\
+
+Function: coi_hashert::node_hash
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: The hash of a node. Variables are hashed by their name, and
+          the nodes without a name by the order in which they are
+          first seen.
+
+\*******************************************************************/
+
+std::uint64_t coi_hashert::node_hash(literalt::var_not root)
+{
+  std::vector<literalt::var_not> stack{root};
+
+  while(!stack.empty())
+  {
+    const auto v = stack.back();
+
+    if(node_hashes.find(v) != node_hashes.end())
+    {
+      stack.pop_back();
+      continue;
+    }
+
+    const auto &node = netlist.nodes[v];
+
+    if(!node.is_and())
+    {
+      std::uint64_t h;
+
+      if(auto name = names.find(v); name != names.end())
+      {
+        const auto &[identifier, bit_nr, next] = name->second;
+        h = hash_mix(hash_string(id2string(identifier)), bit_nr);
+        h = hash_mix(h, next ? 2 : 1);
+      }
+      else
+        h = hash_mix(hash_string("free"), number_of_free_nodes++);
+
+      node_hashes.emplace(v, h);
+      stack.pop_back();
+      continue;
+    }
+
+    // the children first, 'a' before 'b'
+    bool ready = true;
+
+    for(auto child : {node.b, node.a})
+      if(
+        !child.is_constant() &&
+        node_hashes.find(child.var_no()) == node_hashes.end())
+      {
+        stack.push_back(child.var_no());
+        ready = false;
+      }
+
+    if(!ready)
+      continue;
+
+    auto h = hash_mix(hash_string("and"), literal_hash(node.a));
+    node_hashes.emplace(v, hash_mix(h, literal_hash(node.b)));
+    stack.pop_back();
+  }
+
+  return node_hashes.at(root);
+}
+
+/*******************************************************************\
+
+Function: coi_hashert::literal_hash
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::uint64_t coi_hashert::literal_hash(literalt l)
+{
+  if(l.is_constant())
+    return hash_mix(hash_string("const"), l.is_true() ? 1 : 0);
+  else
+    return hash_mix(node_hash(l.var_no()), l.sign() ? 1 : 0);
+}
+
+/*******************************************************************\
+
+Function: coi_hashert::expr_hash
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::uint64_t coi_hashert::expr_hash(const exprt &expr)
+{
+  if(expr.id() == ID_literal)
+    return literal_hash(to_literal_expr(expr).get_literal());
+
+  auto h = hash_string(id2string(expr.id()));
+
+  if(expr.id() == ID_constant)
+    h = hash_mix(h, hash_string(id2string(to_constant_expr(expr).get_value())));
+
+  for(const auto &op : expr.operands())
+    h = hash_mix(h, expr_hash(op));
+
+  return h;
+}
+
+/*******************************************************************\
+
+Function: coi_hashert::operator()
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::uint64_t coi_hashert::operator()(const exprt &property)
+{
+  std::vector<literalt> roots;
+  collect_literals(property, roots);
+  compute_cone(roots);
+
+  node_hashes.clear();
+  number_of_free_nodes = 0;
+
+  // bump when the hash changes
+  std::uint64_t h = hash_string("ebmc-coi-hash-1");
+
+  h = hash_mix(h, expr_hash(property));
+
+  // the state variables, ordered by name
+  std::vector<std::tuple<std::string, std::size_t, literalt::var_not>> state;
+
+  for(auto v : cone)
+  {
+    auto name = names.find(v);
+    if(
+      name != names.end() && !std::get<2>(name->second) &&
+      next_of.find(v) != next_of.end())
+    {
+      state.emplace_back(
+        id2string(std::get<0>(name->second)), std::get<1>(name->second), v);
+    }
+  }
+
+  std::sort(state.begin(), state.end());
+
+  for(const auto &[identifier, bit_nr, v] : state)
+  {
+    h = hash_mix(h, node_hash(v));
+    h = hash_mix(h, literal_hash(next_of.at(v)));
+  }
+
+  // the constraints, in the order of the netlist
+  for(std::size_t i = 0; i < items.size(); i++)
+  {
+    if(!item_included[i])
+      continue;
+
+    h = hash_mix(h, items[i].kind);
+
+    if(items[i].expr != nullptr)
+      h = hash_mix(h, expr_hash(*items[i].expr));
+    else
+      h = hash_mix(h, literal_hash(items[i].literals.front()));
+  }
+
+  return h;
+}
+
+/*******************************************************************\
+
+Function: coi_hashert::state_bits
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::vector<literalt::var_not>
+coi_hashert::state_bits(const exprt &property)
+{
+  std::vector<literalt> roots;
+  collect_literals(property, roots);
+  compute_cone(roots);
+
+  std::vector<literalt::var_not> result;
+
+  for(auto v : cone)
+  {
+    auto name = names.find(v);
+    if(
+      name != names.end() && !std::get<2>(name->second) &&
+      next_of.find(v) != next_of.end())
+    {
+      result.push_back(v);
+    }
+  }
+
+  std::sort(result.begin(), result.end());
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: to_hex
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static std::string to_hex(std::uint64_t h)
+{
+  static const char digits[] = "0123456789abcdef";
+  std::string hex;
+
+  for(int shift = 60; shift >= 0; shift -= 4)
+    hex += digits[(h >> shift) & 15];
+
+  return hex;
+}
+
+/*******************************************************************\
+
+Function: cone_of_influence_hashes
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::map<irep_idt, std::string> cone_of_influence_hashes(
+  const netlistt &netlist,
+  const ebmc_propertiest &properties)
+{
+  coi_hashert hasher{netlist, properties};
+  std::map<irep_idt, std::string> result;
+
+  for(const auto &property : properties.properties)
+  {
+    if(property.is_assumption() || property.is_disabled())
+      continue;
+
+    auto netlist_property = netlist.properties.find(property.identifier);
+
+    if(
+      netlist_property == netlist.properties.end() ||
+      !netlist_property->second.has_value())
+    {
+      continue;
+    }
+
+    result.emplace(
+      property.identifier, to_hex(hasher(*netlist_property->second)));
+  }
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: plain_expr_hash
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the literals are hashed by their number
+
+\*******************************************************************/
+
+static std::uint64_t plain_expr_hash(const exprt &expr)
+{
+  if(expr.id() == ID_literal)
+    return hash_mix(
+      hash_string("literal"), to_literal_expr(expr).get_literal().get());
+
+  auto h = hash_string(id2string(expr.id()));
+
+  if(expr.id() == ID_constant)
+    h = hash_mix(h, hash_string(id2string(to_constant_expr(expr).get_value())));
+
+  for(const auto &op : expr.operands())
+    h = hash_mix(h, plain_expr_hash(op));
+
+  return h;
+}
+
+/*******************************************************************\
+
+Function: netlist_hash
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::string netlist_hash(const netlistt &netlist)
+{
+  // bump when the hash changes
+  std::uint64_t h = hash_string("ebmc-netlist-hash-1");
+
+  auto mix_literal = [&h](literalt l) { h = hash_mix(h, l.get()); };
+
+  h = hash_mix(h, netlist.nodes.size());
+
+  for(const auto &node : netlist.nodes)
+  {
+    if(node.is_and())
+    {
+      mix_literal(node.a);
+      mix_literal(node.b);
+    }
+    else
+      h = hash_mix(h, 0);
+  }
+
+  // the maps are not ordered by name
+  for(auto var_it : netlist.var_map.sorted())
+  {
+    const auto &var = var_it->second;
+    h = hash_mix(h, hash_string(id2string(var_it->first)));
+    h = hash_mix(h, static_cast<std::uint64_t>(var.vartype));
+
+    for(const auto &bit : var.bits)
+    {
+      mix_literal(bit.current);
+      mix_literal(bit.next);
+    }
+  }
+
+  for(const auto *literals :
+      {&netlist.initial, &netlist.transition, &netlist.constraints})
+  {
+    h = hash_mix(h, literals->size());
+    for(auto l : *literals)
+      mix_literal(l);
+  }
+
+  std::map<std::string, const std::optional<exprt> *> properties;
+
+  for(const auto &[identifier, property] : netlist.properties)
+    properties.emplace(id2string(identifier), &property);
+
+  for(const auto &[identifier, property] : properties)
+  {
+    h = hash_mix(h, hash_string(identifier));
+    h = hash_mix(h, property->has_value() ? plain_expr_hash(**property) : 0);
+  }
+
+  return to_hex(h);
+}
+
+/*******************************************************************\
+
+Function: cone_of_influence_latches
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::map<irep_idt, std::set<unsigned>> cone_of_influence_latches(
+  const netlistt &netlist,
+  const ebmc_propertiest &properties)
+{
+  coi_hashert hasher{netlist, properties};
+  std::map<irep_idt, std::set<unsigned>> result;
+
+  for(const auto &property : properties.properties)
+  {
+    if(property.is_assumption() || property.is_disabled())
+      continue;
+
+    auto netlist_property = netlist.properties.find(property.identifier);
+
+    if(
+      netlist_property == netlist.properties.end() ||
+      !netlist_property->second.has_value())
+    {
+      continue;
+    }
+
+    const auto bits = hasher.state_bits(*netlist_property->second);
+    result.emplace(
+      property.identifier, std::set<unsigned>{bits.begin(), bits.end()});
+  }
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: cluster_properties
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: Greedy clustering: each property joins the cluster it
+          shares the most latch bits with, provided these are at least
+          half of the smaller of the two cones. Otherwise, it starts a
+          new cluster.
+
+\*******************************************************************/
+
+std::vector<std::set<irep_idt>> cluster_properties(
+  const netlistt &netlist,
+  const ebmc_propertiest &properties)
+{
+  coi_hashert hasher{netlist, properties};
+
+  struct clustert
+  {
+    std::set<irep_idt> properties;
+    std::size_t number_of_bits = 0;
+  };
+
+  std::vector<clustert> clusters;
+
+  // the clusters that have the latch bit in their cone
+  std::unordered_map<literalt::var_not, std::vector<std::size_t>>
+    bit_clusters;
+
+  for(const auto &property : properties.properties)
+  {
+    if(
+      property.is_assumption() || property.is_disabled() ||
+      !property.is_unknown())
+    {
+      continue;
+    }
+
+    auto netlist_property = netlist.properties.find(property.identifier);
+
+    // not translated, left to the engine
+    if(
+      netlist_property == netlist.properties.end() ||
+      !netlist_property->second.has_value())
+    {
+      clusters.push_back(clustert{{property.identifier}, 0});
+      continue;
+    }
+
+    const auto bits = hasher.state_bits(*netlist_property->second);
+
+    // the number of shared bits with each cluster
+    std::unordered_map<std::size_t, std::size_t> shared;
+
+    for(auto v : bits)
+    {
+      if(auto c = bit_clusters.find(v); c != bit_clusters.end())
+        for(auto cluster_nr : c->second)
+          shared[cluster_nr]++;
+    }
+
+    std::optional<std::size_t> best;
+
+    for(const auto &[cluster_nr, count] : shared)
+    {
+      const auto smaller =
+        std::min(bits.size(), clusters[cluster_nr].number_of_bits);
+
+      if(count * 2 < smaller)
+        continue;
+
+      if(
+        !best.has_value() || count > shared[*best] ||
+        (count == shared[*best] && cluster_nr < *best))
+      {
+        best = cluster_nr;
+      }
+    }
+
+    if(!best.has_value())
+    {
+      best = clusters.size();
+      clusters.emplace_back();
+    }
+
+    auto &cluster = clusters[*best];
+    cluster.properties.insert(property.identifier);
+
+    for(auto v : bits)
+    {
+      auto &list = bit_clusters[v];
+      if(std::find(list.begin(), list.end(), *best) == list.end())
+      {
+        list.push_back(*best);
+        cluster.number_of_bits++;
+      }
+    }
+  }
+
+  std::vector<std::set<irep_idt>> result;
+  result.reserve(clusters.size());
+
+  for(auto &cluster : clusters)
+    result.push_back(std::move(cluster.properties));
+
+  return result;
+}
@@ -0,0 +1,52 @@
+/*******************************************************************\
+
+Module: Structural Hash of the Cone of Influence
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// A structural hash of the cone of influence of each property of a
+/// netlist, which does not depend on the numbering of the nodes, and
+/// hence is unaffected by changes to the design outside of the cone,
+/// the latches in the cones, and the clustering of the properties by
+/// their cones
+
+#ifndef CPROVER_EBMC_COI_HASH_H
+#define CPROVER_EBMC_COI_HASH_H
+
+#include "ebmc_properties.h"
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+class netlistt;
+
+/// The hash of the cone of influence of each property that is
+/// translated into the netlist, as 16 hexadecimal digits. The cone
+/// includes the constraints and the assumptions that share a variable
+/// with it, and the initial-state constraints on its latches.
+std::map<irep_idt, std::string>
+cone_of_influence_hashes(const netlistt &, const ebmc_propertiest &);
+
+/// The variable numbers of the current-state latch bits in the cone
+/// of influence of each property that is translated into the netlist
+std::map<irep_idt, std::set<unsigned>>
+cone_of_influence_latches(const netlistt &, const ebmc_propertiest &);
+
+/// A hash of the entire netlist, including the node numbering and the
+/// properties, as 16 hexadecimal digits. Identifies the design of a
+/// checkpoint.
+std::string netlist_hash(const netlistt &);
+
+/// Groups the properties that are still to be checked by the overlap
+/// of the latches in their cones of influence. Properties with
+/// disjoint cones end up in different clusters. The properties that
+/// are not translated into the netlist get a cluster each.
+std::vector<std::set<irep_idt>>
+cluster_properties(const netlistt &, const ebmc_propertiest &);
+
+#endif // CPROVER_EBMC_COI_HASH_H
@@ -0,0 +1,57 @@
+/*******************************************************************\
+
+Module: The BDD Package of the BDD Engine
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// The BDD package used by the BDD engine. Define EBMC_MINIBDD to use
+/// miniBDD from CBMC instead, e.g., for comparing the two.
+
+#ifndef CPROVER_EBMC_EBMC_BDD_H
+#define CPROVER_EBMC_EBMC_BDD_H
+
+#ifdef EBMC_MINIBDD
+
+#  include <solvers/bdd/miniBDD/miniBDD.h>
+
+using ebmc_bdd_mgrt = mini_bdd_mgrt;
+using ebmc_bddt = mini_bddt;
+
+inline mini_bdd_mgrt &manager(const mini_bddt &f)
+{
+  return *f.node->mgr;
+}
+
+/// the number of nodes that are reachable from a BDD
+inline std::size_t number_of_live_nodes(mini_bdd_mgrt &mgr)
+{
+  // miniBDD frees the nodes when they are no longer referenced
+  return mgr.number_of_nodes();
+}
+
+#else
+
+#  include "ce_bdd.h"
+
+using ebmc_bdd_mgrt = ce_bdd_mgrt;
+using ebmc_bddt = ce_bddt;
+
+inline ce_bdd_mgrt &manager(const ce_bddt &f)
+{
+  return f.manager();
+}
+
+/// the number of nodes that are reachable from a BDD; this collects
+/// the garbage, and hence, must not be used during an operation
+inline std::size_t number_of_live_nodes(ce_bdd_mgrt &mgr)
+{
+  mgr.collect_garbage();
+  return mgr.number_of_nodes();
+}
+
+#endif
+
+#endif // CPROVER_EBMC_EBMC_BDD_H
@@ -22,6 +22,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "diatest.h"
 #include "ebmc_error.h"
 #include "ebmc_language.h"
+#include "ebmc_server.h"
 #include "ebmc_version.h"
 #include "format_hooks.h"
 #include "instrument_buechi.h"
@@ -181,8 +182,20 @@ int ebmc_parse_optionst::doit()
       // return do_two_phase_induction();
     }
 
+    // With --server, stdout carries the responses, and hence, all
+    // messages go to stderr, beginning with those of the elaboration.
+    stream_message_handlert stderr_message_handler{std::cerr};
+    stderr_message_handler.set_verbosity(ui_message_handler.get_verbosity());
+    ui_message_handlert ui_stderr_message_handler{stderr_message_handler};
+    ui_stderr_message_handler.set_verbosity(
+      ui_message_handler.get_verbosity());
+
+    ui_message_handlert &message_handler = cmdline.isset("server")
+                                             ? ui_stderr_message_handler
+                                             : ui_message_handler;
+
     // get the transition system
-    ebmc_languagest ebmc_languages{cmdline, ui_message_handler};
+    ebmc_languagest ebmc_languages{cmdline, message_handler};
 
     auto transition_system_opt = ebmc_languages.transition_system();
 
@@ -207,7 +220,7 @@ int ebmc_parse_optionst::doit()
 
     // get the properties
     auto properties = ebmc_propertiest::from_command_line(
-      cmdline, transition_system, ui_message_handler);
+      cmdline, transition_system, message_handler);
 
     if(cmdline.isset("show-properties"))
     {
@@ -223,7 +236,7 @@ int ebmc_parse_optionst::doit()
 
     // LTL/SVA to Buechi?
     if(cmdline.isset("buechi"))
-      instrument_buechi(transition_system, properties, ui_message_handler);
+      instrument_buechi(transition_system, properties, message_handler);
 
     // possibly apply liveness-to-safety
     if(cmdline.isset("liveness-to-safety"))
@@ -364,6 +377,12 @@ int ebmc_parse_optionst::doit()
       return 0;
     }
 
+    if(cmdline.isset("server"))
+    {
+      return ebmc_server(
+        cmdline, transition_system, properties, message_handler);
+    }
+
     auto checker_result = property_checker(
       cmdline, transition_system, properties, ui_message_handler);
 
@@ -420,6 +439,7 @@ void ebmc_parse_optionst::help()
     " {y-p} {uexpr}                  \t specify a property\n"
     " {y--outfile} {ufile name}      \t set output file name (default: stdout)\n"
     " {y--json-result} {ufile name}  \t use JSON for property status and traces\n"
+    " {y--json-stream} {ufile name}  \t write a line of JSON per property as soon as its result is final\n"
     " {y--trace}                     \t generate a trace for failing properties\n"
     " {y--vcd} {ufile name}          \t generate traces in VCD format\n"
     " {y--waveform}                  \t show a waveform for failing properties\n"
@@ -428,14 +448,40 @@ void ebmc_parse_optionst::help()
     " {y--property} {uid}            \t check the property with given ID\n"
     " {y--liveness-to-safety}        \t translate liveness properties to safety properties\n"
     " {y--buechi}                    \t translate LTL/SVA properties to Buechi acceptance\n"
+    " {y--result-cache} {udirectory} \t reuse the results of properties whose cone of influence is unchanged\n"
+    " {y--server}                    \t answer requests to check properties, given as lines of JSON on stdin\n"
+    " {y--server-socket} {upath}     \t with --server, take the requests on the given Unix domain socket\n"
+    " {y--workers} {un}              \t check the properties in up to n forked worker processes\n"
+    " {y--cluster-properties}        \t check the properties with overlapping cones of influence together\n"
+    " {y--schedule-properties}       \t check the properties cheapest first, choosing the engine by their structure\n"
+    " {y--checkpoint} {ufile}        \t write the state of --new-ic3, --bdd-forward or --k-induction --max-bound to file periodically\n"
+    " {y--checkpoint-interval} {us}  \t with --checkpoint, write a checkpoint every {us} seconds (default: 300)\n"
+    " {y--resume} {ufile}            \t continue the run of the checkpoint in file, on the same design\n"
     "\n"
     "Methods:\n"
+    " {y--portfolio}                 \t without a method given, run the engines of the heuristic concurrently\n"
+    " {y--engine-time-limit} {us}    \t without a method given, the wall-clock time budget in seconds per engine\n"
+    " {y--engine-memory-limit} {uMB} \t without a method given, the memory budget in MB per engine\n"
     " {y--k-induction}               \t do k-induction with k=bound\n"
+    "    {y--max-bound} {unr}        \t increase k incrementally up to the given bound\n"
+    "    {y--simple-path}            \t restrict the step case to paths with distinct states\n"
+    "    {y--aux-invariants}         \t assume mined auxiliary invariants in the step case\n"
     " {y--bdd}                       \t use (unbounded) BDD engine\n"
+    "    {y--bdd-forward}            \t use forward reachability for invariants\n"
+    "    {y--bdd-reorder}            \t reorder the BDD variables dynamically (sifting)\n"
+    " {y--bdd-invariants}            \t constrain the netlist with the states reachable over the control latches, computed with BDDs, and assume them in the step case of --k-induction\n"
+    " {y--bdd-invariant-latches} {un}\t with --bdd-invariants, use at most {un} latches (default: 100)\n"
     " {y--ic3}                       \t use IC3 engine with options described below\n"
     "    {y--constr}                 \t use constraints specified in 'file.cnstr'\n"
     "    {y--new-mode}               \t new mode is switched on\n"
     " {y--new-ic3}                   \t use new IC3 engine (AIG-based)\n"
+    "    {y--write-invariant} {ufile}\t write the inductive invariants found to file\n"
+    "    {y--read-invariant} {ufile} \t seed with the invariants in file\n"
+    " {y--ic3-recycle-activations} {un}\n"
+    "                                \t with --new-ic3, rebuild a frame solver after {un} released activation literals (default: 20000, 0: never)\n"
+    " {y--ic3-recycle-learnts} {un}  \t with --new-ic3, rebuild a frame solver with {un} learnt clauses (default: 100000, 0: never)\n"
+    " {y--ic3-recycle-memory} {un}   \t with --new-ic3, rebuild a frame solver using {un} MB (default: 512, 0: never)\n"
+    " {y--word-ic3}                  \t use word-level IC3 engine with predicate abstraction\n"
     " {y--random-traces}             \t generate random traces\n"
     "    {y--traces} {unumber}       \t generate the given number of traces\n"
     "    {y--random-seed} {unumber}  \t use the given random seed\n"
@@ -461,6 +507,7 @@ void ebmc_parse_optionst::help()
 #if defined(HAVE_CADICAL) && defined(HAVE_MINISAT2)
     " {y--cadical}                   \t use CaDiCaL as SAT solver\n"
 #endif
+    " {y--sat-portfolio}             \t race several SAT solvers on each query, taking the first answer\n"
     " {y--dimacs}                    \t output bit-level CNF in DIMACS format\n"
     " {y--smt2}                      \t output word-level SMT 2 formula\n"
     " {y--boolector}                 \t use Boolector as solver\n"
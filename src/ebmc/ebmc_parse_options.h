@@ -23,7 +23,7 @@ public:
   ebmc_parse_optionst(int argc, const char **argv)
     : parse_options_baset(
         "(diameter)(ediameter)"
-        "(diatest)(statebits):(bound):(max-bound):"
+        "(diatest)(statebits):(bound):(max-bound):(simple-path)(aux-invariants)"
         "(show-parse)(show-varmap)(show-symbol-table)(show-netlist)"
         "(show-ldg)(show-modules)(show-module-hierarchy)"
         "(show-trans)(show-bdds)(show-formula)"
@@ -31,18 +31,24 @@ public:
         "(modules-xml):"
         "(show-properties)(property):p:(trace)(waveform)(numbered-trace)"
         "(dimacs)(module):(top):"
-        "(po)(cegar)(k-induction)(2pi)(bound2):"
+        "(po)(cegar)(k-induction)(2pi)(bound2):(portfolio)"
+        "(engine-time-limit):(engine-memory-limit):(result-cache):"
+        "(server)(server-socket):(workers):(cluster-properties)"
+        "(schedule-properties)(checkpoint):(checkpoint-interval):(resume):"
         "(outfile):(xml-ui)(verbosity):(gui)"
-        "(json-modules):(json-properties):(json-result):"
+        "(json-modules):(json-properties):(json-result):(json-stream):"
         "(neural-liveness)(neural-engine):"
         "(reset):(ignore-initial)(initial-zero)"
         "(version)(verilog-rtl)(verilog-netlist)"
         "(compute-interpolant)(interpolation)(interpolation-vmcai)"
-        "(ic3)(new-ic3)(property):(constr)(h)(new-mode)(aiger)"
-        "(interpolation-word)(interpolator):(bdd)"
+        "(ic3)(new-ic3)(word-ic3)(property):(constr)(h)(new-mode)(aiger)"
+        "(write-invariant):(read-invariant):"
+        "(ic3-recycle-activations):(ic3-recycle-learnts):(ic3-recycle-memory):"
+        "(interpolation-word)(interpolator):(bdd)(bdd-forward)(bdd-reorder)"
+        "(bdd-invariants)(bdd-invariant-latches):"
         "(ranking-function):"
         "(smt2)(bitwuzla)(boolector)(cvc3)(cvc4)(cvc5)(mathsat)(yices)(z3)"
-        "(minisat)(cadical)"
+        "(minisat)(cadical)(sat-portfolio)"
         "(aig)(stop-induction)(stop-minimize)(start):(coverage)(naive)"
         "(simple-netlist)"
         "(compute-ct)(dot-netlist)(smv-netlist)(smv-word-level)"
@@ -0,0 +1,590 @@
+/*******************************************************************\
+
+Module: EBMC Server Mode
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+#include "ebmc_server.h"
+
+#include <util/exception_utils.h>
+#include <util/string2int.h>
+
+#include <json/json_parser.h>
+
+#include "ebmc_error.h"
+#include "property_checker.h"
+#include "report_results.h"
+#include "result_stream.h"
+
+#include <iostream>
+#include <set>
+#include <sstream>
+
+#ifndef _WIN32
+#  include <sys/socket.h>
+#  include <sys/un.h>
+
+#  include <cerrno>
+#  include <csignal>
+#  include <cstring>
+#  include <unistd.h>
+#endif
+
+/*******************************************************************\
+
+Function: string_member
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static std::optional<std::string>
+string_member(const json_objectt &object, const std::string &key)
+{
+  auto member = object.find(key);
+
+  if(member == object.end())
+    return {};
+
+  // numbers are given as text
+  if(!member->second.is_string() && !member->second.is_number())
+    throw ebmc_errort() << "expected a string for " << key;
+
+  return member->second.value;
+}
+
+/*******************************************************************\
+
+Function: ebmc_servert::ebmc_servert
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+ebmc_servert::ebmc_servert(
+  const cmdlinet &_cmdline,
+  transition_systemt &_transition_system,
+  ebmc_propertiest &_properties,
+  ui_message_handlert &_message_handler)
+  : cmdline(_cmdline),
+    transition_system(_transition_system),
+    properties(_properties),
+    message_handler(_message_handler),
+    netlist_cache(_transition_system, _properties)
+{
+}
+
+/*******************************************************************\
+
+Function: ebmc_servert::request_cmdline
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the command line of the server, with the engine and the
+          bound of the request
+
+\*******************************************************************/
+
+cmdlinet ebmc_servert::request_cmdline(
+  const std::string &engine,
+  const std::string &bound) const
+{
+  cmdlinet result = cmdline;
+
+  // the results go into the response
+  result.set("json-result", false);
+
+  for(const char *method :
+      {"portfolio", "aig", "k-induction", "bdd", "ic3", "new-ic3", "word-ic3"})
+  {
+    result.set(method, false);
+  }
+
+  if(engine == "heuristic")
+  {
+  }
+  else if(engine == "portfolio")
+    result.set("portfolio");
+  else if(engine == "bmc")
+  {
+    // word-level BMC is the default given a bound
+    if(bound.empty())
+      throw ebmc_errort() << "engine bmc requires a bound";
+  }
+  else if(
+    engine == "aig" || engine == "k-induction" || engine == "bdd" ||
+    engine == "ic3" || engine == "new-ic3" || engine == "word-ic3")
+  {
+    result.set(engine);
+  }
+  else
+    throw ebmc_errort() << "unknown engine " << engine;
+
+  if(!bound.empty())
+  {
+    if(engine == "heuristic" || engine == "portfolio")
+      throw ebmc_errort() << "engine " << engine << " takes no bound";
+
+    if(!string2optional_size_t(bound).has_value())
+      throw ebmc_errort() << "failed to parse bound " << bound;
+
+    result.set("bound", bound);
+  }
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: ebmc_servert::list_properties
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+json_objectt ebmc_servert::list_properties() const
+{
+  json_objectt response;
+  auto &json_properties = response["properties"].make_array();
+
+  for(const auto &property : properties.properties)
+  {
+    if(property.is_disabled())
+      continue;
+
+    json_objectt json_property;
+    json_property["identifier"] = json_stringt{id2string(property.identifier)};
+    json_property["description"] = json_stringt{property.description};
+    json_property["assumption"] = jsonbool(property.is_assumption());
+    json_properties.push_back(std::move(json_property));
+  }
+
+  return response;
+}
+
+/*******************************************************************\
+
+Function: ebmc_servert::check
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+json_objectt ebmc_servert::check(const json_objectt &request)
+{
+  const auto engine = string_member(request, "engine").value_or("heuristic");
+  const auto bound = string_member(request, "bound").value_or("");
+  const auto format = string_member(request, "format").value_or("json");
+
+  if(format != "json" && format != "text")
+    throw ebmc_errort() << "unknown format " << format;
+
+  const auto engine_cmdline = request_cmdline(engine, bound);
+
+  // the properties to check; by default, all of them
+  std::set<irep_idt> selected;
+
+  for(const auto &property : properties.properties)
+    if(!property.is_disabled() && !property.is_assumption())
+      selected.insert(property.identifier);
+
+  auto properties_member = request.find("properties");
+
+  if(properties_member != request.end())
+  {
+    if(!properties_member->second.is_array())
+      throw ebmc_errort() << "expected an array for properties";
+
+    std::set<irep_idt> requested;
+
+    for(const auto &element : to_json_array(properties_member->second))
+    {
+      if(!element.is_string() || selected.count(element.value) == 0)
+        throw ebmc_errort() << "unknown property " << element.value;
+
+      requested.insert(element.value);
+    }
+
+    selected = std::move(requested);
+  }
+
+  // The engines modify the transition system and the properties,
+  // e.g., when instrumenting $past.
+  transition_systemt request_transition_system = transition_system;
+  request_transition_system.main_symbol =
+    &request_transition_system.symbol_table.lookup_ref(
+      transition_system.main_symbol->name);
+
+  ebmc_propertiest request_properties = properties;
+  bool all_known = true;
+
+  for(auto &property : request_properties.properties)
+  {
+    if(property.is_assumption() || property.is_disabled())
+      continue;
+
+    if(
+      selected.count(property.identifier) == 0 ||
+      results.count({engine, bound, property.identifier}) != 0)
+    {
+      property.disable();
+    }
+    else
+      all_known = false;
+  }
+
+  property_checker_resultt result{request_properties};
+
+  if(!all_known)
+  {
+    result = property_checker(
+      engine_cmdline,
+      request_transition_system,
+      request_properties,
+      message_handler);
+
+    if(result.status != property_checker_resultt::statust::VERIFICATION_RESULT)
+      throw ebmc_errort() << "engine " << engine << " failed";
+
+    for(const auto &property : result.properties)
+    {
+      // the others may have another result next time
+      if(
+        !property.is_disabled() && !property.is_assumption() &&
+        !property.is_unknown() && !property.is_failure() &&
+        !property.is_inconclusive())
+      {
+        results.emplace(keyt{engine, bound, property.identifier}, property);
+      }
+    }
+  }
+
+  // combine the results of this and of the earlier requests
+  for(auto &property : result.properties)
+  {
+    if(selected.count(property.identifier) == 0)
+      continue;
+
+    auto earlier = results.find({engine, bound, property.identifier});
+
+    if(earlier != results.end())
+      property.copy_results_from(earlier->second);
+  }
+
+  const namespacet ns{request_transition_system.symbol_table};
+  json_objectt response;
+
+  if(format == "text")
+  {
+    std::ostringstream text;
+    stream_message_handlert text_message_handler{text};
+    ui_message_handlert text_ui_message_handler{text_message_handler};
+
+    report_results(
+      engine_cmdline,
+      engine == "heuristic" || engine == "portfolio",
+      result,
+      ns,
+      text_ui_message_handler);
+
+    response["output"] = json_stringt{text.str()};
+  }
+  else
+  {
+    auto &json_properties = response["properties"].make_array();
+
+    for(const auto &property : result.properties)
+      if(selected.count(property.identifier) != 0)
+        json_properties.push_back(json_result(property, ns));
+  }
+
+  return response;
+}
+
+/*******************************************************************\
+
+Function: ebmc_servert::respond
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::string ebmc_servert::respond(const std::string &request, bool &quit)
+{
+  json_objectt response;
+
+  try
+  {
+    std::istringstream in{request};
+    null_message_handlert null_message_handler;
+    jsont json;
+
+    if(parse_json(in, "request", null_message_handler, json))
+      throw ebmc_errort() << "failed to parse the request";
+
+    if(!json.is_object())
+      throw ebmc_errort() << "expected an object";
+
+    const auto &json_request = to_json_object(json);
+
+    auto id = json_request.find("id");
+    if(id != json_request.end())
+      response["id"] = id->second;
+
+    const auto command =
+      string_member(json_request, "command").value_or("check");
+
+    if(command == "check")
+    {
+      for(auto &[key, value] : check(json_request))
+        response[key] = std::move(value);
+    }
+    else if(command == "properties")
+    {
+      for(auto &[key, value] : list_properties())
+        response[key] = std::move(value);
+    }
+    else if(command == "quit")
+      quit = true;
+    else
+      throw ebmc_errort() << "unknown command " << command;
+  }
+  catch(const ebmc_errort &error)
+  {
+    response["error"] = json_stringt{error.what()};
+  }
+  catch(const cprover_exception_baset &error)
+  {
+    response["error"] = json_stringt{error.what()};
+  }
+  catch(const std::exception &error)
+  {
+    response["error"] = json_stringt{error.what()};
+  }
+  catch(const std::string &error)
+  {
+    response["error"] = json_stringt{error};
+  }
+  catch(const char *error)
+  {
+    response["error"] = json_stringt{error};
+  }
+  catch(...)
+  {
+    // the server answers the next request
+    response["error"] = json_stringt{"exception"};
+  }
+
+  std::ostringstream out;
+  output_json_line(out, response);
+  return out.str();
+}
+
+/*******************************************************************\
+
+Function: ebmc_servert::serve
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void ebmc_servert::serve(std::istream &in, std::ostream &out)
+{
+  std::string line;
+  bool quit = false;
+
+  while(!quit && std::getline(in, line))
+  {
+    if(line.empty())
+      continue;
+
+    out << respond(line, quit) << '\n' << std::flush;
+  }
+}
+
+#ifndef _WIN32
+/*******************************************************************\
+
+Function: ebmc_servert::serve
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void ebmc_servert::serve(const std::string &socket_path)
+{
+  sockaddr_un address;
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+
+  if(socket_path.size() >= sizeof(address.sun_path))
+    throw ebmc_errort() << "socket path " << socket_path << " is too long";
+
+  std::strcpy(address.sun_path, socket_path.c_str());
+
+  const int server_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+
+  if(server_fd < 0)
+    throw ebmc_errort() << "failed to create socket";
+
+  // e.g., left behind by an earlier server
+  ::unlink(socket_path.c_str());
+
+  const auto bind_result =
+    ::bind(server_fd, reinterpret_cast<sockaddr *>(&address), sizeof(address));
+
+  if(bind_result != 0 || ::listen(server_fd, 1) != 0)
+  {
+    ::close(server_fd);
+    throw ebmc_errort() << "failed to listen on " << socket_path << ": "
+                        << std::strerror(errno);
+  }
+
+  // a client that goes away must not end the server
+  std::signal(SIGPIPE, SIG_IGN);
+
+  messaget message{message_handler};
+  message.status() << "Listening on " << socket_path << messaget::eom;
+
+  bool quit = false;
+
+  while(!quit)
+  {
+    const int connection = ::accept(server_fd, nullptr, nullptr);
+
+    if(connection < 0)
+    {
+      if(errno == EINTR)
+        continue;
+      ::close(server_fd);
+      throw ebmc_errort() << "failed to accept: " << std::strerror(errno);
+    }
+
+    std::string buffer;
+    char chunk[4096];
+    bool connected = true;
+
+    while(connected && !quit)
+    {
+      const auto bytes = ::read(connection, chunk, sizeof(chunk));
+
+      if(bytes < 0 && errno == EINTR)
+        continue;
+
+      if(bytes <= 0)
+        break;
+
+      buffer.append(chunk, bytes);
+
+      std::size_t newline;
+
+      while(!quit && (newline = buffer.find('\n')) != std::string::npos)
+      {
+        const std::string line = buffer.substr(0, newline);
+        buffer.erase(0, newline + 1);
+
+        if(line.empty())
+          continue;
+
+        const std::string response = respond(line, quit) + '\n';
+
+        for(std::size_t written = 0; written < response.size();)
+        {
+          const auto result = ::write(
+            connection, response.data() + written, response.size() - written);
+
+          if(result < 0 && errno == EINTR)
+            continue;
+
+          if(result <= 0)
+          {
+            connected = false;
+            break;
+          }
+
+          written += result;
+        }
+      }
+    }
+
+    ::close(connection);
+  }
+
+  ::close(server_fd);
+  ::unlink(socket_path.c_str());
+}
+#endif
+
+/*******************************************************************\
+
+Function: ebmc_server
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+int ebmc_server(
+  const cmdlinet &cmdline,
+  transition_systemt &transition_system,
+  ebmc_propertiest &properties,
+  ui_message_handlert &message_handler)
+{
+  // the bound of the command line would override the one of a request
+  if(cmdline.isset("bound"))
+    throw ebmc_errort() << "the bound is given with the requests";
+
+  if(cmdline.isset("server-socket"))
+  {
+#ifdef _WIN32
+    throw ebmc_errort() << "No support for --server-socket on Windows";
+#else
+    ebmc_servert server{
+      cmdline, transition_system, properties, message_handler};
+    server.serve(cmdline.get_value("server-socket"));
+    return 0;
+#endif
+  }
+
+  // stdout carries the responses; the caller sends the messages to
+  // stderr
+  ebmc_servert server{cmdline, transition_system, properties, message_handler};
+  server.serve(std::cin, std::cout);
+
+  return 0;
+}
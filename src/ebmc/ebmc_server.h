@@ -0,0 +1,94 @@
+/*******************************************************************\
+
+Module: EBMC Server Mode
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// --server: the design is elaborated once, and then the properties
+/// are checked on request. Requests and responses are JSON objects,
+/// one per line, on stdin/stdout, or on the Unix domain socket given
+/// with --server-socket.
+
+#ifndef CPROVER_EBMC_SERVER_H
+#define CPROVER_EBMC_SERVER_H
+
+#include <util/json.h>
+#include <util/ui_message.h>
+
+#include "ebmc_properties.h"
+#include "netlist.h"
+#include "transition_system.h"
+
+#include <iosfwd>
+#include <map>
+#include <tuple>
+
+/*******************************************************************\
+
+   Class: ebmc_servert
+
+ Purpose: Answers requests of the form
+
+          {"id": 1, "command": "check", "properties": ["main.p0"],
+           "engine": "k-induction", "bound": 10, "format": "json"}
+
+          All members but "command" are optional. The commands are
+          "check", "properties" and "quit". The engines are
+          "heuristic", "portfolio", "bmc", "aig", "k-induction", "bdd",
+          "ic3", "new-ic3" and "word-ic3". The format is "json" or
+          "text".
+
+\*******************************************************************/
+
+class ebmc_servert
+{
+public:
+  ebmc_servert(
+    const cmdlinet &,
+    transition_systemt &,
+    ebmc_propertiest &,
+    ui_message_handlert &);
+
+  /// The response to the request, both a line of JSON. Sets quit
+  /// when asked to stop.
+  std::string respond(const std::string &request, bool &quit);
+
+  /// Answers the requests on the stream until the end of the input
+  void serve(std::istream &, std::ostream &);
+
+#ifndef _WIN32
+  /// Answers the requests on the Unix domain socket, one connection
+  /// after the other
+  void serve(const std::string &socket_path);
+#endif
+
+protected:
+  const cmdlinet &cmdline;
+  transition_systemt &transition_system;
+  ebmc_propertiest &properties;
+  ui_message_handlert &message_handler;
+
+  // the netlist is made once, for all properties
+  netlist_cachet netlist_cache;
+
+  // the results of the earlier requests, by engine, bound and property
+  using keyt = std::tuple<std::string, std::string, irep_idt>;
+  std::map<keyt, ebmc_propertiest::propertyt> results;
+
+  json_objectt check(const json_objectt &request);
+  json_objectt list_properties() const;
+  cmdlinet request_cmdline(const std::string &engine, const std::string &bound)
+    const;
+};
+
+/// Implements --server
+int ebmc_server(
+  const cmdlinet &,
+  transition_systemt &,
+  ebmc_propertiest &,
+  ui_message_handlert &);
+
+#endif // CPROVER_EBMC_SERVER_H
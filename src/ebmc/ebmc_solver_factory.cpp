@@ -15,13 +15,179 @@ Author: Daniel Kroening, dkr@amazon.com
 #include <solvers/sat/satcheck_minisat2.h>
 #include <solvers/smt2/smt2_dec.h>
 
+#ifdef HAVE_MINISAT2
+#  include <minisat/simp/SimpSolver.h>
+#endif
+
+#ifdef HAVE_CADICAL
+#  include <cadical.hpp>
+#endif
+
 #include "ebmc_error.h"
 #include "ebmc_version.h"
+#include "engine_budget.h"
+#include "sat_portfolio.h"
 #include "show_formula_solver.h"
 
+#ifdef __linux__
+#  include <sys/syscall.h>
+
+#  include <csignal>
+#  include <set>
+#  include <unistd.h>
+#endif
+
 #include <fstream>
 #include <iostream>
 
+#ifdef HAVE_MINISAT2
+
+/*******************************************************************\
+
+   Class: budgeted_minisatt
+
+ Purpose: MiniSat with simplifier, interrupted once the budget of the
+          engine is exhausted
+
+\*******************************************************************/
+
+class budgeted_minisatt : public satcheck_minisat_simplifiert
+{
+public:
+  explicit budgeted_minisatt(message_handlert &message_handler)
+    : satcheck_minisat_simplifiert(message_handler)
+  {
+  }
+
+protected:
+  resultt do_prop_solve(const bvt &assumptions) override
+  {
+    resultt result;
+
+    {
+      // MiniSat offers no callback, and is interrupted by another thread
+      budget_watchdogt watchdog(
+        cancellation_tokent::active(), [this]() { solver->interrupt(); });
+
+      result = satcheck_minisat_simplifiert::do_prop_solve(assumptions);
+    }
+
+    solver->clearInterrupt();
+
+    return result;
+  }
+};
+
+#endif
+
+#ifdef HAVE_CADICAL
+
+/*******************************************************************\
+
+   Class: budgeted_cadicalt
+
+ Purpose: CaDiCaL with preprocessing, which terminates once the budget
+          of the engine is exhausted
+
+\*******************************************************************/
+
+class budgeted_cadicalt : public satcheck_cadical_preprocessingt
+{
+public:
+  explicit budgeted_cadicalt(message_handlert &message_handler)
+    : satcheck_cadical_preprocessingt(message_handler)
+  {
+    solver->connect_terminator(&terminator);
+  }
+
+  ~budgeted_cadicalt() override
+  {
+    solver->disconnect_terminator();
+  }
+
+protected:
+  // polled by CaDiCaL while it solves, in the thread of the engine
+  class terminatort : public CaDiCaL::Terminator
+  {
+  public:
+    bool terminate() override
+    {
+      auto token = cancellation_tokent::active();
+      return token != nullptr && token->exhausted().has_value();
+    }
+  };
+
+  terminatort terminator;
+};
+
+#endif
+
+#ifdef __linux__
+
+/*******************************************************************\
+
+Function: child_processes
+
+  Inputs: a thread of this process
+
+ Outputs: the processes that the thread has started
+
+ Purpose:
+
+\*******************************************************************/
+
+static std::set<pid_t> child_processes(pid_t tid)
+{
+  std::ifstream children(
+    "/proc/self/task/" + std::to_string(tid) + "/children");
+
+  std::set<pid_t> result;
+  pid_t pid;
+
+  while(children >> pid)
+    result.insert(pid);
+
+  return result;
+}
+
+#endif
+
+/*******************************************************************\
+
+   Class: budgeted_smt2_dect
+
+ Purpose: an SMT solver process, which is terminated once the budget
+          of the engine is exhausted
+
+\*******************************************************************/
+
+class budgeted_smt2_dect : public smt2_dect
+{
+public:
+  using smt2_dect::smt2_dect;
+
+  resultt dec_solve(const exprt &assumption) override
+  {
+#ifdef __linux__
+    // The solver runs in a process started by this thread. This thread
+    // waits for it, and hence, another thread terminates it.
+    const pid_t tid = ::syscall(SYS_gettid);
+    const auto running = child_processes(tid);
+
+    budget_watchdogt watchdog(
+      cancellation_tokent::active(),
+      [tid, &running]()
+      {
+        for(auto pid : child_processes(tid))
+          if(running.count(pid) == 0)
+            ::kill(pid, SIGTERM);
+      });
+#endif
+
+    return smt2_dect::dec_solve(assumption);
+  }
+};
+
 ebmc_solver_factoryt ebmc_solver_factory(const cmdlinet &cmdline)
 {
   if(cmdline.isset("show-formula"))
@@ -119,7 +285,7 @@ ebmc_solver_factoryt ebmc_solver_factory(const cmdlinet &cmdline)
         }
         else
         {
-          auto dec = std::make_unique<smt2_dect>(
+          auto dec = std::make_unique<budgeted_smt2_dect>(
             ns,
             "ebmc",
             std::string("Generated by EBMC ") + EBMC_VERSION,
@@ -142,19 +308,26 @@ ebmc_solver_factoryt ebmc_solver_factory(const cmdlinet &cmdline)
     {
       std::unique_ptr<propt> sat_solver;
 
-      if(cmdline.isset("cadical"))
+      if(cmdline.isset("sat-portfolio"))
+      {
+        sat_solver = std::make_unique<sat_portfoliot>(message_handler);
+      }
+      else if(cmdline.isset("cadical"))
       {
 #ifdef SATCHECK_CADICAL
-        sat_solver = std::unique_ptr<propt>(
-          new satcheck_cadical_preprocessingt{message_handler});
+        sat_solver = std::make_unique<budgeted_cadicalt>(message_handler);
 #else
         throw ebmc_errort() << "support for Cadical not configured";
 #endif
       }
       else
       {
-        sat_solver = std::unique_ptr<propt>(
-          new satcheck_minisat_simplifiert{message_handler});
+#ifdef HAVE_MINISAT2
+        sat_solver = std::make_unique<budgeted_minisatt>(message_handler);
+#else
+        sat_solver =
+          std::make_unique<satcheck_minisat_simplifiert>(message_handler);
+#endif
       }
 
       messaget message(message_handler);
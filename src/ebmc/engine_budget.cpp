@@ -0,0 +1,314 @@
+/*******************************************************************\
+
+Module: Resource Budgets for Engines
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+#include "engine_budget.h"
+
+#include <util/string2int.h>
+
+#include "ebmc_error.h"
+
+#ifdef __linux__
+#  include <unistd.h>
+
+#  include <fstream>
+#elif !defined(_WIN32)
+#  include <sys/resource.h>
+#endif
+
+thread_local const cancellation_tokent *cancellation_tokent::active_token =
+  nullptr;
+
+/*******************************************************************\
+
+Function: resident_memory
+
+  Inputs:
+
+ Outputs: the resident memory of the process in bytes, or the peak
+          where the current value is not available
+
+ Purpose:
+
+\*******************************************************************/
+
+static std::size_t resident_memory()
+{
+#ifdef __linux__
+  std::ifstream statm("/proc/self/statm");
+  std::size_t size, resident;
+  if(statm >> size >> resident)
+    return resident * ::sysconf(_SC_PAGESIZE);
+  return 0;
+#elif !defined(_WIN32)
+  struct rusage usage;
+  if(::getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+#  ifdef __APPLE__
+  return usage.ru_maxrss; // bytes
+#  else
+  return usage.ru_maxrss * std::size_t(1024); // kilobytes
+#  endif
+#else
+  return 0;
+#endif
+}
+
+/*******************************************************************\
+
+Function: engine_budgett::from_command_line
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+engine_budgett engine_budgett::from_command_line(const cmdlinet &cmdline)
+{
+  auto size_option = [&cmdline](const char *option) -> std::size_t
+  {
+    if(!cmdline.isset(option))
+      return 0;
+
+    auto value_opt = string2optional_size_t(cmdline.get_value(option));
+
+    if(!value_opt.has_value())
+      throw ebmc_errort() << "failed to parse --" << option;
+
+    return *value_opt;
+  };
+
+  engine_budgett budget;
+  budget.time_limit = size_option("engine-time-limit");
+
+  // given in megabytes
+  budget.memory_limit = size_option("engine-memory-limit") << 20;
+
+  return budget;
+}
+
+/*******************************************************************\
+
+Function: cancellation_tokent::cancellation_tokent
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+cancellation_tokent::cancellation_tokent(const engine_budgett &_budget)
+  : budget(_budget),
+    start(clockt::now()),
+    memory_at_start(_budget.memory_limit == 0 ? 0 : resident_memory()),
+    previous(active_token),
+    last_memory_check(start)
+{
+  active_token = this;
+}
+
+/*******************************************************************\
+
+Function: cancellation_tokent::~cancellation_tokent
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+cancellation_tokent::~cancellation_tokent()
+{
+  active_token = previous;
+}
+
+/*******************************************************************\
+
+Function: cancellation_tokent::exhausted
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::optional<std::string> cancellation_tokent::exhausted() const
+{
+  const auto now = clockt::now();
+
+  if(
+    budget.time_limit != 0 &&
+    now - start >= std::chrono::seconds(budget.time_limit))
+  {
+    return "time budget of " + std::to_string(budget.time_limit) +
+           "s exhausted";
+  }
+
+  if(budget.memory_limit == 0)
+    return {};
+
+  std::lock_guard<std::mutex> lock(memory_mutex);
+
+  if(
+    !memory_exhausted &&
+    now - last_memory_check >= std::chrono::milliseconds(10))
+  {
+    last_memory_check = now;
+    memory_exhausted =
+      resident_memory() > memory_at_start + budget.memory_limit;
+  }
+
+  if(memory_exhausted)
+  {
+    return "memory budget of " + std::to_string(budget.memory_limit >> 20) +
+           "MB exhausted";
+  }
+
+  return {};
+}
+
+/*******************************************************************\
+
+Function: cancellation_tokent::seconds_left
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::optional<std::size_t> cancellation_tokent::seconds_left() const
+{
+  if(budget.time_limit == 0)
+    return {};
+
+  const auto elapsed =
+    std::chrono::duration_cast<std::chrono::seconds>(clockt::now() - start);
+
+  if(elapsed.count() >= 0 && std::size_t(elapsed.count()) < budget.time_limit)
+    return budget.time_limit - elapsed.count();
+  else
+    return 0;
+}
+
+/*******************************************************************\
+
+Function: cancellation_point
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void cancellation_point()
+{
+  auto token = cancellation_tokent::active();
+
+  if(token == nullptr)
+    return;
+
+  auto reason = token->exhausted();
+
+  if(reason.has_value())
+    throw budget_exhaustedt(*reason);
+}
+
+/*******************************************************************\
+
+Function: budget_watchdogt::budget_watchdogt
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+budget_watchdogt::budget_watchdogt(
+  const cancellation_tokent *token,
+  std::function<void()> interrupt)
+{
+  if(token == nullptr || token->is_unlimited())
+    return;
+
+  thread = std::thread(
+    [this, token, interrupt]()
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+
+      while(!stop)
+      {
+        if(token->exhausted().has_value())
+        {
+          has_fired = true;
+          interrupt();
+          return;
+        }
+
+        condition.wait_for(lock, std::chrono::milliseconds(10));
+      }
+    });
+}
+
+/*******************************************************************\
+
+Function: budget_watchdogt::~budget_watchdogt
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+budget_watchdogt::~budget_watchdogt()
+{
+  if(!thread.joinable())
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stop = true;
+  }
+
+  condition.notify_all();
+  thread.join();
+}
+
+/*******************************************************************\
+
+Function: budget_watchdogt::fired
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+bool budget_watchdogt::fired() const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return has_fired;
+}
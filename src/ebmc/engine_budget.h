@@ -0,0 +1,136 @@
+/*******************************************************************\
+
+Module: Resource Budgets for Engines
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// Wall-clock time and memory budgets for the engines, enforced
+/// cooperatively: the engines call cancellation_point() in their main
+/// loops, and the solvers are interrupted while they solve, either by
+/// a callback or by a budget_watchdogt.
+
+#ifndef CPROVER_EBMC_ENGINE_BUDGET_H
+#define CPROVER_EBMC_ENGINE_BUDGET_H
+
+#include <util/cmdline.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+/// Thrown by cancellation_point() once the budget is exhausted
+class budget_exhaustedt
+{
+public:
+  explicit budget_exhaustedt(std::string _reason) : reason(std::move(_reason))
+  {
+  }
+
+  const std::string &what() const
+  {
+    return reason;
+  }
+
+protected:
+  std::string reason;
+};
+
+/// The resources an engine may use
+struct engine_budgett
+{
+  // wall-clock time, in seconds; 0 means no limit
+  std::size_t time_limit = 0;
+
+  // growth of the resident memory, in bytes; 0 means no limit
+  std::size_t memory_limit = 0;
+
+  bool is_unlimited() const
+  {
+    return time_limit == 0 && memory_limit == 0;
+  }
+
+  /// --engine-time-limit (seconds) and --engine-memory-limit (MB)
+  static engine_budgett from_command_line(const cmdlinet &);
+};
+
+/// Enforces a budget while in scope. Tokens nest; the innermost one is
+/// checked by cancellation_point(). Each thread has its own tokens; a
+/// token may be checked from other threads.
+class cancellation_tokent
+{
+public:
+  explicit cancellation_tokent(const engine_budgett &);
+  ~cancellation_tokent();
+
+  cancellation_tokent(const cancellation_tokent &) = delete;
+  cancellation_tokent &operator=(const cancellation_tokent &) = delete;
+
+  /// the reason, if the budget is exhausted
+  std::optional<std::string> exhausted() const;
+
+  /// the seconds left, if there is a time limit
+  std::optional<std::size_t> seconds_left() const;
+
+  bool is_unlimited() const
+  {
+    return budget.is_unlimited();
+  }
+
+  /// the innermost token in scope in this thread, if any
+  static const cancellation_tokent *active()
+  {
+    return active_token;
+  }
+
+protected:
+  using clockt = std::chrono::steady_clock;
+
+  const engine_budgett budget;
+  const clockt::time_point start;
+  const std::size_t memory_at_start;
+  const cancellation_tokent *const previous;
+
+  // reading the memory use is comparatively expensive
+  mutable std::mutex memory_mutex;
+  mutable clockt::time_point last_memory_check;
+  mutable bool memory_exhausted = false;
+
+  static thread_local const cancellation_tokent *active_token;
+};
+
+/// While in scope, checks the budget of the given token in a thread of
+/// its own, and calls the given function once the budget is exhausted.
+/// This interrupts a solver that does not offer a callback. Does
+/// nothing when there is no token, or when its budget is unlimited.
+class budget_watchdogt
+{
+public:
+  budget_watchdogt(const cancellation_tokent *, std::function<void()>);
+  ~budget_watchdogt();
+
+  budget_watchdogt(const budget_watchdogt &) = delete;
+  budget_watchdogt &operator=(const budget_watchdogt &) = delete;
+
+  /// whether the function has been called
+  bool fired() const;
+
+protected:
+  mutable std::mutex mutex;
+  std::condition_variable condition;
+  bool stop = false;
+  bool has_fired = false;
+  std::thread thread;
+};
+
+/// Throws budget_exhaustedt when the budget of the innermost token
+/// is exhausted; does nothing when there is no token.
+void cancellation_point();
+
+#endif // CPROVER_EBMC_ENGINE_BUDGET_H
@@ -8,14 +8,24 @@ Author: Daniel Kroening, dkr@amazon.com
 
 #include "engine_heuristic.h"
 
+#include <new-ic3/new_ic3_engine.h>
+
+#include "bdd_engine.h"
 #include "bmc.h"
 #include "completeness_threshold.h"
+#include "ebmc_error.h"
 #include "ebmc_solver_factory.h"
+#include "engine_budget.h"
+#include "forked_worker.h"
 #include "k_induction.h"
 #include "liveness_lemma_engine.h"
+#include "property_results.h"
+#include "result_stream.h"
 #include "tautology_check.h"
 #include "transition_property.h"
 
+#include <memory>
+
 [[nodiscard]] property_checker_resultt tautology_check_engine(
   const cmdlinet &,           // unused
   const transition_systemt &, // unused
@@ -26,15 +36,23 @@ Author: Daniel Kroening, dkr@amazon.com
   return tautology_check(properties, solver, message_handler);
 }
 
-// Basic 1-induction for given solver
-[[nodiscard]] property_checker_resultt one_induction_engine(
+// Incremental k-induction with k up to 5 for given solver
+[[nodiscard]] property_checker_resultt k_induction_engine(
   const cmdlinet &, // unused
   const transition_systemt &transition_system,
   const ebmc_propertiest &properties,
   const ebmc_solver_factoryt &solver,
   message_handlert &message_handler)
 {
-  return k_induction(1, transition_system, properties, solver, message_handler);
+  return incremental_k_induction(
+    5,
+    false, // simple_path
+    false, // auxiliary_invariants
+    {},    // invariants
+    transition_system,
+    properties,
+    solver,
+    message_handler);
 }
 
 // Transition property engine
@@ -67,6 +85,31 @@ Author: Daniel Kroening, dkr@amazon.com
     message_handler);
 }
 
+#ifndef _WIN32
+// new IC3, in the portfolio only
+[[nodiscard]] property_checker_resultt new_ic3_portfolio_engine(
+  const cmdlinet &cmdline,
+  transition_systemt &transition_system,
+  ebmc_propertiest &properties,
+  const ebmc_solver_factoryt &, // unused
+  message_handlert &message_handler)
+{
+  return new_ic3_engine(
+    cmdline, transition_system, properties, message_handler);
+}
+#endif
+
+// BDDs, in the portfolio only
+[[nodiscard]] property_checker_resultt bdd_portfolio_engine(
+  const cmdlinet &cmdline,
+  transition_systemt &transition_system,
+  ebmc_propertiest &properties,
+  const ebmc_solver_factoryt &, // unused
+  message_handlert &message_handler)
+{
+  return bdd_engine(cmdline, transition_system, properties, message_handler);
+}
+
 struct enginet
 {
   // the function to call
@@ -87,11 +130,19 @@ const enginet engines[] = {
   {tautology_check_engine, "tautology check"},
   {transition_property_engine, "transition property"},
   {completeness_threshold, "completeness threshold"},
-  {one_induction_engine, "one induction"},
+  {k_induction_engine, "k-induction with k up to 5"},
   {liveness_lemma_engine, "liveness lemma"},
   {bmc_bound_5_engine, "BMC with bound 5"},
 };
 
+// the unbounded engines that the portfolio runs in addition
+const enginet portfolio_engines[] = {
+#ifndef _WIN32
+  {new_ic3_portfolio_engine, "new IC3"},
+#endif
+  {bdd_portfolio_engine, "BDDs"},
+};
+
 void copy_results_to(
   ebmc_propertiest::propertiest &src,
   ebmc_propertiest::propertiest &dest)
@@ -107,6 +158,241 @@ void copy_results_to(
   }
 }
 
+/// Runs the engine within the budget. Once the budget is exhausted,
+/// the properties the engine has not settled are inconclusive.
+static property_checker_resultt run_with_budget(
+  const enginet &engine,
+  const engine_budgett &budget,
+  const cmdlinet &cmdline,
+  transition_systemt &transition_system,
+  ebmc_propertiest &properties,
+  ebmc_solver_factoryt &solver_factory,
+  message_handlert &message_handler)
+{
+  property_checker_resultt result{properties};
+  std::optional<std::string> exhausted;
+
+  {
+    cancellation_tokent token(budget);
+
+    try
+    {
+      result = engine.f(
+        cmdline,
+        transition_system,
+        properties,
+        solver_factory,
+        message_handler);
+
+      // e.g., the SAT solver has run out of time
+      exhausted = token.exhausted();
+    }
+    catch(const budget_exhaustedt &error)
+    {
+      exhausted = error.what();
+    }
+    catch(const ebmc_errort &)
+    {
+      // An engine may report a solver that has run out of time as an
+      // error. This is exhaustion, not a failure of the engine.
+      exhausted = token.exhausted();
+      if(!exhausted.has_value())
+        throw;
+    }
+  }
+
+  if(!exhausted.has_value())
+    return result;
+
+  messaget message(message_handler);
+  message.status() << engine.name << ": " << *exhausted << messaget::eom;
+
+  if(result.status != property_checker_resultt::statust::VERIFICATION_RESULT)
+    result = property_checker_resultt{properties};
+
+  for(auto &property : result.properties)
+  {
+    if(
+      !property.is_assumption() &&
+      (property.is_unknown() || property.is_failure()))
+    {
+      property.inconclusive();
+    }
+  }
+
+  return result;
+}
+
+// how much a result is worth; the unbounded results settle a property
+static int result_rank(const ebmc_propertiest::propertyt &property)
+{
+  using statust = ebmc_propertiest::propertyt::statust;
+
+  if(property.is_proved() || property.is_refuted())
+    return 3;
+  else if(
+    property.is_proved_with_bound() ||
+    property.status == statust::REFUTED_WITH_BOUND)
+    return 2;
+  else if(property.is_unknown())
+    return 0;
+  else
+    return 1;
+}
+
+static bool is_settled(const ebmc_propertiest::propertyt &property)
+{
+  return property.is_assumption() || property.is_disabled() ||
+         property.is_assumed() || result_rank(property) == 3;
+}
+
+/// Takes the result of an engine for a property if it is better than
+/// the one the property has. Returns true if this settles the property.
+static bool merge_result(
+  const ebmc_propertiest::propertyt &result,
+  ebmc_propertiest &properties)
+{
+  for(auto &property : properties.properties)
+  {
+    if(property.identifier != result.identifier)
+      continue;
+
+    if(is_settled(property))
+      return false;
+
+    const int rank = result_rank(result), current = result_rank(property);
+
+    if(
+      rank > current ||
+      (rank == 2 && current == 2 && result.bound > property.bound))
+    {
+      property.copy_results_from(result);
+    }
+
+    return is_settled(property);
+  }
+
+  return false;
+}
+
+/// Runs the engines concurrently, each in a forked process. The results
+/// are merged as each engine finishes, and the engines that are still
+/// running are terminated once all properties are settled.
+static property_checker_resultt engine_portfolio(
+  const cmdlinet &cmdline,
+  transition_systemt &transition_system,
+  ebmc_propertiest &properties,
+  ebmc_solver_factoryt &solver_factory,
+  const engine_budgett &budget,
+  message_handlert &message_handler)
+{
+  messaget message(message_handler);
+
+  std::vector<const enginet *> portfolio;
+
+  for(auto &engine : engines)
+    portfolio.push_back(&engine);
+
+  for(auto &engine : portfolio_engines)
+    portfolio.push_back(&engine);
+
+  std::vector<std::unique_ptr<forked_workert>> workers;
+
+  for(auto *engine : portfolio)
+  {
+    message.status() << "Starting " << engine->name << messaget::eom;
+
+    workers.push_back(std::make_unique<forked_workert>(
+      [engine,
+       &budget,
+       &cmdline,
+       &transition_system,
+       &properties,
+       &solver_factory](
+        message_handlert &worker_message_handler,
+        const forked_workert::sendt &send)
+      {
+        auto result = run_with_budget(
+          *engine,
+          budget,
+          cmdline,
+          transition_system,
+          properties,
+          solver_factory,
+          worker_message_handler);
+
+        if(
+          result.status !=
+          property_checker_resultt::statust::VERIFICATION_RESULT)
+        {
+          return;
+        }
+
+        for(auto &property : result.properties)
+          send(property_results_to_line(property));
+      },
+      message_handler));
+  }
+
+  auto all_settled = [&properties]()
+  {
+    for(auto &property : properties.properties)
+      if(!is_settled(property))
+        return false;
+    return true;
+  };
+
+  while(true)
+  {
+    std::vector<forked_workert *> running;
+
+    for(std::size_t i = 0; i < workers.size(); i++)
+    {
+      if(workers[i] == nullptr)
+        continue;
+
+      const auto &name = portfolio[i]->name;
+
+      try
+      {
+        std::size_t settled = 0;
+
+        for(auto &line : workers[i]->poll())
+          if(merge_result(property_results_from_line(line), properties))
+            settled++;
+
+        if(settled != 0)
+        {
+          stream_results(properties);
+          message.status() << name << " settled " << settled
+                           << " propert" << (settled == 1 ? "y" : "ies")
+                           << messaget::eom;
+        }
+      }
+      catch(const ebmc_errort &error)
+      {
+        message.warning() << name << " failed: " << error.what()
+                          << messaget::eom;
+        workers[i] = nullptr;
+        continue;
+      }
+
+      if(workers[i]->is_running())
+        running.push_back(workers[i].get());
+      else
+        workers[i] = nullptr;
+    }
+
+    if(running.empty() || all_settled())
+      break;
+
+    forked_workert::wait_for_any(running);
+  }
+
+  // the destructors terminate the engines that are still running
+  return property_checker_resultt{properties};
+}
+
 property_checker_resultt engine_heuristic(
   const cmdlinet &cmdline,
   transition_systemt &transition_system,
@@ -128,16 +414,35 @@ property_checker_resultt engine_heuristic(
                    << messaget::eom;
 
   auto solver_factory = ebmc_solver_factory(cmdline);
+  const auto budget = engine_budgett::from_command_line(cmdline);
+
+  if(cmdline.isset("portfolio"))
+  {
+    return engine_portfolio(
+      cmdline,
+      transition_system,
+      properties,
+      solver_factory,
+      budget,
+      message_handler);
+  }
 
   // try engines in given order
   for(auto &engine : engines)
   {
     message.status() << "Attempting " << engine.name << messaget::eom;
 
-    auto result = engine.f(
-      cmdline, transition_system, properties, solver_factory, message_handler);
+    auto result = run_with_budget(
+      engine,
+      budget,
+      cmdline,
+      transition_system,
+      properties,
+      solver_factory,
+      message_handler);
 
     copy_results_to(result.properties, properties.properties);
+    stream_results(properties);
 
     if(!properties.has_unfinished_property())
       return result; // done
@@ -0,0 +1,509 @@
+/*******************************************************************\
+
+Module: Forked Worker Processes
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+#include "forked_worker.h"
+
+#include <util/invariant.h>
+#include <util/string2int.h>
+
+#include "ebmc_error.h"
+#include "engine_budget.h"
+
+#ifndef _WIN32
+#  include <poll.h>
+#  include <signal.h>
+#  ifdef __linux__
+#    include <sys/prctl.h>
+#  endif
+#  include <sys/types.h>
+#  include <sys/wait.h>
+#  include <unistd.h>
+
+#  include <cerrno>
+#  include <cstdio>
+#  include <iostream>
+#endif
+
+#ifndef _WIN32
+
+// The child sends one line per result, message or error:
+//   R<result>
+//   M<level> <message>
+//   E<error>
+//   B<reason the budget is exhausted>
+// with backslash and newline escaped.
+
+static std::string escape(const std::string &src)
+{
+  std::string result;
+  result.reserve(src.size());
+
+  for(auto ch : src)
+  {
+    if(ch == '\\')
+      result += "\\\\";
+    else if(ch == '\n')
+      result += "\\n";
+    else
+      result += ch;
+  }
+
+  return result;
+}
+
+static std::string unescape(const std::string &src)
+{
+  std::string result;
+  result.reserve(src.size());
+
+  for(std::size_t i = 0; i < src.size(); i++)
+  {
+    if(src[i] == '\\' && i + 1 < src.size())
+    {
+      i++;
+      result += src[i] == 'n' ? '\n' : src[i];
+    }
+    else
+      result += src[i];
+  }
+
+  return result;
+}
+
+/// Passes the messages of the child on to the parent
+class pipe_message_handlert : public message_handlert
+{
+public:
+  explicit pipe_message_handlert(const forked_workert::sendt &_send)
+    : send(_send)
+  {
+  }
+
+  void print(unsigned level, const std::string &message) override
+  {
+    message_handlert::print(level, message);
+    send("M" + std::to_string(level) + ' ' + escape(message));
+  }
+
+  void print(unsigned, const xmlt &) override
+  {
+  }
+
+  void print(unsigned, const jsont &) override
+  {
+  }
+
+  void flush(unsigned) override
+  {
+  }
+
+protected:
+  const forked_workert::sendt &send;
+};
+
+static void write_line(int fd, const std::string &line)
+{
+  std::string data = line + '\n';
+  const char *p = data.data();
+  std::size_t left = data.size();
+
+  while(left != 0)
+  {
+    auto written = ::write(fd, p, left);
+    if(written < 0)
+    {
+      if(errno == EINTR)
+        continue;
+      // the parent is gone
+      _exit(1);
+    }
+    p += written;
+    left -= written;
+  }
+}
+
+#endif
+
+/*******************************************************************\
+
+Function: forked_workert::forked_workert
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+forked_workert::forked_workert(
+  workt work,
+  message_handlert &_message_handler)
+  : message_handler(_message_handler)
+{
+#ifdef _WIN32
+  sendt send = [this](const std::string &line) { lines.push_back(line); };
+  work(message_handler, send);
+#else
+  int fds[2];
+  if(::pipe(fds) != 0)
+    throw ebmc_errort() << "failed to create pipe";
+
+  // Anything buffered would otherwise be output twice.
+  std::cout.flush();
+  std::cerr.flush();
+  std::fflush(nullptr);
+
+#  ifdef __linux__
+  const auto parent_pid = ::getpid();
+#  endif
+
+  pid = ::fork();
+
+  if(pid == -1)
+  {
+    ::close(fds[0]);
+    ::close(fds[1]);
+    throw ebmc_errort() << "failed to fork";
+  }
+
+  if(pid == 0)
+  {
+    // child
+#  ifdef __linux__
+    // A cancelled worker takes the workers it has started with it.
+    ::prctl(PR_SET_PDEATHSIG, SIGKILL);
+    if(::getppid() != parent_pid)
+      _exit(1);
+#  endif
+
+    ::close(fds[0]);
+    const int out = fds[1];
+    sendt send = [out](const std::string &line) { write_line(out, line); };
+    pipe_message_handlert child_message_handler(send);
+    child_message_handler.set_verbosity(message_handler.get_verbosity());
+
+    int exit_code = 0;
+
+    try
+    {
+      work(child_message_handler, [&send](const std::string &line)
+           { send("R" + escape(line)); });
+    }
+    catch(const ebmc_errort &error)
+    {
+      send("E" + escape(error.what()));
+      exit_code = 1;
+    }
+    catch(const budget_exhaustedt &error)
+    {
+      send("B" + escape(error.what()));
+      exit_code = 1;
+    }
+    catch(...)
+    {
+      send("Eworker failed");
+      exit_code = 1;
+    }
+
+    ::close(out);
+
+    // no destructors, no atexit handlers, no buffers flushed twice
+    _exit(exit_code);
+  }
+
+  // parent
+  ::close(fds[1]);
+  fd = fds[0];
+  running = true;
+#endif
+}
+
+/*******************************************************************\
+
+Function: forked_workert::~forked_workert
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+forked_workert::~forked_workert()
+{
+  cancel();
+}
+
+#ifndef _WIN32
+
+/*******************************************************************\
+
+Function: forked_workert::read
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: read what is available, and return false on end of file
+
+\*******************************************************************/
+
+bool forked_workert::read(bool blocking)
+{
+  while(true)
+  {
+    if(!blocking)
+    {
+      struct pollfd pfd;
+      pfd.fd = fd;
+      pfd.events = POLLIN;
+      pfd.revents = 0;
+      if(::poll(&pfd, 1, 0) <= 0)
+        return true;
+    }
+
+    char chunk[4096];
+    auto result = ::read(fd, chunk, sizeof(chunk));
+
+    if(result < 0)
+    {
+      if(errno == EINTR)
+        continue;
+      return false;
+    }
+
+    if(result == 0)
+      return false;
+
+    buffer.append(chunk, result);
+    split_lines();
+  }
+}
+
+/*******************************************************************\
+
+Function: forked_workert::split_lines
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: relay the complete messages, and keep the complete results
+
+\*******************************************************************/
+
+void forked_workert::split_lines()
+{
+  std::size_t start = 0;
+
+  while(true)
+  {
+    auto end = buffer.find('\n', start);
+    if(end == std::string::npos)
+      break;
+
+    std::string line = buffer.substr(start, end - start);
+    start = end + 1;
+
+    if(line.empty())
+      continue;
+
+    switch(line[0])
+    {
+    case 'R':
+      lines.push_back(unescape(line.substr(1)));
+      break;
+
+    case 'M':
+    {
+      auto space = line.find(' ');
+      auto level = unsafe_string2unsigned(line.substr(1, space - 1));
+      message_handler.print(level, unescape(line.substr(space + 1)));
+      break;
+    }
+
+    case 'E':
+      reap();
+      throw ebmc_errort() << unescape(line.substr(1));
+
+    case 'B':
+      reap();
+      throw budget_exhaustedt(unescape(line.substr(1)));
+
+    default:
+      UNREACHABLE;
+    }
+  }
+
+  buffer.erase(0, start);
+}
+
+/*******************************************************************\
+
+Function: forked_workert::reap
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: wait for the child, and return true if it has terminated
+          normally
+
+\*******************************************************************/
+
+bool forked_workert::reap()
+{
+  if(!running)
+    return true;
+
+  ::close(fd);
+  fd = -1;
+
+  int status = 0;
+  while(::waitpid(pid, &status, 0) == -1 && errno == EINTR)
+  {
+  }
+
+  running = false;
+
+  return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+#endif
+
+/*******************************************************************\
+
+Function: forked_workert::take_lines
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::vector<std::string> forked_workert::take_lines()
+{
+  std::vector<std::string> result;
+  result.swap(lines);
+  return result;
+}
+
+/*******************************************************************\
+
+Function: forked_workert::poll
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::vector<std::string> forked_workert::poll()
+{
+#ifndef _WIN32
+  if(running && !read(false) && !reap())
+    throw ebmc_errort() << "worker process failed";
+#endif
+
+  return take_lines();
+}
+
+/*******************************************************************\
+
+Function: forked_workert::wait_for_any
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void forked_workert::wait_for_any(const std::vector<forked_workert *> &workers)
+{
+#ifndef _WIN32
+  std::vector<struct pollfd> pfds;
+
+  for(auto *worker : workers)
+  {
+    if(worker->running)
+    {
+      struct pollfd pfd;
+      pfd.fd = worker->fd;
+      pfd.events = POLLIN;
+      pfd.revents = 0;
+      pfds.push_back(pfd);
+    }
+  }
+
+  if(pfds.empty())
+    return;
+
+  while(::poll(pfds.data(), pfds.size(), -1) == -1 && errno == EINTR)
+  {
+  }
+#endif
+}
+
+/*******************************************************************\
+
+Function: forked_workert::wait
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::vector<std::string> forked_workert::wait()
+{
+#ifndef _WIN32
+  if(running)
+  {
+    read(true);
+    if(!reap())
+      throw ebmc_errort() << "worker process failed";
+  }
+#endif
+
+  return take_lines();
+}
+
+/*******************************************************************\
+
+Function: forked_workert::cancel
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void forked_workert::cancel()
+{
+#ifndef _WIN32
+  if(running)
+  {
+    ::kill(pid, SIGKILL);
+    reap();
+  }
+#endif
+
+  lines.clear();
+}
@@ -0,0 +1,80 @@
+/*******************************************************************\
+
+Module: Forked Worker Processes
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// Running work concurrently in a forked child process. The irep and
+/// string tables are not thread-safe, but a forked child gets its own
+/// copy-on-write copy of them.
+
+#ifndef CPROVER_EBMC_FORKED_WORKER_H
+#define CPROVER_EBMC_FORKED_WORKER_H
+
+#include <util/message.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+/// Runs the given work in a forked child process. The work reports its
+/// results to the parent as lines of text. The messages of the work are
+/// relayed to the message handler of the parent as they are received.
+/// Where fork() is not available, the work is done in the constructor.
+class forked_workert
+{
+public:
+  using sendt = std::function<void(const std::string &line)>;
+  using workt = std::function<void(message_handlert &, const sendt &)>;
+
+  forked_workert(workt, message_handlert &);
+
+  ~forked_workert();
+
+  forked_workert(const forked_workert &) = delete;
+  forked_workert &operator=(const forked_workert &) = delete;
+
+  /// the lines sent since the last call, without blocking; throws
+  /// when the child has failed, and the next call then returns the
+  /// lines sent before the failure
+  std::vector<std::string> poll();
+
+  /// the lines sent since the last call, blocking until the child
+  /// has terminated; throws when the child has failed, and
+  /// budget_exhaustedt when the child has run out of its budget
+  std::vector<std::string> wait();
+
+  /// terminate the child, discarding anything it has not sent yet
+  void cancel();
+
+  bool is_running() const
+  {
+    return running;
+  }
+
+  /// block until one of the workers has sent something or has
+  /// terminated
+  static void wait_for_any(const std::vector<forked_workert *> &);
+
+protected:
+  message_handlert &message_handler;
+  bool running = false;
+  std::vector<std::string> lines;
+  std::vector<std::string> take_lines();
+
+#ifndef _WIN32
+  int pid = -1;
+  int fd = -1;
+  std::string buffer;
+
+  // returns false on end of file
+  bool read(bool blocking);
+  void split_lines();
+  bool reap();
+#endif
+};
+
+#endif // CPROVER_EBMC_FORKED_WORKER_H
@@ -9,19 +9,33 @@ Author: Daniel Kroening, daniel.kroening@inf.ethz.ch
 #include "k_induction.h"
 
 #include <util/string2int.h>
+#include <util/threeval.h>
 
 #include <temporal-logic/temporal_logic.h>
+#include <trans-netlist/netlist.h>
+#include <trans-netlist/trans_to_netlist.h>
 #include <trans-word-level/instantiate_word_level.h>
 #include <trans-word-level/trans_trace_word_level.h>
 #include <trans-word-level/unwind.h>
 
+#include "auxiliary_invariants.h"
+#include "bdd_invariants.h"
 #include "bmc.h"
+#include "checkpoint.h"
+#include "coi_hash.h"
 #include "ebmc_error.h"
 #include "ebmc_solver_factory.h"
+#include "engine_budget.h"
+#include "forked_worker.h"
 #include "instrument_past.h"
 #include "liveness_to_safety.h"
 
+#include <algorithm>
 #include <fstream>
+#include <map>
+#include <optional>
+#include <utility>
+#include <vector>
 
 /*******************************************************************\
 
@@ -36,15 +50,21 @@ class k_inductiont
 public:
   k_inductiont(
     std::size_t _k,
+    bool _simple_path,
+    bool _auxiliary_invariants,
+    exprt::operandst _invariants,
     const transition_systemt &_transition_system,
     ebmc_propertiest &_properties,
     const ebmc_solver_factoryt &_solver_factory,
     message_handlert &_message_handler)
     : k(_k),
+      simple_path(_simple_path),
+      auxiliary_invariants(_auxiliary_invariants),
       transition_system(_transition_system),
       properties(_properties),
       solver_factory(_solver_factory),
-      message(_message_handler)
+      message(_message_handler),
+      invariants(std::move(_invariants))
   {
   }
 
@@ -59,16 +79,6 @@ public:
     return false;
   }
 
-protected:
-  const std::size_t k;
-  const transition_systemt &transition_system;
-  ebmc_propertiest &properties;
-  const ebmc_solver_factoryt &solver_factory;
-  messaget message;
-
-  void induction_base();
-  void induction_step();
-
   static bool supported(const ebmc_propertiest::propertyt &p)
   {
     auto &expr = p.normalized_expr;
@@ -81,8 +91,150 @@ protected:
     else
       return false;
   }
+
+protected:
+  const std::size_t k;
+  const bool simple_path;
+  const bool auxiliary_invariants;
+  const transition_systemt &transition_system;
+  ebmc_propertiest &properties;
+  const ebmc_solver_factoryt &solver_factory;
+  messaget message;
+
+  // state predicates assumed in the step case
+  exprt::operandst invariants;
+
+  void induction_base();
+
+  // The outcome of the step case, by property: true when the
+  // property is k-inductive, false when not, unknown when the
+  // property is not checked.
+  std::vector<tvt> induction_step(message_handlert &);
+
+  void apply_step(const std::vector<tvt> &);
+
+  static bool needs_step(const ebmc_propertiest::propertyt &property)
+  {
+    return !property.is_disabled() && !property.is_failure() &&
+           !property.is_assumed() && !property.is_unsupported() &&
+           !property.is_proved() && !property.is_refuted();
+  }
 };
 
+/*******************************************************************\
+
+   Class: incremental_k_inductiont
+
+ Purpose: k-induction for k=0, 1, ..., max_k, with one incremental
+          solver for the base case and one for the step case, each
+          extended by one timeframe per iteration. The step case is
+          done concurrently, in a forked process.
+
+\*******************************************************************/
+
+class incremental_k_inductiont
+{
+public:
+  incremental_k_inductiont(
+    std::size_t _max_k,
+    bool _simple_path,
+    bool _auxiliary_invariants,
+    exprt::operandst _invariants,
+    const transition_systemt &_transition_system,
+    ebmc_propertiest &_properties,
+    const ebmc_solver_factoryt &_solver_factory,
+    message_handlert &_message_handler,
+    checkpointert *_checkpointer)
+    : max_k(_max_k),
+      no_timeframes(_max_k + 1),
+      simple_path(_simple_path),
+      auxiliary_invariants(_auxiliary_invariants),
+      solver_factory(_solver_factory),
+      transition_system(_transition_system),
+      properties(_properties),
+      ns(_transition_system.symbol_table),
+      message(_message_handler),
+      base_solver_wrapper(_solver_factory(ns, _message_handler)),
+      base_solver(base_solver_wrapper.decision_procedure()),
+      invariants(std::move(_invariants)),
+      checkpointer(_checkpointer)
+  {
+  }
+
+  void operator()();
+
+protected:
+  const std::size_t max_k;
+  const std::size_t no_timeframes;
+  const bool simple_path;
+  const bool auxiliary_invariants;
+  const ebmc_solver_factoryt &solver_factory;
+  const transition_systemt &transition_system;
+  ebmc_propertiest &properties;
+  const namespacet ns;
+  messaget message;
+
+  ebmc_solvert base_solver_wrapper;
+  decision_proceduret &base_solver;
+
+  // the handles of the properties, by property and timeframe
+  std::vector<exprt::operandst> base_handles;
+
+  // state predicates assumed in the step case
+  exprt::operandst invariants;
+
+  checkpointert *checkpointer;
+
+  // the k up to which the resumed run has checked both cases
+  std::optional<std::size_t> resumed_k() const;
+
+  // Runs in the forked process, and sends "k i" when the step case
+  // holds for property i with k, and "done k" once k is checked.
+  void induction_step(
+    std::optional<std::size_t> resumed,
+    message_handlert &,
+    const forked_workert::sendt &);
+
+  void add_timeframe(
+    decision_proceduret &,
+    std::size_t t,
+    bool initial_state,
+    std::vector<exprt::operandst> &handles);
+
+  static bool is_sat(decision_proceduret::resultt);
+
+  bool is_pending(const ebmc_propertiest::propertyt &property) const
+  {
+    return property.is_unknown() && k_inductiont::supported(property);
+  }
+};
+
+/*******************************************************************\
+
+Function: assumed_state_predicates
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the state predicates p of the supported assumptions AG p
+
+\*******************************************************************/
+
+static exprt::operandst
+assumed_state_predicates(const ebmc_propertiest &properties)
+{
+  exprt::operandst result;
+
+  for(auto &property : properties.properties)
+  {
+    if(property.is_assumed() && k_inductiont::supported(property))
+      result.push_back(to_unary_expr(property.normalized_expr).op());
+  }
+
+  return result;
+}
+
 /*******************************************************************\
 
 Function: k_induction
@@ -97,6 +249,9 @@ Function: k_induction
 
 property_checker_resultt k_induction(
   std::size_t k,
+  bool simple_path,
+  bool auxiliary_invariants,
+  const exprt::operandst &invariants,
   const transition_systemt &transition_system,
   const ebmc_propertiest &properties,
   const ebmc_solver_factoryt &solver_factory,
@@ -122,7 +277,14 @@ property_checker_resultt k_induction(
   }
 
   k_inductiont(
-    k, transition_system, properties_copy, solver_factory, message_handler)();
+    k,
+    simple_path,
+    auxiliary_invariants,
+    invariants,
+    transition_system,
+    properties_copy,
+    solver_factory,
+    message_handler)();
 
   return property_checker_resultt{properties_copy};
 }
@@ -167,13 +329,175 @@ property_checker_resultt k_induction(
   }
 
   auto solver_factory = ebmc_solver_factory(cmdline);
+  const bool simple_path = cmdline.isset("simple-path");
+  const bool auxiliary_invariants = cmdline.isset("aux-invariants");
+
+  // the states reached by a BDD-based reachability analysis over
+  // the latches in the cone of influence are assumed in the step case
+  exprt::operandst invariants;
+
+  if(auto max_latches = bdd_invariant_latches(cmdline))
+  {
+    symbol_tablet symbol_table = transition_system.symbol_table;
+    netlistt netlist;
+
+    convert_trans_to_netlist(
+      symbol_table,
+      transition_system.main_symbol->name,
+      transition_system.trans_expr,
+      properties.make_property_map(),
+      netlist,
+      message_handler);
+
+    auto predicate =
+      bdd_invariant_predicate(netlist, *max_latches, message_handler);
+
+    if(predicate.has_value())
+      invariants.push_back(std::move(*predicate));
+  }
+
+  if(cmdline.isset("max-bound"))
+  {
+    const std::size_t max_k =
+      unsafe_string2size_t(cmdline.get_value("max-bound"));
+
+    std::optional<checkpointert> checkpointer;
+
+    if(has_checkpoint_options(cmdline))
+    {
+      // the design is identified by the hash of its netlist
+      symbol_tablet symbol_table = transition_system.symbol_table;
+      netlistt netlist;
+
+      convert_trans_to_netlist(
+        symbol_table,
+        transition_system.main_symbol->name,
+        transition_system.trans_expr,
+        properties.make_property_map(),
+        netlist,
+        message_handler);
+
+      checkpointer.emplace(
+        cmdline, "k-induction", netlist_hash(netlist), message_handler);
+    }
+
+    return incremental_k_induction(
+      max_k,
+      simple_path,
+      auxiliary_invariants,
+      invariants,
+      transition_system,
+      properties,
+      solver_factory,
+      message_handler,
+      checkpointer.has_value() ? &*checkpointer : nullptr);
+  }
 
   return k_induction(
-    k, transition_system, properties, solver_factory, message_handler);
+    k,
+    simple_path,
+    auxiliary_invariants,
+    invariants,
+    transition_system,
+    properties,
+    solver_factory,
+    message_handler);
 }
 
 /*******************************************************************\
 
+Function: incremental_k_induction
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+property_checker_resultt incremental_k_induction(
+  std::size_t max_k,
+  bool simple_path,
+  bool auxiliary_invariants,
+  const exprt::operandst &invariants,
+  const transition_systemt &transition_system,
+  const ebmc_propertiest &properties,
+  const ebmc_solver_factoryt &solver_factory,
+  message_handlert &message_handler,
+  checkpointert *checkpointer)
+{
+  // copy
+  auto properties_copy = properties;
+
+  if(checkpointer != nullptr)
+    checkpointer->restore_results(properties_copy);
+
+  if(!k_inductiont::have_supported_property(properties.properties))
+  {
+    for(auto &property : properties_copy.properties)
+    {
+      if(
+        !property.is_assumed() && !property.is_disabled() &&
+        !property.is_proved())
+      {
+        property.unsupported("unsupported by k-induction");
+      }
+    }
+    return property_checker_resultt{properties_copy};
+  }
+
+  incremental_k_inductiont(
+    max_k,
+    simple_path,
+    auxiliary_invariants,
+    invariants,
+    transition_system,
+    properties_copy,
+    solver_factory,
+    message_handler,
+    checkpointer)();
+
+  return property_checker_resultt{properties_copy};
+}
+
+/*******************************************************************\
+
+   Class: buffered_message_handlert
+
+ Purpose: Keeps the messages, to be passed on later
+
+\*******************************************************************/
+
+class buffered_message_handlert : public message_handlert
+{
+public:
+  void print(unsigned level, const std::string &message) override
+  {
+    message_handlert::print(level, message);
+
+    if(verbosity >= level)
+      messages.emplace_back(level, message);
+  }
+
+  void flush(unsigned) override
+  {
+  }
+
+  void pass_on(message_handlert &dest)
+  {
+    for(const auto &[level, message] : messages)
+      dest.print(level, message);
+
+    messages.clear();
+  }
+
+protected:
+  std::vector<std::pair<unsigned, std::string>> messages;
+};
+
+/*******************************************************************\
+
 Function: k_inductiont::operator()
 
   Inputs:
@@ -211,11 +535,68 @@ void k_inductiont::operator()()
     }
   }
 
+  // The step case does not depend on the outcome of the base case,
+  // and is done concurrently, in a forked process.
+  forked_workert step_worker(
+    [this](
+      message_handlert &step_message_handler,
+      const forked_workert::sendt &send)
+    {
+      // The parent reads the pipe once the base case is done. Until
+      // then, the messages are kept here, as the step case would block
+      // once the pipe is full.
+      buffered_message_handlert buffer;
+      buffer.set_verbosity(step_message_handler.get_verbosity());
+
+      std::vector<tvt> results;
+
+      try
+      {
+        if(auxiliary_invariants)
+        {
+          auto mined = ::auxiliary_invariants(
+            transition_system,
+            assumed_state_predicates(properties),
+            solver_factory,
+            buffer);
+          invariants.insert(invariants.end(), mined.begin(), mined.end());
+        }
+
+        results = induction_step(buffer);
+      }
+      catch(...)
+      {
+        buffer.pass_on(step_message_handler);
+        throw;
+      }
+
+      buffer.pass_on(step_message_handler);
+
+      for(auto &result : results)
+        send(result.is_true() ? "1" : result.is_false() ? "0" : "?");
+    },
+    message.get_message_handler());
+
   // do induction base
   induction_base();
 
-  // do induction step
-  induction_step();
+  // The properties refuted by the base case do not need the step case.
+  bool step_needed = false;
+  for(auto &property : properties.properties)
+    if(needs_step(property))
+      step_needed = true;
+
+  if(step_needed)
+  {
+    std::vector<tvt> step_results;
+    for(auto &line : step_worker.wait())
+      step_results.push_back(
+        line == "1" ? tvt(true) : line == "0" ? tvt(false) : tvt::unknown());
+
+    apply_step(step_results);
+  }
+  else
+    step_worker.cancel();
 
   // Any refuted properties are really inconclusive if there are
   // unsupported assumptions, as the assumption might have
@@ -260,6 +641,91 @@ void k_inductiont::induction_base()
 
 /*******************************************************************\
 
+Function: solve_simple_path
+
+  Inputs: the handles of the state variables, by timeframe
+
+ Outputs:
+
+ Purpose: Solve, but only admit models whose states are pairwise
+          distinct. When a model repeats a state, require that pair
+          of states to differ, and solve again. The constraints
+          remain in the solver.
+
+\*******************************************************************/
+
+static decision_proceduret::resultt solve_simple_path(
+  decision_proceduret &solver,
+  const exprt &assumption,
+  const std::vector<exprt::operandst> &states,
+  std::size_t &number_of_constraints)
+{
+  while(true)
+  {
+    auto dec_result = solver(assumption);
+
+    if(dec_result != decision_proceduret::resultt::D_SATISFIABLE)
+      return dec_result;
+
+    // the first timeframe with each state
+    std::map<exprt::operandst, std::size_t> timeframes;
+    bool repeated = false;
+
+    for(std::size_t t = 0; t < states.size() && !repeated; t++)
+    {
+      exprt::operandst values;
+      values.reserve(states[t].size());
+      for(auto &handle : states[t])
+        values.push_back(solver.get(handle));
+
+      auto insert_result = timeframes.emplace(std::move(values), t);
+
+      if(!insert_result.second)
+      {
+        const auto &first = states[insert_result.first->second];
+        exprt::operandst equalities;
+        equalities.reserve(first.size());
+        for(std::size_t i = 0; i < first.size(); i++)
+          equalities.push_back(equal_exprt{first[i], states[t][i]});
+        solver.set_to_false(conjunction(equalities));
+        number_of_constraints++;
+        repeated = true;
+      }
+    }
+
+    if(!repeated)
+      return dec_result;
+  }
+}
+
+/*******************************************************************\
+
+Function: state_handles
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the handles of the state variables in the given timeframe
+
+\*******************************************************************/
+
+static exprt::operandst state_handles(
+  const transition_systemt &transition_system,
+  decision_proceduret &solver,
+  std::size_t t,
+  std::size_t no_timeframes)
+{
+  exprt::operandst result;
+
+  for(auto &var : transition_system.state_variables())
+    result.push_back(solver.handle(instantiate(var, t, no_timeframes)));
+
+  return result;
+}
+
+/*******************************************************************\
+
 Function: k_inductiont::induction_step
 
   Inputs:
@@ -270,38 +736,34 @@ Function: k_inductiont::induction_step
 
 \*******************************************************************/
 
-void k_inductiont::induction_step()
+std::vector<tvt>
+k_inductiont::induction_step(message_handlert &step_message_handler)
 {
-  message.status() << "Induction Step" << messaget::eom;
+  messaget step_message(step_message_handler);
+  step_message.status() << "Induction Step" << messaget::eom;
 
   const std::size_t no_timeframes = k + 1;
   const namespacet ns(transition_system.symbol_table);
 
-  for(auto &p_it : properties.properties)
+  std::vector<tvt> results(properties.properties.size(), tvt::unknown());
+
+  for(std::size_t i = 0; i < properties.properties.size(); i++)
   {
-    if(
-      p_it.is_disabled() || p_it.is_failure() || p_it.is_assumed() ||
-      p_it.is_unsupported() || p_it.is_proved())
-    {
+    auto &p_it = properties.properties[i];
+
+    if(!needs_step(p_it))
       continue;
-    }
 
     // If it's not failed, then it's supported.
     DATA_INVARIANT(supported(p_it), "property must be supported");
 
-    // Do not run the step case for properties that have
-    // failed the base case already. Properties may pass the step
-    // case, but are still false when the base case fails.
-    if(p_it.is_refuted())
-      continue;
-
-    auto solver_wrapper = solver_factory(ns, message.get_message_handler());
+    auto solver_wrapper = solver_factory(ns, step_message_handler);
     auto &solver = solver_wrapper.decision_procedure();
 
     // *no* initial state
     unwind(
       transition_system.trans_expr,
-      message.get_message_handler(),
+      step_message_handler,
       solver,
       no_timeframes,
       ns,
@@ -319,6 +781,11 @@ void k_inductiont::induction_step()
         }
       }
 
+    // add the auxiliary invariants for all time frames
+    for(auto &invariant : invariants)
+      for(std::size_t c = 0; c < no_timeframes; c++)
+        solver.set_to_true(instantiate(invariant, c, no_timeframes));
+
     const exprt property(p_it.normalized_expr);
     const exprt &p = to_unary_expr(property).op();
 
@@ -335,35 +802,530 @@ void k_inductiont::induction_step()
       solver.set_to_false(tmp);
     }
 
-    decision_proceduret::resultt dec_result = solver();
+    decision_proceduret::resultt dec_result;
+
+    if(simple_path)
+    {
+      std::vector<exprt::operandst> states;
+      for(std::size_t t = 0; t < no_timeframes; t++)
+        states.push_back(
+          state_handles(transition_system, solver, t, no_timeframes));
+
+      std::size_t number_of_constraints = 0;
+      dec_result =
+        solve_simple_path(solver, true_exprt{}, states, number_of_constraints);
+
+      step_message.statistics() << "Simple-path constraints: "
+                                << number_of_constraints << messaget::eom;
+    }
+    else
+      dec_result = solver();
 
     switch(dec_result)
     {
     case decision_proceduret::resultt::D_SATISFIABLE:
+      results[i] = tvt(false);
+      break;
+
+    case decision_proceduret::resultt::D_UNSATISFIABLE:
+      results[i] = tvt(true);
+      break;
+
+    case decision_proceduret::resultt::D_ERROR:
+      throw ebmc_errort() << "Error from decision procedure";
+
+    default:
+      throw ebmc_errort() << "Unexpected result from decision procedure";
+    }
+  }
+
+  return results;
+}
+
+/*******************************************************************\
+
+Function: k_inductiont::apply_step
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: Combine the outcome of the step case with the outcome of
+          the base case. Do not use the step case for properties that
+          have failed the base case already. Properties may pass the
+          step case, but are still false when the base case fails.
+
+\*******************************************************************/
+
+void k_inductiont::apply_step(const std::vector<tvt> &results)
+{
+  for(std::size_t i = 0; i < properties.properties.size(); i++)
+  {
+    auto &p_it = properties.properties[i];
+
+    if(i >= results.size() || results[i].is_unknown() || !needs_step(p_it))
+      continue;
+
+    if(results[i].is_false())
+    {
       message.result()
         << "SAT: inductive proof failed, k-induction is inconclusive"
         << messaget::eom;
       p_it.inconclusive();
-      break;
-
-    case decision_proceduret::resultt::D_UNSATISFIABLE:
+    }
+    else
+    {
       message.result() << "UNSAT: inductive proof successful, property holds"
+                        << messaget::eom;
+
+      auto engine = std::to_string(k) + "-induction";
+
+      if(p_it.is_exists_path())
+        p_it.refuted(engine);
+      else
+        p_it.proved(engine);
+    }
+  }
+}
+
+/*******************************************************************\
+
+Function: incremental_k_inductiont::add_timeframe
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: add timeframe t, and the transition to timeframe t+1
+
+\*******************************************************************/
+
+void incremental_k_inductiont::add_timeframe(
+  decision_proceduret &solver,
+  std::size_t t,
+  bool initial_state,
+  std::vector<exprt::operandst> &handles)
+{
+  const auto &trans_expr = transition_system.trans_expr;
+
+  if(t == 0 && initial_state && !trans_expr.init().is_true())
+    solver.set_to_true(instantiate(trans_expr.init(), 0, no_timeframes));
+
+  if(!trans_expr.invar().is_true())
+    solver.set_to_true(instantiate(trans_expr.invar(), t, no_timeframes));
+
+  // As with unwind(), the last state has a successor.
+  if(!trans_expr.trans().is_true())
+    solver.set_to_true(instantiate(trans_expr.trans(), t, no_timeframes));
+
+  if(!initial_state)
+  {
+    for(auto &invariant : invariants)
+      solver.set_to_true(instantiate(invariant, t, no_timeframes));
+  }
+
+  handles.resize(properties.properties.size());
+
+  for(std::size_t i = 0; i < properties.properties.size(); i++)
+  {
+    auto &property = properties.properties[i];
+
+    if(!k_inductiont::supported(property) || property.is_disabled())
+      continue;
+
+    auto p = instantiate(
+      to_unary_expr(property.normalized_expr).op(), t, no_timeframes);
+
+    if(property.is_assumed())
+      solver.set_to_true(p);
+    else
+      handles[i].push_back(solver.handle(p));
+  }
+}
+
+/*******************************************************************\
+
+Function: incremental_k_inductiont::resumed_k
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::optional<std::size_t> incremental_k_inductiont::resumed_k() const
+{
+  if(checkpointer == nullptr)
+    return {};
+
+  for(const auto &line : checkpointer->resumed_state())
+  {
+    if(line.rfind("k ", 0) == 0)
+    {
+      auto k = string2optional_size_t(line.substr(2));
+      if(!k.has_value())
+        throw ebmc_errort() << "malformed k-induction checkpoint";
+      return k;
+    }
+  }
+
+  return {};
+}
+
+/*******************************************************************\
+
+Function: incremental_k_inductiont::is_sat
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+bool incremental_k_inductiont::is_sat(decision_proceduret::resultt dec_result)
+{
+  switch(dec_result)
+  {
+  case decision_proceduret::resultt::D_SATISFIABLE:
+    return true;
+
+  case decision_proceduret::resultt::D_UNSATISFIABLE:
+    return false;
+
+  case decision_proceduret::resultt::D_ERROR:
+    throw ebmc_errort() << "Error from decision procedure";
+  }
+
+  UNREACHABLE;
+}
+
+/*******************************************************************\
+
+Function: incremental_k_inductiont::induction_step
+
+  Inputs: the k up to which the resumed run has checked both cases
+
+ Outputs:
+
+ Purpose: Step case: the property holds in timeframes 0, ..., k-1,
+          but not in timeframe k.
+
+\*******************************************************************/
+
+void incremental_k_inductiont::induction_step(
+  std::optional<std::size_t> resumed,
+  message_handlert &step_message_handler,
+  const forked_workert::sendt &send)
+{
+  auto solver_wrapper = solver_factory(ns, step_message_handler);
+  auto &solver = solver_wrapper.decision_procedure();
+
+  // the handles of the properties, by property and timeframe
+  std::vector<exprt::operandst> handles;
+
+  // the handles of the state variables, by timeframe
+  std::vector<exprt::operandst> states;
+  std::size_t simple_path_constraints = 0;
+
+  std::vector<bool> holds(properties.properties.size(), false);
+
+  for(std::size_t k = 0; k <= max_k; k++)
+  {
+    cancellation_point();
+
+    add_timeframe(solver, k, false, handles);
+
+    if(simple_path)
+    {
+      states.push_back(
+        state_handles(transition_system, solver, k, no_timeframes));
+    }
+
+    // The resumed run has found no step case that holds up to k.
+    if(k == 0 || (resumed.has_value() && k <= *resumed))
+      continue;
+
+    for(std::size_t i = 0; i < properties.properties.size(); i++)
+    {
+      if(!is_pending(properties.properties[i]) || holds[i])
+        continue;
+
+      exprt::operandst assumption(handles[i].begin(), handles[i].begin() + k);
+      assumption.push_back(not_exprt{handles[i][k]});
+
+      auto assumption_expr = conjunction(assumption);
+
+      auto dec_result =
+        simple_path
+          ? solve_simple_path(
+              solver, assumption_expr, states, simple_path_constraints)
+          : solver(assumption_expr);
+
+      if(!is_sat(dec_result))
+      {
+        holds[i] = true;
+        send(std::to_string(k) + " " + std::to_string(i));
+      }
+    }
+
+    send("done " + std::to_string(k));
+  }
+
+  if(simple_path)
+  {
+    messaget(step_message_handler).statistics()
+      << "Simple-path constraints: " << simple_path_constraints
+      << messaget::eom;
+  }
+}
+
+/*******************************************************************\
+
+Function: incremental_k_inductiont::operator()
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void incremental_k_inductiont::operator()()
+{
+  // check that $past is not present
+  PRECONDITION(!has_past(transition_system, properties));
+
+  bool assumption_unsupported = false;
+
+  for(auto &property : properties.properties)
+  {
+    if(k_inductiont::supported(property) || property.is_disabled())
+      continue;
+
+    if(property.is_assumed())
+    {
+      assumption_unsupported = true;
+      property.unsupported("unsupported by k-induction");
+    }
+    else if(!property.is_proved())
+      property.unsupported("unsupported by k-induction");
+  }
+
+  auto has_pending = [this]()
+  {
+    for(auto &property : properties.properties)
+      if(is_pending(property))
+        return true;
+    return false;
+  };
+
+  if(auxiliary_invariants && has_pending())
+  {
+    auto mined = ::auxiliary_invariants(
+      transition_system,
+      assumed_state_predicates(properties),
+      solver_factory,
+      message.get_message_handler());
+    invariants.insert(invariants.end(), mined.begin(), mined.end());
+  }
+
+  const auto resumed = resumed_k();
+
+  if(resumed.has_value())
+  {
+    message.status() << "Resuming k-induction after k=" << *resumed
+                     << messaget::eom;
+  }
+
+  // The step case does not depend on the outcome of the base case,
+  // and is done concurrently, in a forked process.
+  std::optional<forked_workert> step_worker;
+
+  if(max_k != 0 && has_pending())
+  {
+    step_worker.emplace(
+      [this, &resumed](
+        message_handlert &step_message_handler,
+        const forked_workert::sendt &send)
+      {
+        // The parent reads the pipe only between the iterations of
+        // the base case. The messages are kept here until the end, as
+        // the step case would block once the pipe is full.
+        buffered_message_handlert buffer;
+        buffer.set_verbosity(step_message_handler.get_verbosity());
+
+        try
+        {
+          induction_step(resumed, buffer, send);
+        }
+        catch(...)
+        {
+          buffer.pass_on(step_message_handler);
+          throw;
+        }
+
+        buffer.pass_on(step_message_handler);
+      },
+      message.get_message_handler());
+  }
+
+  // the smallest k with which the step case holds, by property
+  std::vector<std::optional<std::size_t>> step_holds(
+    properties.properties.size());
+
+  // the k up to which the step case has been checked
+  std::optional<std::size_t> step_done;
+
+  auto receive =
+    [&step_holds, &step_done](const std::vector<std::string> &lines)
+  {
+    for(const auto &line : lines)
+    {
+      if(line.rfind("done ", 0) == 0)
+        step_done = unsafe_string2size_t(line.substr(5));
+      else
+      {
+        const auto space = line.find(' ');
+        const auto i = unsafe_string2size_t(line.substr(space + 1));
+        step_holds[i] = unsafe_string2size_t(line.substr(0, space));
+      }
+    }
+  };
+
+  // the step cases that hold with k up to the given one, for which the
+  // base case is done
+  auto apply_step = [this, &step_holds](std::size_t base_k)
+  {
+    for(std::size_t i = 0; i < properties.properties.size(); i++)
+    {
+      auto &property = properties.properties[i];
+      const auto &k = step_holds[i];
+
+      if(!is_pending(property) || !k.has_value() || *k > base_k)
+        continue;
+
+      message.result() << "UNSAT: inductive proof successful with k=" << *k
                        << messaget::eom;
+
+      auto engine = std::to_string(*k) + "-induction";
+
+      if(property.is_exists_path())
+        property.refuted(engine);
+      else
+        property.proved(engine);
+    }
+  };
+
+  for(std::size_t k = 0; k <= max_k && has_pending(); k++)
+  {
+    cancellation_point();
+
+    message.status() << "k-induction with k=" << k << messaget::eom;
+
+    add_timeframe(base_solver, k, true, base_handles);
+
+    // The resumed run has found the base case to hold for the pending
+    // properties, and has found no step case that holds.
+    if(resumed.has_value() && k <= *resumed)
+    {
+      for(std::size_t i = 0; i < properties.properties.size(); i++)
       {
-        auto engine = std::to_string(no_timeframes - 1) + "-induction";
+        if(is_pending(properties.properties[i]))
+          base_solver.set_to_true(base_handles[i][k]);
+      }
+
+      continue;
+    }
+
+    // Base case: the timeframes up to k-1 have been checked already.
+    for(std::size_t i = 0; i < properties.properties.size(); i++)
+    {
+      auto &property = properties.properties[i];
+      if(!is_pending(property))
+        continue;
+
+      auto &handles = base_handles[i];
 
-        if(p_it.is_exists_path())
-          p_it.refuted(engine);
+      if(is_sat(base_solver(not_exprt{handles[k]})))
+      {
+        message.result() << "SAT: counterexample found" << messaget::eom;
+
+        if(property.is_exists_path())
+          property.proved();
         else
-          p_it.proved(engine);
+          property.refuted();
+
+        property.witness_trace = compute_trans_trace(
+          handles,
+          base_solver,
+          k + 1,
+          ns,
+          transition_system.main_symbol->name);
       }
-      break;
+      else
+      {
+        // The property holds in all states reachable in k steps,
+        // which strengthens the later iterations.
+        base_solver.set_to_true(handles[k]);
+      }
+    }
 
-    case decision_proceduret::resultt::D_ERROR:
-      throw ebmc_errort() << "Error from decision procedure";
+    // Step case: whatever the forked process has found so far
+    if(step_worker.has_value())
+      receive(step_worker->poll());
 
-    default:
-      throw ebmc_errort() << "Unexpected result from decision procedure";
+    apply_step(k);
+
+    if(
+      checkpointer != nullptr && step_done.has_value() &&
+      checkpointer->is_due())
+    {
+      checkpointer->save(
+        properties, {"k " + std::to_string(std::min(k, *step_done))});
+    }
+  }
+
+  if(step_worker.has_value())
+  {
+    // The base case is done up to max_k for the pending properties.
+    if(has_pending())
+    {
+      receive(step_worker->wait());
+      apply_step(max_k);
+    }
+    else
+      step_worker->cancel();
+  }
+
+  // a later run with a larger max_k resumes from here
+  if(
+    checkpointer != nullptr && step_done.has_value() &&
+    checkpointer->is_due())
+  {
+    checkpointer->save(
+      properties, {"k " + std::to_string(std::min(max_k, *step_done))});
+  }
+
+  for(auto &property : properties.properties)
+  {
+    if(is_pending(property))
+      property.inconclusive();
+  }
+
+  // Any refuted properties are really inconclusive if there are
+  // unsupported assumptions, as the assumption might have
+  // proven the property.
+  if(assumption_unsupported)
+  {
+    for(auto &property : properties.properties)
+    {
+      if(property.is_refuted())
+        property.inconclusive();
     }
   }
 }
@@ -10,11 +10,13 @@ Author: Daniel Kroening, kroening@kroening.com
 #define CPROVER_EBMC_K_INDUCTION_H
 
 #include <util/cmdline.h>
+#include <util/expr.h>
 #include <util/message.h>
 
 #include "ebmc_solver_factory.h"
 #include "property_checker.h"
 
+class checkpointert;
 class transition_systemt;
 class ebmc_propertiest;
 
@@ -25,11 +27,36 @@ class ebmc_propertiest;
   message_handlert &);
 
 // Basic k-induction, for given k and given solver.
+// With simple_path, the step case is restricted to paths with
+// pairwise distinct states; the constraints are added lazily.
+// With auxiliary_invariants, the step case assumes invariants mined
+// by simulation and a Houdini pass. The given invariants are state
+// predicates that are assumed in the step case as well.
 [[nodiscard]] property_checker_resultt k_induction(
   std::size_t k,
+  bool simple_path,
+  bool auxiliary_invariants,
+  const exprt::operandst &invariants,
   const transition_systemt &,
   const ebmc_propertiest &,
   const ebmc_solver_factoryt &,
   message_handlert &);
 
+// Incremental k-induction for k=0, ..., max_k, with given solver.
+// The step case runs concurrently with the base case, in a forked
+// process.
+// With a checkpointer, the reached k is written to checkpoints, and
+// the base and step cases up to the k of the resumed checkpoint are
+// not checked again.
+[[nodiscard]] property_checker_resultt incremental_k_induction(
+  std::size_t max_k,
+  bool simple_path,
+  bool auxiliary_invariants,
+  const exprt::operandst &invariants,
+  const transition_systemt &,
+  const ebmc_propertiest &,
+  const ebmc_solver_factoryt &,
+  message_handlert &,
+  checkpointert *checkpointer = nullptr);
+
 #endif
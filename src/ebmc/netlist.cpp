@@ -12,16 +12,29 @@ Author: Daniel Kroening, dkr@amazon.com
 #include <trans-netlist/trans_to_netlist.h>
 #include <trans-netlist/trans_to_netlist_simple.h>
 
+#include "bdd_invariants.h"
 #include "instrument_past.h"
 
-netlistt make_netlist(
-  transition_systemt &transition_system,
-  ebmc_propertiest &properties,
+netlist_cachet *netlist_cachet::active_cache = nullptr;
+
+/*******************************************************************\
+
+Function: convert_to_netlist
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static netlistt convert_to_netlist(
+  const transition_systemt &transition_system,
+  const ebmc_propertiest &properties,
   const cmdlinet &cmdline,
   message_handlert &message_handler)
 {
-  instrument_past(transition_system, properties);
-
   netlistt netlist;
 
   if(cmdline.isset("simple-netlist"))
@@ -48,5 +61,146 @@ netlistt make_netlist(
   // check that the AIG is in dependency order
   netlist.check_ordering();
 
+  auto max_latches = bdd_invariant_latches(cmdline);
+
+  if(max_latches.has_value())
+    add_bdd_invariants(netlist, *max_latches, message_handler);
+
   return netlist;
 }
+
+/*******************************************************************\
+
+Function: make_netlist
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+netlistt make_netlist(
+  transition_systemt &transition_system,
+  ebmc_propertiest &properties,
+  const cmdlinet &cmdline,
+  message_handlert &message_handler)
+{
+  instrument_past(transition_system, properties);
+
+  if(netlist_cachet::active() != nullptr)
+  {
+    auto netlist = netlist_cachet::active()->lookup(
+      transition_system, properties, cmdline, message_handler);
+
+    if(netlist.has_value())
+      return std::move(*netlist);
+  }
+
+  return convert_to_netlist(
+    transition_system, properties, cmdline, message_handler);
+}
+
+/*******************************************************************\
+
+Function: netlist_cachet::netlist_cachet
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+netlist_cachet::netlist_cachet(
+  const transition_systemt &_transition_system,
+  const ebmc_propertiest &_properties)
+  : transition_system(_transition_system),
+    properties(_properties),
+    previous(active_cache)
+{
+  active_cache = this;
+}
+
+/*******************************************************************\
+
+Function: netlist_cachet::~netlist_cachet
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+netlist_cachet::~netlist_cachet()
+{
+  active_cache = previous;
+}
+
+/*******************************************************************\
+
+Function: netlist_cachet::lookup
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: The netlist is made with the options given on first use;
+          these must not change while the cache is in scope.
+
+\*******************************************************************/
+
+std::optional<netlistt> netlist_cachet::lookup(
+  const transition_systemt &instrumented_transition_system,
+  const ebmc_propertiest &instrumented_properties,
+  const cmdlinet &cmdline,
+  message_handlert &message_handler)
+{
+  if(netlist == nullptr)
+  {
+    // convert for all the properties of the cache
+    transition_systemt cache_transition_system = transition_system;
+    cache_transition_system.main_symbol =
+      &cache_transition_system.symbol_table.lookup_ref(
+        transition_system.main_symbol->name);
+
+    ebmc_propertiest cache_properties = properties;
+    instrument_past(cache_transition_system, cache_properties);
+
+    netlist = std::make_unique<netlistt>(convert_to_netlist(
+      cache_transition_system, cache_properties, cmdline, message_handler));
+
+    trans_expr = cache_transition_system.trans_expr;
+    property_map = cache_properties.make_property_map();
+  }
+
+  // e.g., an engine has changed the transition system or a property
+  if(instrumented_transition_system.trans_expr != trans_expr)
+    return {};
+
+  const auto requested = instrumented_properties.make_property_map();
+
+  for(const auto &[identifier, expr] : requested)
+  {
+    auto cached = property_map.find(identifier);
+    if(cached == property_map.end() || cached->second != expr)
+      return {};
+  }
+
+  netlistt result = *netlist;
+
+  // drop the properties that are not asked for
+  for(auto it = result.properties.begin(); it != result.properties.end();)
+  {
+    if(requested.count(it->first) == 0)
+      it = result.properties.erase(it);
+    else
+      it++;
+  }
+
+  return result;
+}
@@ -12,12 +12,59 @@ Author: Daniel Kroening, dkr@amazon.com
 #include "ebmc_properties.h"
 #include "transition_system.h"
 
+#include <map>
+#include <memory>
+#include <optional>
+
 class netlistt;
 
+/// Instruments $past, and converts the transition system and the
+/// enabled properties into a netlist. Takes the netlist from the
+/// netlist cache in scope, if any.
 netlistt make_netlist(
   transition_systemt &,
   ebmc_propertiest &,
   const cmdlinet &,
   message_handlert &);
 
+/// While in scope, make_netlist converts the transition system once
+/// for all the given properties, and then takes the netlist for any
+/// subset of them from the cache, e.g., for the requests to the
+/// server. Caches nest; the innermost one is used.
+class netlist_cachet
+{
+public:
+  netlist_cachet(const transition_systemt &, const ebmc_propertiest &);
+  ~netlist_cachet();
+
+  netlist_cachet(const netlist_cachet &) = delete;
+  netlist_cachet &operator=(const netlist_cachet &) = delete;
+
+  /// the netlist for the enabled properties, if these and the
+  /// instrumented transition system match those of the cache
+  std::optional<netlistt> lookup(
+    const transition_systemt &,
+    const ebmc_propertiest &,
+    const cmdlinet &,
+    message_handlert &);
+
+  /// the innermost cache in scope, if any
+  static netlist_cachet *active()
+  {
+    return active_cache;
+  }
+
+protected:
+  const transition_systemt &transition_system;
+  const ebmc_propertiest &properties;
+  netlist_cachet *const previous;
+
+  // made on first use
+  std::unique_ptr<netlistt> netlist;
+  exprt trans_expr;
+  std::map<irep_idt, exprt> property_map;
+
+  static netlist_cachet *active_cache;
+};
+
 #endif // CPROVER_EBMC_NETLIST_H
@@ -0,0 +1,299 @@
+/*******************************************************************\
+
+Module: Parallel Property Checking
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+#include "parallel_property_checker.h"
+
+#include <util/string2int.h>
+
+#include "ebmc_error.h"
+#include "forked_worker.h"
+#include "property_clusters.h"
+#include "property_results.h"
+#include "result_stream.h"
+
+#include <algorithm>
+#include <list>
+#include <memory>
+#include <set>
+
+/*******************************************************************\
+
+   Class: parallel_property_checkert
+
+ Purpose: Hands out the jobs, i.e., sets of properties, to the forked
+          workers, and collects the results
+
+\*******************************************************************/
+
+class parallel_property_checkert
+{
+public:
+  parallel_property_checkert(
+    const cmdlinet &_cmdline,
+    transition_systemt &_transition_system,
+    ebmc_propertiest &_properties,
+    message_handlert &_message_handler)
+    : cmdline(_cmdline),
+      transition_system(_transition_system),
+      properties(_properties),
+      message(_message_handler)
+  {
+  }
+
+  using jobt = std::set<irep_idt>;
+
+  void operator()(std::list<jobt> jobs, std::size_t max_workers);
+
+protected:
+  const cmdlinet &cmdline;
+  transition_systemt &transition_system;
+  ebmc_propertiest &properties;
+  messaget message;
+
+  struct runningt
+  {
+    jobt job;
+    std::unique_ptr<forked_workert> worker;
+  };
+
+  std::unique_ptr<forked_workert> start(const jobt &);
+  void collect(const std::string &line);
+  void failed(const jobt &, const std::string &reason);
+};
+
+/*******************************************************************\
+
+Function: parallel_property_checkert::start
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::unique_ptr<forked_workert>
+parallel_property_checkert::start(const jobt &job)
+{
+  return std::make_unique<forked_workert>(
+    [this, job](
+      message_handlert &worker_message_handler,
+      const forked_workert::sendt &send)
+    {
+      // the other properties are not checked by this worker
+      ebmc_propertiest worker_properties = properties;
+
+      for(auto &property : worker_properties.properties)
+      {
+        if(!property.is_assumption() && job.count(property.identifier) == 0)
+          property.disable();
+      }
+
+      // a cluster is checked on its cone of influence
+      auto result = [&]()
+      {
+        if(!cmdline.isset("cluster-properties"))
+        {
+          return property_checker_engine(
+            cmdline,
+            transition_system,
+            worker_properties,
+            worker_message_handler);
+        }
+
+        auto slice =
+          cone_of_influence_slice(transition_system, worker_properties);
+
+        messaget(worker_message_handler).statistics()
+          << "Cone of influence: " << slice.state_variables().size()
+          << " of " << transition_system.state_variables().size()
+          << " state variables" << messaget::eom;
+
+        return property_checker_engine(
+          cmdline, slice, worker_properties, worker_message_handler);
+      }();
+
+      if(
+        result.status !=
+        property_checker_resultt::statust::VERIFICATION_RESULT)
+      {
+        throw ebmc_errort() << "the engine gave no verification result";
+      }
+
+      for(auto &property : result.properties)
+        if(job.count(property.identifier) != 0)
+          send(property_results_to_line(property));
+    },
+    message.get_message_handler());
+}
+
+/*******************************************************************\
+
+Function: parallel_property_checkert::collect
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void parallel_property_checkert::collect(const std::string &line)
+{
+  const auto result = property_results_from_line(line);
+
+  for(auto &property : properties.properties)
+    if(property.identifier == result.identifier)
+      property.copy_results_from(result);
+
+  stream_results(properties);
+}
+
+/*******************************************************************\
+
+Function: parallel_property_checkert::failed
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void parallel_property_checkert::failed(
+  const jobt &job,
+  const std::string &reason)
+{
+  for(auto &property : properties.properties)
+  {
+    if(job.count(property.identifier) != 0 && property.is_unknown())
+      property.failure(reason);
+  }
+}
+
+/*******************************************************************\
+
+Function: parallel_property_checkert::operator()
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void parallel_property_checkert::operator()(
+  std::list<jobt> jobs,
+  std::size_t max_workers)
+{
+  std::list<runningt> running;
+
+  while(!jobs.empty() || !running.empty())
+  {
+    while(running.size() < max_workers && !jobs.empty())
+    {
+      auto worker = start(jobs.front());
+      running.push_back(runningt{std::move(jobs.front()), std::move(worker)});
+      jobs.pop_front();
+    }
+
+    std::vector<forked_workert *> waiting;
+
+    for(auto it = running.begin(); it != running.end();)
+    {
+      try
+      {
+        for(auto &line : it->worker->poll())
+          collect(line);
+      }
+      catch(const ebmc_errort &error)
+      {
+        // the results sent before the error hold
+        for(auto &line : it->worker->poll())
+          collect(line);
+
+        message.warning() << "worker failed: " << error.what()
+                          << messaget::eom;
+        failed(it->job, error.what());
+        it = running.erase(it);
+        continue;
+      }
+
+      if(it->worker->is_running())
+      {
+        waiting.push_back(it->worker.get());
+        it++;
+      }
+      else
+        it = running.erase(it);
+    }
+
+    // start the next job right away when a worker has finished
+    if(!waiting.empty() && (jobs.empty() || waiting.size() == max_workers))
+      forked_workert::wait_for_any(waiting);
+  }
+}
+
+/*******************************************************************\
+
+Function: parallel_property_checker
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+property_checker_resultt parallel_property_checker(
+  const cmdlinet &cmdline,
+  transition_systemt &transition_system,
+  ebmc_propertiest &properties,
+  message_handlert &message_handler)
+{
+  auto max_workers = string2optional_size_t(cmdline.get_value("workers"));
+
+  if(!max_workers.has_value() || *max_workers == 0)
+    throw ebmc_errort() << "failed to parse --workers";
+
+  // these write a single output
+  for(const char *option :
+      {"dimacs", "show-bdds", "show-formula", "smt2", "outfile"})
+  {
+    if(cmdline.isset(option))
+      throw ebmc_errort() << "--workers does not support --" << option;
+  }
+
+  // one job per cluster, or one job per property
+  std::list<parallel_property_checkert::jobt> jobs;
+
+  if(cmdline.isset("cluster-properties"))
+    jobs = property_clusters(transition_system, properties, message_handler);
+  else
+  {
+    for(const auto &property : properties.properties)
+      if(!property.is_assumption() && property.is_unknown())
+        jobs.push_back({property.identifier});
+  }
+
+  messaget message(message_handler);
+  message.status() << "Checking " << jobs.size() << " jobs with "
+                   << std::min(*max_workers, jobs.size()) << " workers"
+                   << messaget::eom;
+
+  parallel_property_checkert{
+    cmdline, transition_system, properties, message_handler}(
+    std::move(jobs), *max_workers);
+
+  return property_checker_resultt{properties};
+}
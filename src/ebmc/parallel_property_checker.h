@@ -0,0 +1,26 @@
+/*******************************************************************\
+
+Module: Parallel Property Checking
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// --workers N: the properties are checked in forked worker processes,
+/// which share the elaborated design with the parent copy-on-write
+
+#ifndef CPROVER_EBMC_PARALLEL_PROPERTY_CHECKER_H
+#define CPROVER_EBMC_PARALLEL_PROPERTY_CHECKER_H
+
+#include "property_checker.h"
+
+/// Runs the engine given on the command line on each property in a
+/// forked worker, with up to --workers workers at a time
+property_checker_resultt parallel_property_checker(
+  const cmdlinet &,
+  transition_systemt &,
+  ebmc_propertiest &,
+  message_handlert &);
+
+#endif // CPROVER_EBMC_PARALLEL_PROPERTY_CHECKER_H
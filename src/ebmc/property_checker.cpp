@@ -18,6 +18,7 @@ Author: Daniel Kroening, dkr@amazon.com
 
 #include "bdd_engine.h"
 #include "bmc.h"
+#include "checkpoint.h"
 #include "dimacs_writer.h"
 #include "ebmc_error.h"
 #include "ebmc_solver_factory.h"
@@ -26,8 +27,16 @@ Author: Daniel Kroening, dkr@amazon.com
 #include "instrument_past.h"
 #include "k_induction.h"
 #include "netlist.h"
+#include "parallel_property_checker.h"
+#include "property_clusters.h"
+#include "property_scheduler.h"
 #include "report_results.h"
+#include "result_cache.h"
+#include "result_stream.h"
+#include "sat_portfolio.h"
+#include "word_level_ic3.h"
 
+#include <algorithm>
 #include <chrono>
 #include <iostream>
 
@@ -353,9 +362,26 @@ property_checker_resultt bit_level_bmc(
       throw ebmc_errort()
         << "Cannot write to outfile without file format option";
 
+    messaget message{message_handler};
+
+    if(cmdline.isset("sat-portfolio"))
+    {
+      sat_portfoliot sat_portfolio{message_handler};
+
+      message.status() << "Using " << sat_portfolio.solver_text()
+                       << messaget::eom;
+
+      return bit_level_bmc(
+        sat_portfolio,
+        false,
+        cmdline,
+        transition_system,
+        properties,
+        message_handler);
+    }
+
     satcheckt satcheck{message_handler};
 
-    messaget message{message_handler};
     message.status() << "Using " << satcheck.solver_text() << messaget::eom;
 
     return bit_level_bmc(
@@ -363,76 +389,147 @@ property_checker_resultt bit_level_bmc(
   }
 }
 
+property_checker_resultt property_checker_engine(
+  const cmdlinet &cmdline,
+  transition_systemt &transition_system,
+  ebmc_propertiest &properties,
+  message_handlert &message_handler)
+{
+  if(cmdline.isset("bdd") || cmdline.isset("show-bdds"))
+  {
+    return bdd_engine(cmdline, transition_system, properties, message_handler);
+  }
+  else if(cmdline.isset("aig") || cmdline.isset("dimacs"))
+  {
+    // bit-level BMC
+    return bit_level_bmc(
+      cmdline, transition_system, properties, message_handler);
+  }
+  else if(cmdline.isset("k-induction"))
+  {
+    return k_induction(cmdline, transition_system, properties, message_handler);
+  }
+  else if(cmdline.isset("ic3"))
+  {
+#ifdef _WIN32
+    throw ebmc_errort() << "No support for IC3 on Windows";
+#else
+    return ic3_engine(cmdline, transition_system, properties, message_handler);
+#endif
+  }
+  else if(cmdline.isset("new-ic3"))
+  {
+#ifdef _WIN32
+    throw ebmc_errort() << "No support for new IC3 on Windows";
+#else
+    return new_ic3_engine(
+      cmdline, transition_system, properties, message_handler);
+#endif
+  }
+  else if(cmdline.isset("word-ic3"))
+  {
+    return word_level_ic3(
+      cmdline, transition_system, properties, message_handler);
+  }
+  else if(cmdline.isset("bound"))
+  {
+    // word-level BMC
+    return word_level_bmc(
+      cmdline, transition_system, properties, message_handler);
+  }
+  else
+  {
+    // heuristic engine selection
+    return engine_heuristic(
+      cmdline, transition_system, properties, message_handler);
+  }
+}
+
 property_checker_resultt property_checker(
   const cmdlinet &cmdline,
   transition_systemt &transition_system,
   ebmc_propertiest &properties,
   message_handlert &message_handler)
 {
+  check_checkpoint_options(cmdline);
+
   bool use_heuristic_engine =
     !cmdline.isset("bdd") && !cmdline.isset("aig") &&
     !cmdline.isset("k-induction") && !cmdline.isset("ic3") &&
-    !cmdline.isset("new-ic3") && !cmdline.isset("bound");
+    !cmdline.isset("new-ic3") && !cmdline.isset("word-ic3") &&
+    !cmdline.isset("bound");
 
-  if(cmdline.isset("k-induction") || use_heuristic_engine)
+  if(
+    cmdline.isset("k-induction") || cmdline.isset("word-ic3") ||
+    use_heuristic_engine)
   {
-    // The step case of k-induction can't do $past
+    // The step case of k-induction and word-level IC3 can't do $past
     instrument_past(transition_system, properties);
   }
 
+  std::optional<result_cachet> result_cache;
+
+  if(cmdline.isset("result-cache"))
+  {
+    result_cache.emplace(cmdline.get_value("result-cache"), message_handler);
+    result_cache->lookup(transition_system, properties);
+  }
+
+  const namespacet ns{transition_system.symbol_table};
+
+  // one line per property, as soon as its result is final
+  std::optional<output_filet> json_stream_file;
+  std::optional<result_streamt> result_stream;
+
+  if(cmdline.isset("json-stream"))
+  {
+    json_stream_file.emplace(cmdline.get_value("json-stream"));
+    result_stream.emplace(json_stream_file->stream(), ns);
+  }
+
   auto result = [&]() -> property_checker_resultt
   {
-    if(cmdline.isset("bdd") || cmdline.isset("show-bdds"))
+    if(
+      result_cache.has_value() &&
+      std::all_of(
+        properties.properties.begin(),
+        properties.properties.end(),
+        [](const ebmc_propertiest::propertyt &property)
+        { return property.is_assumption() || !property.is_unknown(); }))
     {
-      return bdd_engine(
-        cmdline, transition_system, properties, message_handler);
-    }
-    else if(cmdline.isset("aig") || cmdline.isset("dimacs"))
-    {
-      // bit-level BMC
-      return bit_level_bmc(
-        cmdline, transition_system, properties, message_handler);
-    }
-    else if(cmdline.isset("k-induction"))
-    {
-      return k_induction(
-        cmdline, transition_system, properties, message_handler);
+      // all results are from the cache
+      return property_checker_resultt{properties};
     }
-    else if(cmdline.isset("ic3"))
+    else if(cmdline.isset("schedule-properties"))
     {
-#ifdef _WIN32
-      throw ebmc_errort() << "No support for IC3 on Windows";
-#else
-      return ic3_engine(
+      return scheduled_property_checker(
         cmdline, transition_system, properties, message_handler);
-#endif
     }
-    else if(cmdline.isset("new-ic3"))
+    else if(cmdline.isset("workers"))
     {
-#ifdef _WIN32
-      throw ebmc_errort() << "No support for new IC3 on Windows";
-#else
-      return new_ic3_engine(
+      return parallel_property_checker(
         cmdline, transition_system, properties, message_handler);
-#endif
     }
-    else if(cmdline.isset("bound"))
+    else if(cmdline.isset("cluster-properties"))
     {
-      // word-level BMC
-      return word_level_bmc(
+      return clustered_property_checker(
         cmdline, transition_system, properties, message_handler);
     }
     else
     {
-      // heuristic engine selection
-      return engine_heuristic(
+      return property_checker_engine(
         cmdline, transition_system, properties, message_handler);
     }
   }();
 
+  if(result_cache.has_value())
+    result_cache->update(result);
+
   if(result.status == property_checker_resultt::statust::VERIFICATION_RESULT)
   {
-    const namespacet ns{transition_system.symbol_table};
+    if(result_stream.has_value())
+      result_stream->finish(result.properties);
+
     report_results(cmdline, use_heuristic_engine, result, ns, message_handler);
   }
 
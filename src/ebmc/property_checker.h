@@ -85,4 +85,12 @@ property_checker_resultt property_checker(
   ebmc_propertiest &,
   message_handlert &);
 
+/// Runs the engine given on the command line, without reporting
+/// the results
+property_checker_resultt property_checker_engine(
+  const cmdlinet &,
+  transition_systemt &,
+  ebmc_propertiest &,
+  message_handlert &);
+
 #endif
@@ -0,0 +1,402 @@
+/*******************************************************************\
+
+Module: Clustering of Properties by their Cone of Influence
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+#include "property_clusters.h"
+
+#include <util/expr_util.h>
+
+#include <trans-netlist/netlist.h>
+#include <trans-netlist/trans_to_netlist.h>
+#include <trans-word-level/next_symbol.h>
+
+#include "coi_hash.h"
+#include "ebmc_error.h"
+#include "result_stream.h"
+
+#include <array>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+
+/*******************************************************************\
+
+Function: property_clusters
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::list<std::set<irep_idt>> property_clusters(
+  const transition_systemt &transition_system,
+  const ebmc_propertiest &properties,
+  message_handlert &message_handler)
+{
+  netlistt netlist;
+
+  convert_trans_to_netlist(
+    transition_system.symbol_table,
+    transition_system.main_symbol->name,
+    transition_system.trans_expr,
+    properties.make_property_map(),
+    netlist,
+    message_handler);
+
+  auto clusters = cluster_properties(netlist, properties);
+
+  std::size_t number_of_properties = 0;
+
+  for(const auto &cluster : clusters)
+    number_of_properties += cluster.size();
+
+  messaget message(message_handler);
+  message.status() << "Clustered " << number_of_properties
+                   << " properties into " << clusters.size()
+                   << " clusters" << messaget::eom;
+
+  return {
+    std::make_move_iterator(clusters.begin()),
+    std::make_move_iterator(clusters.end())};
+}
+
+/*******************************************************************\
+
+Function: collect_conjuncts
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static void collect_conjuncts(const exprt &expr, exprt::operandst &dest)
+{
+  if(expr.id() == ID_and)
+  {
+    for(const auto &op : expr.operands())
+      collect_conjuncts(op, dest);
+  }
+  else if(!expr.is_true())
+    dest.push_back(expr);
+}
+
+/*******************************************************************\
+
+Function: collect_variables
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the identifiers of the symbols and of the next-state
+          symbols
+
+\*******************************************************************/
+
+static void
+collect_variables(const exprt &expr, std::unordered_set<irep_idt> &dest)
+{
+  expr.visit_pre(
+    [&dest](const exprt &node)
+    {
+      if(node.id() == ID_symbol)
+        dest.insert(to_symbol_expr(node).get_identifier());
+      else if(node.id() == ID_next_symbol)
+        dest.insert(to_next_symbol_expr(node).identifier());
+    });
+}
+
+/*******************************************************************\
+
+Function: cone_of_influence_slice
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+transition_systemt cone_of_influence_slice(
+  const transition_systemt &transition_system,
+  const ebmc_propertiest &properties)
+{
+  // x == ... in the invariant or the transition relation, x == ... in
+  // the initial state, and next(x) == ...
+  enum kindt
+  {
+    ALWAYS = 0,
+    INITIAL = 1,
+    NEXT = 2
+  };
+
+  struct constraintt
+  {
+    exprt expr;
+    // x for x == ... and next(x) == ...
+    std::optional<irep_idt> defined;
+    kindt kind = ALWAYS;
+    std::unordered_set<irep_idt> variables;
+    bool in_cone = false;
+  };
+
+  auto constraints = [](const exprt &expr, bool initial)
+  {
+    exprt::operandst conjuncts;
+    collect_conjuncts(expr, conjuncts);
+
+    std::vector<constraintt> result;
+
+    for(auto &conjunct : conjuncts)
+    {
+      constraintt constraint;
+
+      if(
+        conjunct.id() == ID_equal &&
+        (to_equal_expr(conjunct).lhs().id() == ID_symbol ||
+         to_equal_expr(conjunct).lhs().id() == ID_next_symbol) &&
+        !has_subexpr(
+          to_equal_expr(conjunct).rhs(),
+          [&conjunct](const exprt &node)
+          { return node == to_equal_expr(conjunct).lhs(); }))
+      {
+        const auto &lhs = to_equal_expr(conjunct).lhs();
+        if(lhs.id() == ID_symbol)
+        {
+          constraint.defined = to_symbol_expr(lhs).get_identifier();
+          constraint.kind = initial ? INITIAL : ALWAYS;
+        }
+        else
+        {
+          constraint.defined = to_next_symbol_expr(lhs).identifier();
+          constraint.kind = NEXT;
+        }
+        collect_variables(to_equal_expr(conjunct).rhs(), constraint.variables);
+      }
+      else
+        collect_variables(conjunct, constraint.variables);
+
+      constraint.expr = std::move(conjunct);
+      result.push_back(std::move(constraint));
+    }
+
+    return result;
+  };
+
+  const auto &trans_expr = transition_system.trans_expr;
+  auto invar = constraints(trans_expr.invar(), false);
+  auto init = constraints(trans_expr.init(), true);
+  auto trans = constraints(trans_expr.trans(), false);
+
+  // A definition of x can only be omitted together with x when it is
+  // the only one for x, and when x is not otherwise constrained.
+  // Any other equality is an ordinary constraint.
+  for(bool changed = true; changed;)
+  {
+    changed = false;
+
+    std::unordered_map<irep_idt, std::array<std::size_t, 3>> definitions;
+    std::unordered_set<irep_idt> constrained;
+
+    for(auto *list : {&invar, &init, &trans})
+    {
+      for(const auto &constraint : *list)
+      {
+        if(constraint.defined.has_value())
+          definitions[*constraint.defined][constraint.kind]++;
+        else
+        {
+          constrained.insert(
+            constraint.variables.begin(), constraint.variables.end());
+        }
+      }
+    }
+
+    for(auto *list : {&invar, &init, &trans})
+    {
+      for(auto &constraint : *list)
+      {
+        if(!constraint.defined.has_value())
+          continue;
+
+        const auto &count = definitions[*constraint.defined];
+
+        const bool unique =
+          count[ALWAYS] == 0
+            ? count[INITIAL] <= 1 && count[NEXT] <= 1
+            : count[ALWAYS] == 1 && count[INITIAL] == 0 && count[NEXT] == 0;
+
+        if(!unique || constrained.count(*constraint.defined) != 0)
+        {
+          constraint.defined.reset();
+          collect_variables(constraint.expr, constraint.variables);
+          changed = true;
+        }
+      }
+    }
+  }
+
+  std::unordered_set<irep_idt> cone;
+
+  for(const auto &property : properties.properties)
+  {
+    if(!property.is_disabled())
+      collect_variables(property.normalized_expr, cone);
+  }
+
+  // the definitions of the variables in the cone, and the other
+  // constraints that share a variable with it, until nothing changes
+  for(bool changed = true; changed;)
+  {
+    changed = false;
+
+    for(auto *list : {&invar, &init, &trans})
+    {
+      for(auto &constraint : *list)
+      {
+        if(constraint.in_cone)
+          continue;
+
+        bool relevant;
+
+        if(constraint.defined.has_value())
+          relevant = cone.count(*constraint.defined) != 0;
+        else
+        {
+          relevant = false;
+          for(const auto &variable : constraint.variables)
+            if(cone.count(variable) != 0)
+              relevant = true;
+        }
+
+        if(relevant)
+        {
+          constraint.in_cone = true;
+          cone.insert(constraint.variables.begin(), constraint.variables.end());
+          changed = true;
+        }
+      }
+    }
+  }
+
+  auto conjunction_in_cone = [](const std::vector<constraintt> &list)
+  {
+    exprt::operandst conjuncts;
+    for(const auto &constraint : list)
+      if(constraint.in_cone)
+        conjuncts.push_back(constraint.expr);
+    return conjunction(conjuncts);
+  };
+
+  transition_systemt result = transition_system;
+  result.main_symbol =
+    &result.symbol_table.lookup_ref(transition_system.main_symbol->name);
+
+  result.trans_expr.invar() = conjunction_in_cone(invar);
+  result.trans_expr.init() = conjunction_in_cone(init);
+  result.trans_expr.trans() = conjunction_in_cone(trans);
+
+  for(const auto &variable : transition_system.state_variables())
+  {
+    if(cone.count(variable.get_identifier()) == 0)
+    {
+      result.symbol_table.get_writeable_ref(variable.get_identifier())
+        .is_state_var = false;
+    }
+  }
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: clustered_property_checker
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+property_checker_resultt clustered_property_checker(
+  const cmdlinet &cmdline,
+  transition_systemt &transition_system,
+  ebmc_propertiest &properties,
+  message_handlert &message_handler)
+{
+  // these write a single output
+  for(const char *option :
+      {"dimacs", "show-bdds", "show-formula", "smt2", "outfile"})
+  {
+    if(cmdline.isset(option))
+    {
+      throw ebmc_errort() << "--cluster-properties does not support --"
+                          << option;
+    }
+  }
+
+  const auto clusters =
+    property_clusters(transition_system, properties, message_handler);
+
+  messaget message(message_handler);
+  std::size_t cluster_nr = 0;
+
+  for(const auto &cluster : clusters)
+  {
+    cluster_nr++;
+    message.status() << "Cluster " << cluster_nr << " of "
+                     << clusters.size() << ": " << cluster.size()
+                     << " properties" << messaget::eom;
+
+    ebmc_propertiest selected = properties;
+
+    for(auto &property : selected.properties)
+    {
+      if(!property.is_assumption() && cluster.count(property.identifier) == 0)
+        property.disable();
+    }
+
+    auto slice = cone_of_influence_slice(transition_system, selected);
+
+    message.statistics() << "Cone of influence: "
+                         << slice.state_variables().size() << " of "
+                         << transition_system.state_variables().size()
+                         << " state variables" << messaget::eom;
+
+    auto result =
+      property_checker_engine(cmdline, slice, selected, message_handler);
+
+    if(
+      result.status != property_checker_resultt::statust::VERIFICATION_RESULT)
+    {
+      return result;
+    }
+
+    for(auto &property : properties.properties)
+    {
+      if(cluster.count(property.identifier) == 0)
+        continue;
+
+      for(const auto &checked : result.properties)
+        if(checked.identifier == property.identifier)
+          property.copy_results_from(checked);
+    }
+
+    stream_results(properties);
+  }
+
+  return property_checker_resultt{properties};
+}
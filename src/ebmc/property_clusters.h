@@ -0,0 +1,48 @@
+/*******************************************************************\
+
+Module: Clustering of Properties by their Cone of Influence
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// --cluster-properties: the properties whose cones of influence
+/// overlap are checked together, with one engine run per cluster
+
+#ifndef CPROVER_EBMC_PROPERTY_CLUSTERS_H
+#define CPROVER_EBMC_PROPERTY_CLUSTERS_H
+
+#include "property_checker.h"
+
+#include <list>
+#include <set>
+
+/// The clusters of the properties that are still to be checked,
+/// computed on the netlist of the transition system
+std::list<std::set<irep_idt>> property_clusters(
+  const transition_systemt &,
+  const ebmc_propertiest &,
+  message_handlert &);
+
+/// The transition system restricted to the cone of influence of the
+/// enabled properties and the assumptions. The cone follows the
+/// definitions of the variables, x == ... and next(x) == ..., and
+/// includes any other constraint that shares a variable with it. An
+/// equality is a definition only when it is the only one for x and
+/// x is not otherwise constrained. The state variables outside of the
+/// cone are not state variables of the result.
+transition_systemt cone_of_influence_slice(
+  const transition_systemt &,
+  const ebmc_propertiest &);
+
+/// Runs the engine given on the command line once per cluster, on the
+/// cone of influence of the cluster, with the properties of the other
+/// clusters disabled
+property_checker_resultt clustered_property_checker(
+  const cmdlinet &,
+  transition_systemt &,
+  ebmc_propertiest &,
+  message_handlert &);
+
+#endif // CPROVER_EBMC_PROPERTY_CLUSTERS_H
@@ -0,0 +1,203 @@
+/*******************************************************************\
+
+Module: Property Results as Text
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+#include "property_results.h"
+
+#include <util/irep_serialization.h>
+
+#include "ebmc_error.h"
+
+#include <sstream>
+
+/*******************************************************************\
+
+Function: trace_to_irep
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static irept trace_to_irep(const trans_tracet &trace)
+{
+  irept result{"trace"};
+  result.set("mode", trace.mode);
+
+  for(const auto &state : trace.states)
+  {
+    irept state_irep{"state"};
+    state_irep.set("property_failed", state.property_failed);
+
+    for(const auto &assignment : state.assignments)
+    {
+      irept assignment_irep{"assignment"};
+      assignment_irep.add("lhs") = assignment.lhs;
+      assignment_irep.add("rhs") = assignment.rhs;
+      assignment_irep.add("location") = assignment.location;
+      state_irep.get_sub().push_back(std::move(assignment_irep));
+    }
+
+    result.get_sub().push_back(std::move(state_irep));
+  }
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: trace_from_irep
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static trans_tracet trace_from_irep(const irept &src)
+{
+  trans_tracet result;
+  result.mode = id2string(src.get("mode"));
+
+  for(const auto &state_irep : src.get_sub())
+  {
+    result.states.emplace_back();
+    auto &state = result.states.back();
+    state.property_failed = state_irep.get_bool("property_failed");
+
+    for(const auto &assignment_irep : state_irep.get_sub())
+    {
+      state.assignments.emplace_back(
+        static_cast<const exprt &>(assignment_irep.find("lhs")),
+        static_cast<const exprt &>(assignment_irep.find("rhs")),
+        static_cast<const source_locationt &>(
+          assignment_irep.find("location")));
+    }
+  }
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: property_results_to_line
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: serialize the results, and write the bytes in hexadecimal
+
+\*******************************************************************/
+
+std::string
+property_results_to_line(const ebmc_propertiest::propertyt &property)
+{
+  irept results{"results"};
+  results.set("identifier", property.identifier);
+  results.set("status", static_cast<long long>(property.status));
+  results.set_size_t("bound", property.bound);
+
+  if(property.failure_reason.has_value())
+    results.set("failure_reason", *property.failure_reason);
+
+  if(property.proof_via.has_value())
+    results.set("proof_via", *property.proof_via);
+
+  if(property.witness_trace.has_value())
+    results.add("trace") = trace_to_irep(*property.witness_trace);
+
+  std::ostringstream out;
+  irep_serializationt::ireps_containert ireps_container;
+  irep_serializationt{ireps_container}.reference_convert(results, out);
+
+  static const char digits[] = "0123456789abcdef";
+  std::string line;
+
+  for(unsigned char byte : out.str())
+  {
+    line += digits[byte >> 4];
+    line += digits[byte & 15];
+  }
+
+  return line;
+}
+
+/*******************************************************************\
+
+Function: property_results_from_line
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+ebmc_propertiest::propertyt
+property_results_from_line(const std::string &line)
+{
+  auto digit = [](char ch) -> int
+  {
+    if(ch >= '0' && ch <= '9')
+      return ch - '0';
+    else if(ch >= 'a' && ch <= 'f')
+      return ch - 'a' + 10;
+    else
+      return -1;
+  };
+
+  if(line.size() % 2 != 0)
+    throw ebmc_errort() << "malformed property results";
+
+  std::string bytes;
+
+  for(std::size_t i = 0; i < line.size(); i += 2)
+  {
+    int high = digit(line[i]), low = digit(line[i + 1]);
+    if(high < 0 || low < 0)
+      throw ebmc_errort() << "malformed property results";
+    bytes += static_cast<char>((high << 4) | low);
+  }
+
+  std::istringstream in(bytes);
+  irep_serializationt::ireps_containert ireps_container;
+  const irept results =
+    irep_serializationt{ireps_container}.reference_convert(in);
+
+  if(!in || results.id() != "results")
+    throw ebmc_errort() << "malformed property results";
+
+  using statust = ebmc_propertiest::propertyt::statust;
+
+  const auto status = results.get_long_long("status");
+
+  if(status < 0 || status > static_cast<long long>(statust::INCONCLUSIVE))
+    throw ebmc_errort() << "malformed property results";
+
+  ebmc_propertiest::propertyt property;
+  property.identifier = results.get("identifier");
+  property.status = static_cast<statust>(status);
+  property.bound = results.get_size_t("bound");
+
+  if(results.find("failure_reason").is_not_nil())
+    property.failure_reason = id2string(results.get("failure_reason"));
+
+  if(results.find("proof_via").is_not_nil())
+    property.proof_via = id2string(results.get("proof_via"));
+
+  if(results.find("trace").is_not_nil())
+    property.witness_trace = trace_from_irep(results.find("trace"));
+
+  return property;
+}
@@ -0,0 +1,29 @@
+/*******************************************************************\
+
+Module: Property Results as Text
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// The results of a property as a single line of text, for passing
+/// them between processes
+
+#ifndef CPROVER_EBMC_PROPERTY_RESULTS_H
+#define CPROVER_EBMC_PROPERTY_RESULTS_H
+
+#include "ebmc_properties.h"
+
+#include <string>
+
+/// The identifier and the results of the property, i.e., the status,
+/// the bound, the reasons and the trace, as a line of text
+std::string property_results_to_line(const ebmc_propertiest::propertyt &);
+
+/// A property with the identifier and the results given by a line
+/// written by property_results_to_line. Throws ebmc_errort when the
+/// line is malformed.
+ebmc_propertiest::propertyt property_results_from_line(const std::string &);
+
+#endif // CPROVER_EBMC_PROPERTY_RESULTS_H
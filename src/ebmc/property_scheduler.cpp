@@ -0,0 +1,449 @@
+/*******************************************************************\
+
+Module: Difficulty-Aware Property Scheduling
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+#include "property_scheduler.h"
+
+#include <solvers/prop/literal_expr.h>
+#include <trans-netlist/ldg.h>
+#include <trans-netlist/netlist.h>
+#include <trans-netlist/trans_to_netlist.h>
+
+#include "coi_hash.h"
+#include "ebmc_error.h"
+#include "result_stream.h"
+#include "transition_property.h"
+
+#include <algorithm>
+#include <optional>
+#include <set>
+#include <tuple>
+#include <vector>
+
+/*******************************************************************\
+
+Function: property_metricst::expected_cost
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: a rough estimate of the effort
+
+\*******************************************************************/
+
+std::size_t property_metricst::expected_cost() const
+{
+  return (coi_latches + 1) * (aig_depth + 1) * (largest_scc + 1);
+}
+
+/*******************************************************************\
+
+Function: property_metrics
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::map<irep_idt, property_metricst>
+property_metrics(const netlistt &netlist, const ebmc_propertiest &properties)
+{
+  // The AND nodes come after their operands, and hence, the depth of
+  // all nodes is computed in a single pass.
+  std::vector<std::size_t> depth(netlist.number_of_nodes(), 0);
+
+  auto literal_depth = [&depth](literalt l) -> std::size_t
+  { return l.is_constant() ? 0 : depth[l.var_no()]; };
+
+  for(std::size_t v = 0; v < netlist.nodes.size(); v++)
+  {
+    const auto &node = netlist.nodes[v];
+    if(node.is_and())
+      depth[v] = std::max(literal_depth(node.a), literal_depth(node.b)) + 1;
+  }
+
+  std::map<unsigned, literalt> next_state;
+
+  for(const auto &[identifier, var] : netlist.var_map.map)
+  {
+    if(var.is_latch())
+      for(const auto &bit : var.bits)
+        if(!bit.current.is_constant())
+          next_state.emplace(bit.current.var_no(), bit.next);
+  }
+
+  // The latches that a latch in the cone depends on are in the cone.
+  // Hence, the cycles of the LDG of the netlist that touch the cone
+  // are those of the LDG of the cone.
+  ldgt ldg;
+  ldg.compute(netlist);
+
+  std::vector<ldgt::node_indext> scc_nr;
+  ldg.SCCs(scc_nr);
+
+  std::map<ldgt::node_indext, std::size_t> scc_size;
+  std::set<ldgt::node_indext> cyclic_sccs;
+
+  for(auto v : ldg.latches)
+  {
+    scc_size[scc_nr[v]]++;
+
+    // a latch that depends on itself
+    if(ldg[v].out.find(v) != ldg[v].out.end())
+      cyclic_sccs.insert(scc_nr[v]);
+  }
+
+  for(const auto &[scc, size] : scc_size)
+    if(size > 1)
+      cyclic_sccs.insert(scc);
+
+  std::map<irep_idt, property_metricst> result;
+
+  const auto cones = cone_of_influence_latches(netlist, properties);
+
+  for(const auto &property : properties.properties)
+  {
+    auto cone = cones.find(property.identifier);
+
+    if(cone == cones.end())
+      continue;
+
+    property_metricst metrics;
+
+    metrics.coi_latches = cone->second.size();
+    metrics.transition_property =
+      is_transition_property(property.normalized_expr);
+
+    std::vector<literalt> roots;
+
+    auto collect = [&roots](const exprt &expr, auto &self) -> void
+    {
+      if(expr.id() == ID_literal)
+        roots.push_back(to_literal_expr(expr).get_literal());
+      else
+        for(const auto &op : expr.operands())
+          self(op, self);
+    };
+
+    collect(*netlist.properties.at(property.identifier), collect);
+
+    for(auto l : roots)
+      metrics.aig_depth = std::max(metrics.aig_depth, literal_depth(l));
+
+    for(auto v : cone->second)
+    {
+      if(auto next = next_state.find(v); next != next_state.end())
+      {
+        metrics.aig_depth =
+          std::max(metrics.aig_depth, literal_depth(next->second));
+      }
+
+      if(cyclic_sccs.count(scc_nr[v]) != 0)
+      {
+        metrics.largest_scc =
+          std::max(metrics.largest_scc, scc_size[scc_nr[v]]);
+      }
+    }
+
+    result.emplace(property.identifier, metrics);
+  }
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: scheduled_engine
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: The properties with an acyclic cone are settled by the
+          completeness threshold engine of the heuristic. BDDs are
+          used for small cones, IC3 for medium ones, and BMC for large
+          cones with shallow logic.
+
+\*******************************************************************/
+
+scheduled_enginet scheduled_engine(const property_metricst &metrics)
+{
+  if(metrics.largest_scc == 0)
+    return scheduled_enginet::HEURISTIC;
+  else if(metrics.coi_latches <= 64)
+    return scheduled_enginet::BDD;
+#ifndef _WIN32
+  else if(metrics.coi_latches <= 1024)
+    return scheduled_enginet::IC3;
+#endif
+  else if(metrics.aig_depth <= 64)
+    return scheduled_enginet::BMC;
+  else
+    return scheduled_enginet::HEURISTIC;
+}
+
+/*******************************************************************\
+
+Function: as_string
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::string as_string(scheduled_enginet engine)
+{
+  switch(engine)
+  {
+  case scheduled_enginet::HEURISTIC:
+    return "heuristic";
+  case scheduled_enginet::BDD:
+    return "BDDs";
+  case scheduled_enginet::IC3:
+    return "IC3";
+  case scheduled_enginet::BMC:
+    return "BMC with bound " + std::to_string(scheduled_bmc_bound);
+  }
+
+  UNREACHABLE;
+}
+
+/*******************************************************************\
+
+Function: engine_cmdline
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the command line that selects the engine
+
+\*******************************************************************/
+
+static cmdlinet
+engine_cmdline(const cmdlinet &cmdline, scheduled_enginet engine)
+{
+  cmdlinet result = cmdline;
+
+  switch(engine)
+  {
+  case scheduled_enginet::HEURISTIC:
+    break;
+  case scheduled_enginet::BDD:
+    result.set("bdd");
+    break;
+  case scheduled_enginet::IC3:
+    result.set("new-ic3");
+    break;
+  case scheduled_enginet::BMC:
+    // word-level BMC is the default given a bound
+    result.set("bound", std::to_string(scheduled_bmc_bound));
+    break;
+  }
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: is_settled
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static bool is_settled(const ebmc_propertiest::propertyt &property)
+{
+  // a bounded result is not, and goes to the heuristic
+  return property.is_proved() || property.is_refuted();
+}
+
+/*******************************************************************\
+
+Function: scheduled_property_checker
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+property_checker_resultt scheduled_property_checker(
+  const cmdlinet &cmdline,
+  transition_systemt &transition_system,
+  ebmc_propertiest &properties,
+  message_handlert &message_handler)
+{
+  for(const char *option :
+      {"bdd",
+       "aig",
+       "k-induction",
+       "ic3",
+       "new-ic3",
+       "word-ic3",
+       "bound",
+       "portfolio",
+       "workers",
+       "cluster-properties"})
+  {
+    if(cmdline.isset(option))
+    {
+      throw ebmc_errort() << "--schedule-properties does not support --"
+                          << option;
+    }
+  }
+
+  // these write a single output
+  for(const char *option :
+      {"dimacs", "show-bdds", "show-formula", "smt2", "outfile"})
+  {
+    if(cmdline.isset(option))
+    {
+      throw ebmc_errort() << "--schedule-properties does not support --"
+                          << option;
+    }
+  }
+
+  netlistt netlist;
+
+  convert_trans_to_netlist(
+    transition_system.symbol_table,
+    transition_system.main_symbol->name,
+    transition_system.trans_expr,
+    properties.make_property_map(),
+    netlist,
+    message_handler);
+
+  const auto metrics = property_metrics(netlist, properties);
+
+  // Cheapest first; on a tie, the transition properties go first, as
+  // the heuristic may settle them with a single solver call. The
+  // properties that are not in the netlist go last.
+  using entryt = std::tuple<bool, std::size_t, bool, std::size_t, irep_idt>;
+  std::vector<entryt> schedule;
+
+  for(const auto &property : properties.properties)
+  {
+    if(property.is_assumption() || !property.is_unknown())
+      continue;
+
+    auto m = metrics.find(property.identifier);
+
+    if(m == metrics.end())
+    {
+      schedule.emplace_back(
+        true, 0, false, property.number, property.identifier);
+    }
+    else
+    {
+      schedule.emplace_back(
+        false,
+        m->second.expected_cost(),
+        !m->second.transition_property,
+        property.number,
+        property.identifier);
+    }
+  }
+
+  std::sort(schedule.begin(), schedule.end());
+
+  messaget message(message_handler);
+
+  for(const auto &entry : schedule)
+  {
+    const auto &identifier = std::get<4>(entry);
+    auto m = metrics.find(identifier);
+    auto engine = m == metrics.end() ? scheduled_enginet::HEURISTIC
+                                     : scheduled_engine(m->second);
+
+    auto &status = message.status();
+    status << "Scheduling " << identifier;
+
+    if(m != metrics.end())
+    {
+      status << " (" << m->second.coi_latches << " latches, AIG depth "
+             << m->second.aig_depth << ", largest SCC "
+             << m->second.largest_scc
+             << (m->second.transition_property ? ", transition property" : "")
+             << ")";
+    }
+
+    status << ": " << as_string(engine) << messaget::eom;
+
+    auto run = [&](scheduled_enginet run_engine)
+    {
+      ebmc_propertiest selected = properties;
+
+      for(auto &property : selected.properties)
+      {
+        if(!property.is_assumption() && property.identifier != identifier)
+          property.disable();
+      }
+
+      auto result = property_checker_engine(
+        engine_cmdline(cmdline, run_engine),
+        transition_system,
+        selected,
+        message_handler);
+
+      std::optional<ebmc_propertiest::propertyt> checked;
+
+      if(
+        result.status == property_checker_resultt::statust::VERIFICATION_RESULT)
+      {
+        for(const auto &property : result.properties)
+          if(property.identifier == identifier)
+            checked = property;
+      }
+
+      return checked;
+    };
+
+    auto checked = run(engine);
+
+    if(
+      engine != scheduled_enginet::HEURISTIC &&
+      (!checked.has_value() || !is_settled(*checked)))
+    {
+      message.status() << "Falling back to the heuristic for " << identifier
+                       << messaget::eom;
+
+      auto fallback = run(scheduled_enginet::HEURISTIC);
+
+      if(
+        fallback.has_value() &&
+        (!checked.has_value() || is_settled(*fallback)))
+      {
+        checked = std::move(fallback);
+      }
+    }
+
+    if(!checked.has_value())
+      return property_checker_resultt::error();
+
+    for(auto &property : properties.properties)
+      if(property.identifier == identifier)
+        property.copy_results_from(*checked);
+
+    stream_results(properties);
+  }
+
+  return property_checker_resultt{properties};
+}
@@ -0,0 +1,71 @@
+/*******************************************************************\
+
+Module: Difficulty-Aware Property Scheduling
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// --schedule-properties: cheap structural metrics of each property
+/// decide the order in which the properties are checked, and the
+/// engine that checks them
+
+#ifndef CPROVER_EBMC_PROPERTY_SCHEDULER_H
+#define CPROVER_EBMC_PROPERTY_SCHEDULER_H
+
+#include "property_checker.h"
+
+#include <map>
+#include <string>
+
+class netlistt;
+
+struct property_metricst
+{
+  // the number of latch bits in the cone of influence
+  std::size_t coi_latches = 0;
+
+  // the number of AND levels of the property and of the next-state
+  // functions of the latches in its cone
+  std::size_t aig_depth = 0;
+
+  // the size of the largest cycle of the latch dependency graph of
+  // the cone; zero when the graph has no cycle
+  std::size_t largest_scc = 0;
+
+  bool transition_property = false;
+
+  std::size_t expected_cost() const;
+};
+
+/// The metrics of each property that is translated into the netlist
+std::map<irep_idt, property_metricst>
+property_metrics(const netlistt &, const ebmc_propertiest &);
+
+enum class scheduled_enginet
+{
+  HEURISTIC,
+  BDD,
+  IC3,
+  BMC
+};
+
+/// The engine most likely to settle a property with the given metrics
+scheduled_enginet scheduled_engine(const property_metricst &);
+
+std::string as_string(scheduled_enginet);
+
+/// The bound for the properties routed to BMC
+const std::size_t scheduled_bmc_bound = 10;
+
+/// Checks the properties one by one, cheapest first, each with the
+/// engine chosen by scheduled_engine. The properties that engine does
+/// not settle go to the heuristic engine.
+property_checker_resultt scheduled_property_checker(
+  const cmdlinet &,
+  transition_systemt &,
+  ebmc_propertiest &,
+  message_handlert &);
+
+#endif // CPROVER_EBMC_PROPERTY_SCHEDULER_H
@@ -23,6 +23,34 @@ Author: Daniel Kroening, dkr@amazon.com
 
 /*******************************************************************\
 
+Function: json_result
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+json_objectt
+json_result(const ebmc_propertiest::propertyt &property, const namespacet &ns)
+{
+  json_objectt json_property;
+  json_property["identifier"] = json_stringt(id2string(property.identifier));
+  json_property["status"] = json_stringt(property.status_as_string());
+
+  if(property.has_witness_trace())
+    json_property["trace"] = json(property.witness_trace.value(), ns);
+
+  if(property.is_proved() && property.proof_via.has_value())
+    json_property["proof_via"] = json_stringt{property.proof_via.value()};
+
+  return json_property;
+}
+
+/*******************************************************************\
+
 Function: ebmc_baset::report_results
 
   Inputs:
@@ -53,18 +81,7 @@ void report_results(
       if(property.is_disabled())
         continue;
 
-      json_objectt json_property;
-      json_property["identifier"] =
-        json_stringt(id2string(property.identifier));
-      json_property["status"] = json_stringt(property.status_as_string());
-
-      if(property.has_witness_trace())
-        json_property["trace"] = json(property.witness_trace.value(), ns);
-
-      if(property.is_proved() && property.proof_via.has_value())
-        json_property["proof_via"] = json_stringt{property.proof_via.value()};
-
-      json_properties.push_back(std::move(json_property));
+      json_properties.push_back(json_result(property, ns));
     }
 
     outfile.stream() << json_results;
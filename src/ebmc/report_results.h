@@ -12,11 +12,17 @@ Author: Daniel Kroening, dkr@amazon.com
 #ifndef EBMC_REPORT_RESULTS
 #define EBMC_REPORT_RESULTS
 
+#include <util/json.h>
+
 #include "property_checker.h"
 
 class message_handlert;
 class namespacet;
 
+/// The status of the property, with the trace and the proof method
+json_objectt
+json_result(const ebmc_propertiest::propertyt &, const namespacet &);
+
 void report_results(
   const cmdlinet &,
   bool show_proof_via,
@@ -0,0 +1,219 @@
+/*******************************************************************\
+
+Module: Persistent Cache for Property Results
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+#include "result_cache.h"
+
+#include <trans-netlist/netlist.h>
+#include <trans-netlist/trans_to_netlist.h>
+
+#include "coi_hash.h"
+#include "ebmc_error.h"
+#include "property_results.h"
+
+#include <fstream>
+
+#ifndef _WIN32
+#  include <unistd.h>
+#endif
+
+/*******************************************************************\
+
+Function: result_cachet::result_cachet
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+result_cachet::result_cachet(
+  std::filesystem::path _directory,
+  message_handlert &message_handler)
+  : directory(std::move(_directory)), message(message_handler)
+{
+}
+
+/*******************************************************************\
+
+Function: result_cachet::load
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::optional<result_cachet::propertyt>
+result_cachet::load(const std::string &hash) const
+{
+  std::ifstream in(directory / hash);
+
+  if(!in)
+    return {};
+
+  std::string line;
+
+  if(!std::getline(in, line))
+    return {};
+
+  try
+  {
+    auto property = property_results_from_line(line);
+
+    if(!is_cacheable(property))
+      return {};
+
+    return property;
+  }
+  catch(const ebmc_errort &)
+  {
+    message.warning() << "ignoring malformed cache entry " << hash
+                      << messaget::eom;
+    return {};
+  }
+}
+
+/*******************************************************************\
+
+Function: result_cachet::store
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: write to a temporary file first, and then rename, as
+          concurrent runs may share the cache
+
+\*******************************************************************/
+
+void result_cachet::store(const std::string &hash, const propertyt &property)
+  const
+{
+  std::error_code error;
+  std::filesystem::create_directories(directory, error);
+
+#ifdef _WIN32
+  const auto temporary = directory / (hash + ".tmp");
+#else
+  const auto temporary =
+    directory / (hash + ".tmp" + std::to_string(::getpid()));
+#endif
+
+  {
+    std::ofstream out(temporary);
+    out << property_results_to_line(property) << '\n';
+
+    if(!out)
+    {
+      message.warning() << "failed to write to the result cache "
+                        << directory.string() << messaget::eom;
+      return;
+    }
+  }
+
+  std::filesystem::rename(temporary, directory / hash, error);
+
+  if(error)
+  {
+    std::filesystem::remove(temporary, error);
+    message.warning() << "failed to write to the result cache "
+                      << directory.string() << messaget::eom;
+  }
+}
+
+/*******************************************************************\
+
+Function: result_cachet::lookup
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void result_cachet::lookup(
+  transition_systemt &transition_system,
+  ebmc_propertiest &properties)
+{
+  netlistt netlist;
+
+  convert_trans_to_netlist(
+    transition_system.symbol_table,
+    transition_system.main_symbol->name,
+    transition_system.trans_expr,
+    properties.make_property_map(),
+    netlist,
+    message.get_message_handler());
+
+  hashes = cone_of_influence_hashes(netlist, properties);
+
+  for(auto &property : properties.properties)
+  {
+    if(property.is_assumption() || !property.is_unknown())
+      continue;
+
+    auto hash = hashes.find(property.identifier);
+
+    if(hash == hashes.end())
+      continue;
+
+    auto cached = load(hash->second);
+
+    if(!cached.has_value())
+      continue;
+
+    cached->identifier = property.identifier;
+    hits.emplace(property.identifier, std::move(*cached));
+
+    // the engines skip these
+    property.disable();
+  }
+
+  message.status() << "Result cache: " << hits.size() << " of "
+                   << hashes.size() << " properties found" << messaget::eom;
+}
+
+/*******************************************************************\
+
+Function: result_cachet::update
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void result_cachet::update(property_checker_resultt &result) const
+{
+  if(result.status != property_checker_resultt::statust::VERIFICATION_RESULT)
+    return;
+
+  for(auto &property : result.properties)
+  {
+    auto hit = hits.find(property.identifier);
+
+    if(hit != hits.end())
+    {
+      property.copy_results_from(hit->second);
+      continue;
+    }
+
+    auto hash = hashes.find(property.identifier);
+
+    if(hash != hashes.end() && is_cacheable(property))
+      store(hash->second, property);
+  }
+}
@@ -0,0 +1,59 @@
+/*******************************************************************\
+
+Module: Persistent Cache for Property Results
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// An on-disk cache of the proved and refuted properties, keyed by the
+/// hash of the cone of influence of the property. A property whose cone
+/// is unchanged is not checked again.
+
+#ifndef CPROVER_EBMC_RESULT_CACHE_H
+#define CPROVER_EBMC_RESULT_CACHE_H
+
+#include "property_checker.h"
+
+#include <filesystem>
+#include <map>
+#include <optional>
+
+class result_cachet
+{
+public:
+  /// The directory is created when the first result is stored.
+  result_cachet(std::filesystem::path, message_handlert &);
+
+  /// Takes the results of the properties that are in the cache, and
+  /// disables these for the engines.
+  void lookup(transition_systemt &, ebmc_propertiest &);
+
+  /// Restores the results taken from the cache into the result, and
+  /// stores the new results.
+  void update(property_checker_resultt &) const;
+
+  using propertyt = ebmc_propertiest::propertyt;
+
+  /// the results that are worth keeping
+  static bool is_cacheable(const propertyt &property)
+  {
+    return property.is_proved() || property.is_refuted();
+  }
+
+protected:
+  const std::filesystem::path directory;
+  messaget message;
+
+  // the hash of each property with a netlist translation
+  std::map<irep_idt, std::string> hashes;
+
+  // the results found in the cache
+  std::map<irep_idt, propertyt> hits;
+
+  std::optional<propertyt> load(const std::string &hash) const;
+  void store(const std::string &hash, const propertyt &) const;
+};
+
+#endif // CPROVER_EBMC_RESULT_CACHE_H
@@ -0,0 +1,273 @@
+/*******************************************************************\
+
+Module: Streaming of Property Results
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+#include "result_stream.h"
+
+#include <trans-netlist/trans_trace.h>
+
+#include <ostream>
+
+#ifndef _WIN32
+#  include <unistd.h>
+#endif
+
+result_streamt *result_streamt::active_stream = nullptr;
+
+/*******************************************************************\
+
+Function: process_id
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: there are no forked workers on Windows
+
+\*******************************************************************/
+
+static int process_id()
+{
+#ifdef _WIN32
+  return 0;
+#else
+  return ::getpid();
+#endif
+}
+
+/*******************************************************************\
+
+Function: output_json_line
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: output the JSON value without line breaks, for the
+          line-based formats
+
+\*******************************************************************/
+
+void output_json_line(std::ostream &out, const jsont &json)
+{
+  if(json.is_object())
+  {
+    out << '{';
+    bool first = true;
+    for(const auto &[key, value] : to_json_object(json))
+    {
+      if(!first)
+        out << ',';
+      first = false;
+      out << '"';
+      jsont::escape_string(key, out);
+      out << "\":";
+      output_json_line(out, value);
+    }
+    out << '}';
+  }
+  else if(json.is_array())
+  {
+    out << '[';
+    bool first = true;
+    for(const auto &element : to_json_array(json))
+    {
+      if(!first)
+        out << ',';
+      first = false;
+      output_json_line(out, element);
+    }
+    out << ']';
+  }
+  else if(json.is_string())
+  {
+    out << '"';
+    jsont::escape_string(json.value, out);
+    out << '"';
+  }
+  else if(json.is_number())
+    out << json.value;
+  else if(json.is_true())
+    out << "true";
+  else if(json.is_false())
+    out << "false";
+  else
+    out << "null";
+}
+
+/*******************************************************************\
+
+Function: result_streamt::result_streamt
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+result_streamt::result_streamt(std::ostream &_out, const namespacet &_ns)
+  : out(_out), ns(_ns), previous(active_stream), owner(process_id())
+{
+  active_stream = this;
+}
+
+/*******************************************************************\
+
+Function: result_streamt::~result_streamt
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+result_streamt::~result_streamt()
+{
+  active_stream = previous;
+}
+
+/*******************************************************************\
+
+Function: result_streamt::write
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: The trace is written state by state, and assignment by
+          assignment, instead of as one JSON tree, as traces may be
+          large.
+
+\*******************************************************************/
+
+void result_streamt::write(const ebmc_propertiest::propertyt &property)
+{
+  // e.g., a forked worker
+  if(process_id() != owner)
+    return;
+
+  if(!written.insert(property.identifier).second)
+    return;
+
+  out << "{\"identifier\":";
+  output_json_line(out, json_stringt{id2string(property.identifier)});
+  out << ",\"status\":";
+  output_json_line(out, json_stringt{property.status_as_string()});
+
+  if(property.is_proved() && property.proof_via.has_value())
+  {
+    out << ",\"proof_via\":";
+    output_json_line(out, json_stringt{property.proof_via.value()});
+  }
+
+  if(property.has_witness_trace())
+  {
+    const auto &trace = property.witness_trace.value();
+
+    out << ",\"trace\":{\"mode\":";
+    output_json_line(out, json_stringt{trace.mode});
+    out << ",\"states\":[";
+
+    bool first_state = true;
+
+    for(const auto &state : trace.states)
+    {
+      if(!first_state)
+        out << ',';
+      first_state = false;
+
+      out << '[';
+      bool first_assignment = true;
+
+      for(const auto &assignment : state.assignments)
+      {
+        auto json_assignment = json(assignment, ns);
+
+        if(!json_assignment.has_value())
+          continue;
+
+        if(!first_assignment)
+          out << ',';
+        first_assignment = false;
+
+        output_json_line(out, *json_assignment);
+      }
+
+      out << ']';
+
+      if(state.property_failed)
+        break; // done
+    }
+
+    out << "]}";
+  }
+
+  // the consumers see the record right away
+  out << "}\n" << std::flush;
+}
+
+/*******************************************************************\
+
+Function: result_streamt::decided
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void result_streamt::decided(const ebmc_propertiest::propertiest &properties)
+{
+  // A later engine may improve on a bounded result, which is hence
+  // left to finish().
+  for(const auto &property : properties)
+    if(property.is_proved() || property.is_refuted())
+      write(property);
+}
+
+/*******************************************************************\
+
+Function: result_streamt::finish
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void result_streamt::finish(const ebmc_propertiest::propertiest &properties)
+{
+  for(const auto &property : properties)
+    if(!property.is_disabled())
+      write(property);
+}
+
+/*******************************************************************\
+
+Function: stream_results
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void stream_results(const ebmc_propertiest &properties)
+{
+  if(result_streamt::active() != nullptr)
+    result_streamt::active()->decided(properties.properties);
+}
@@ -0,0 +1,69 @@
+/*******************************************************************\
+
+Module: Streaming of Property Results
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// --json-stream: one line of JSON per property, written as soon as
+/// the result of the property is final
+
+#ifndef CPROVER_EBMC_RESULT_STREAM_H
+#define CPROVER_EBMC_RESULT_STREAM_H
+
+#include <util/json.h>
+
+#include "ebmc_properties.h"
+
+#include <iosfwd>
+#include <set>
+
+class namespacet;
+
+/// Writes the JSON value without line breaks
+void output_json_line(std::ostream &, const jsont &);
+
+/// Writes the records while in scope. Streams nest; the innermost one
+/// is written by stream_results(). Only the process that created the
+/// stream writes to it, not the forked workers.
+class result_streamt
+{
+public:
+  result_streamt(std::ostream &, const namespacet &);
+  ~result_streamt();
+
+  result_streamt(const result_streamt &) = delete;
+  result_streamt &operator=(const result_streamt &) = delete;
+
+  /// writes the properties that are proved or refuted, once
+  void decided(const ebmc_propertiest::propertiest &);
+
+  /// writes the properties that are not written yet, whatever their
+  /// status
+  void finish(const ebmc_propertiest::propertiest &);
+
+  /// the innermost stream in scope, if any
+  static result_streamt *active()
+  {
+    return active_stream;
+  }
+
+protected:
+  std::ostream &out;
+  const namespacet &ns;
+  std::set<irep_idt> written;
+  result_streamt *const previous;
+  const int owner;
+
+  void write(const ebmc_propertiest::propertyt &);
+
+  static result_streamt *active_stream;
+};
+
+/// Writes the decided properties to the innermost stream; does
+/// nothing when there is no stream.
+void stream_results(const ebmc_propertiest &);
+
+#endif // CPROVER_EBMC_RESULT_STREAM_H
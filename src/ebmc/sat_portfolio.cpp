@@ -0,0 +1,466 @@
+/*******************************************************************\
+
+Module: Portfolio of SAT Solvers
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+#include "sat_portfolio.h"
+
+#include <solvers/sat/satcheck_cadical.h>
+#include <solvers/sat/satcheck_minisat2.h>
+
+#ifdef HAVE_MINISAT2
+#  include <minisat/core/Solver.h>
+#endif
+
+#ifdef HAVE_CADICAL
+#  include <cadical.hpp>
+#endif
+
+#include "ebmc_error.h"
+#include "engine_budget.h"
+
+#include <mutex>
+#include <thread>
+
+#ifdef HAVE_MINISAT2
+
+/*******************************************************************\
+
+   Class: portfolio_minisatt
+
+ Purpose: MiniSat without simplifier, which keeps all variables for
+          the model; optionally with randomized decisions
+
+\*******************************************************************/
+
+class portfolio_minisatt : public sat_portfoliot::membert,
+                           public satcheck_minisat_no_simplifiert
+{
+public:
+  explicit portfolio_minisatt(std::optional<unsigned> _seed)
+    : satcheck_minisat_no_simplifiert(member_message_handler), seed(_seed)
+  {
+    if(seed.has_value())
+    {
+      solver->random_seed = *seed;
+      solver->random_var_freq = 0.02;
+    }
+  }
+
+  cnft &cnf() override
+  {
+    return *this;
+  }
+
+  std::string description() const override
+  {
+    if(seed.has_value())
+      return "MiniSat with seed " + std::to_string(*seed);
+    else
+      return "MiniSat";
+  }
+
+  void terminate_solve() override
+  {
+    solver->interrupt();
+  }
+
+  void reset_termination() override
+  {
+    solver->clearInterrupt();
+
+    // An interrupted solve leaves the solver in the error state, which
+    // does not admit further queries. The solver itself is intact.
+    if(status == statust::ERROR)
+      status = statust::INIT;
+  }
+
+protected:
+  const std::optional<unsigned> seed;
+};
+
+#endif
+
+#ifdef HAVE_CADICAL
+
+/*******************************************************************\
+
+   Class: portfolio_cadicalt
+
+ Purpose: CaDiCaL without preprocessing, which keeps all variables
+          for the model
+
+\*******************************************************************/
+
+class portfolio_cadicalt : public sat_portfoliot::membert,
+                           public satcheck_cadical_no_preprocessingt
+{
+public:
+  portfolio_cadicalt()
+    : satcheck_cadical_no_preprocessingt(member_message_handler)
+  {
+  }
+
+  cnft &cnf() override
+  {
+    return *this;
+  }
+
+  std::string description() const override
+  {
+    return "CaDiCaL";
+  }
+
+  void terminate_solve() override
+  {
+    // CaDiCaL clears the request once the solve call has returned
+    solver->terminate();
+  }
+
+  void reset_termination() override
+  {
+    // as with MiniSat
+    if(status == statust::ERROR)
+      status = statust::INIT;
+  }
+};
+
+#endif
+
+/*******************************************************************\
+
+Function: sat_portfoliot::sat_portfoliot
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+sat_portfoliot::sat_portfoliot(message_handlert &message_handler)
+  : cnf_solvert(message_handler)
+{
+#ifdef HAVE_MINISAT2
+  members.push_back(minisat(std::nullopt));
+#endif
+
+#ifdef HAVE_CADICAL
+  members.push_back(std::make_unique<portfolio_cadicalt>());
+#endif
+
+#ifdef HAVE_MINISAT2
+  for(unsigned seed = 1; members.size() < 3; seed++)
+    members.push_back(minisat(seed));
+#endif
+
+  if(members.size() < 2)
+    throw ebmc_errort() << "--sat-portfolio requires MiniSat";
+}
+
+/*******************************************************************\
+
+Function: sat_portfoliot::sat_portfoliot
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+sat_portfoliot::sat_portfoliot(
+  message_handlert &message_handler,
+  std::vector<std::unique_ptr<membert>> _members)
+  : cnf_solvert(message_handler), members(std::move(_members))
+{
+  PRECONDITION(!members.empty());
+}
+
+/*******************************************************************\
+
+Function: sat_portfoliot::minisat
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::unique_ptr<sat_portfoliot::membert>
+sat_portfoliot::minisat(std::optional<unsigned> seed)
+{
+#ifdef HAVE_MINISAT2
+  return std::make_unique<portfolio_minisatt>(seed);
+#else
+  throw ebmc_errort() << "support for MiniSat not configured";
+#endif
+}
+
+/*******************************************************************\
+
+Function: sat_portfoliot::~sat_portfoliot
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+sat_portfoliot::~sat_portfoliot() = default;
+
+/*******************************************************************\
+
+Function: sat_portfoliot::add_variables
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the variables of the members match those of the portfolio
+
+\*******************************************************************/
+
+void sat_portfoliot::add_variables(cnft &solver) const
+{
+  while(solver.no_variables() < no_variables())
+    solver.new_variable();
+}
+
+/*******************************************************************\
+
+Function: sat_portfoliot::lcnf
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void sat_portfoliot::lcnf(const bvt &clause)
+{
+  for(auto &member : members)
+  {
+    add_variables(member->cnf());
+    member->cnf().lcnf(clause);
+  }
+}
+
+/*******************************************************************\
+
+Function: sat_portfoliot::set_frozen
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void sat_portfoliot::set_frozen(literalt l)
+{
+  for(auto &member : members)
+  {
+    add_variables(member->cnf());
+    member->cnf().set_frozen(l);
+  }
+}
+
+/*******************************************************************\
+
+Function: sat_portfoliot::set_assignment
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void sat_portfoliot::set_assignment(literalt l, bool value)
+{
+  for(auto &member : members)
+  {
+    add_variables(member->cnf());
+    member->cnf().set_assignment(l, value);
+  }
+}
+
+/*******************************************************************\
+
+Function: sat_portfoliot::l_get
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+tvt sat_portfoliot::l_get(literalt l) const
+{
+  if(l.is_constant())
+    return tvt(l.is_true());
+
+  if(!winner.has_value())
+    return tvt::unknown();
+
+  return members[*winner]->cnf().l_get(l);
+}
+
+/*******************************************************************\
+
+Function: sat_portfoliot::is_in_conflict
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+bool sat_portfoliot::is_in_conflict(literalt l) const
+{
+  PRECONDITION(winner.has_value());
+  return members[*winner]->cnf().is_in_conflict(l);
+}
+
+/*******************************************************************\
+
+Function: sat_portfoliot::solver_text
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::string sat_portfoliot::solver_text() const
+{
+  std::string result = "portfolio of";
+
+  for(std::size_t i = 0; i < members.size(); i++)
+  {
+    result += i == 0 ? " " : ", ";
+    result += members[i]->description();
+  }
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: sat_portfoliot::do_prop_solve
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: The members solve concurrently. The first to answer
+          interrupts those that are still solving.
+
+\*******************************************************************/
+
+propt::resultt sat_portfoliot::do_prop_solve(const bvt &assumptions)
+{
+  for(auto &member : members)
+    add_variables(member->cnf());
+
+  std::mutex mutex;
+  std::vector<bool> done(members.size(), false);
+  std::vector<resultt> results(members.size(), resultt::P_ERROR);
+  std::optional<std::size_t> first;
+
+  std::vector<std::thread> threads;
+  threads.reserve(members.size());
+
+  for(std::size_t i = 0; i < members.size(); i++)
+  {
+    threads.emplace_back(
+      [this, i, &assumptions, &mutex, &done, &results, &first]()
+      {
+        resultt result;
+
+        try
+        {
+          result = members[i]->solve(assumptions);
+        }
+        catch(...)
+        {
+          result = resultt::P_ERROR;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        done[i] = true;
+        results[i] = result;
+
+        // an interrupted member answers P_ERROR
+        if(!first.has_value() && result != resultt::P_ERROR)
+        {
+          first = i;
+
+          for(std::size_t j = 0; j < members.size(); j++)
+            if(!done[j])
+              members[j]->terminate_solve();
+        }
+      });
+  }
+
+  bool interrupted;
+
+  {
+    // The members do not see the budget of this thread, and hence, are
+    // interrupted once it is exhausted.
+    budget_watchdogt watchdog(
+      cancellation_tokent::active(),
+      [this, &mutex, &done]()
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        for(std::size_t j = 0; j < members.size(); j++)
+          if(!done[j])
+            members[j]->terminate_solve();
+      });
+
+    for(auto &thread : threads)
+      thread.join();
+
+    interrupted = watchdog.fired();
+  }
+
+  for(auto &member : members)
+    member->reset_termination();
+
+  winner = first;
+
+  if(!winner.has_value())
+  {
+    if(!interrupted)
+      log.error() << "no answer from the SAT portfolio" << messaget::eom;
+
+    return resultt::P_ERROR;
+  }
+
+  log.statistics() << "SAT portfolio: answer from "
+                   << members[*winner]->description() << messaget::eom;
+
+  return results[*winner];
+}
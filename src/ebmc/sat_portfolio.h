@@ -0,0 +1,100 @@
+/*******************************************************************\
+
+Module: Portfolio of SAT Solvers
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// --sat-portfolio: the CNF is encoded once, and each clause is given
+/// to several SAT solvers. Each query is solved by all of them
+/// concurrently, in threads; the first answer is taken, and the other
+/// solvers are interrupted. All are interrupted once the budget of the
+/// engine is exhausted.
+
+#ifndef CPROVER_EBMC_SAT_PORTFOLIO_H
+#define CPROVER_EBMC_SAT_PORTFOLIO_H
+
+#include <util/message.h>
+
+#include <solvers/sat/cnf.h>
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+class sat_portfoliot : public cnf_solvert
+{
+public:
+  /// A solver of the portfolio, which can be interrupted while it
+  /// solves in another thread
+  class membert
+  {
+  public:
+    virtual ~membert() = default;
+
+    virtual cnft &cnf() = 0;
+
+    // the solver and its configuration
+    virtual std::string description() const = 0;
+
+    // called in the thread of the member
+    virtual resultt solve(const bvt &assumptions)
+    {
+      return cnf().prop_solve(assumptions);
+    }
+
+    // may be called from another thread while the member solves
+    virtual void terminate_solve() = 0;
+
+    // called once the member is idle; the member must then accept
+    // further clauses and queries
+    virtual void reset_termination() = 0;
+
+  protected:
+    // The members run in separate threads, and hence, each one has
+    // its own message handler.
+    null_message_handlert member_message_handler;
+  };
+
+  /// MiniSat, CaDiCaL when configured, and MiniSat with randomized
+  /// decisions
+  explicit sat_portfoliot(message_handlert &);
+
+  /// A portfolio of the given members
+  sat_portfoliot(message_handlert &, std::vector<std::unique_ptr<membert>>);
+
+  ~sat_portfoliot() override;
+
+  /// MiniSat without simplifier; with a seed, with randomized decisions
+  static std::unique_ptr<membert> minisat(std::optional<unsigned> seed);
+
+  void lcnf(const bvt &) override;
+  void set_frozen(literalt) override;
+  void set_assignment(literalt, bool) override;
+
+  /// The value in the model of the solver that gave the last answer
+  tvt l_get(literalt) const override;
+
+  bool is_in_conflict(literalt) const override;
+
+  bool has_is_in_conflict() const override
+  {
+    return true;
+  }
+
+  std::string solver_text() const override;
+
+protected:
+  resultt do_prop_solve(const bvt &assumptions) override;
+
+  std::vector<std::unique_ptr<membert>> members;
+
+  // the member that gave the answer to the last query
+  std::optional<std::size_t> winner;
+
+  void add_variables(cnft &) const;
+};
+
+#endif // CPROVER_EBMC_SAT_PORTFOLIO_H
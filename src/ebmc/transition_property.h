@@ -13,9 +13,14 @@ Author: Daniel Kroening, dkr@amazon.com
 #include "property_checker.h"
 
 class ebmc_propertiest;
+class exprt;
 class message_handlert;
 class transition_systemt;
 
+/// Is the given property of the form G Q, where Q is a Boolean
+/// combination of state predicates and X p, with p non-temporal?
+bool is_transition_property(const exprt &);
+
 /// Proves properties that are relations between current and next
 /// state pairs by checking whether they are implied by the
 /// transition relation.
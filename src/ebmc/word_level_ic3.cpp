@@ -0,0 +1,959 @@
+/*******************************************************************\
+
+Module: Word-Level IC3
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// IC3/PDR on the word-level transition system, with implicit
+/// predicate abstraction
+
+#include "word_level_ic3.h"
+
+#include <util/bitvector_expr.h>
+#include <util/bitvector_types.h>
+#include <util/expr_util.h>
+#include <util/find_symbols.h>
+#include <util/replace_symbol.h>
+#include <util/simplify_expr.h>
+
+#include <temporal-logic/temporal_logic.h>
+#include <trans-word-level/instantiate_word_level.h>
+#include <trans-word-level/trans_trace_word_level.h>
+#include <trans-word-level/unwind.h>
+
+#include "ebmc_error.h"
+#include "ebmc_properties.h"
+#include "engine_budget.h"
+#include "transition_system.h"
+
+#include <algorithm>
+#include <queue>
+#include <unordered_set>
+
+/// A literal over the predicates: the predicate number and its value
+struct predicate_literalt
+{
+  std::size_t predicate;
+  bool value;
+
+  bool operator<(const predicate_literalt &other) const
+  {
+    return predicate < other.predicate ||
+           (predicate == other.predicate && value < other.value);
+  }
+
+  bool operator==(const predicate_literalt &other) const
+  {
+    return predicate == other.predicate && value == other.value;
+  }
+};
+
+/// A conjunction of predicate literals, sorted by predicate number
+using abstract_cubet = std::vector<predicate_literalt>;
+
+/// IC3 with implicit predicate abstraction (Cimatti, Griggio, Mover,
+/// Tonetta, TACAS 2014). The frames and the cubes are over predicates
+/// on the current state, while the transition relation stays concrete.
+/// The query F_i(X) & T(X, X') & c(X') evaluates the predicates of the
+/// frame on X and those of the cube on X', and thus uses the abstract
+/// transition relation without computing it.
+///
+/// Abstract counterexamples are replayed with BMC. A spurious one is
+/// refined with the weakest preconditions of the predicates of its
+/// first infeasible step. Once that yields nothing new, the bits of the
+/// state variables become predicates, which makes the abstraction
+/// exact.
+class word_level_ic3t
+{
+public:
+  word_level_ic3t(
+    const transition_systemt &,
+    const exprt &property,
+    const exprt::operandst &assumptions,
+    const ebmc_solver_factoryt &,
+    message_handlert &);
+
+  enum class outcomet
+  {
+    PROVED,
+    REFUTED,
+    INCONCLUSIVE
+  };
+
+  outcomet operator()();
+
+  // when REFUTED
+  std::optional<trans_tracet> trace;
+
+protected:
+  const transition_systemt &transition_system;
+  const namespacet ns;
+  const exprt property;
+  const exprt::operandst &assumptions;
+  const ebmc_solver_factoryt &solver_factory;
+  messaget message;
+
+  // Max refinements with weakest preconditions before the
+  // abstraction is made exact
+  static constexpr std::size_t WP_REFINEMENT_MAX = 16;
+  // Max depth of the expansion of the wire definitions
+  static constexpr std::size_t WIRE_DEPTH_MAX = 64;
+
+  std::size_t num_queries = 0, num_refinements = 0;
+
+  // The predicates, over the current state. Predicate 0 is the
+  // property.
+  std::vector<exprt> predicates;
+  std::unordered_set<exprt, irep_hash> predicate_set;
+  bool add_predicate(exprt);
+
+  void initial_predicates();
+
+  // the next-state functions and the wire definitions, for computing
+  // weakest preconditions
+  replace_symbolt next_state_functions;
+  replace_symbolt wire_definitions;
+  std::unordered_set<irep_idt> has_next_state_function;
+  void collect_definitions();
+  std::optional<exprt> weakest_precondition(exprt) const;
+
+  bool refine(const abstract_cubet &);
+
+  // The solver is rebuilt whenever predicates are added. All constraints
+  // added after the first solver call only use handles, which the
+  // solver keeps.
+  std::optional<ebmc_solvert> solver_wrapper;
+  exprt::operandst current_handles, next_handles;
+  exprt init_activation;
+  exprt::operandst frame_activations;
+  void build_solver();
+
+  decision_proceduret &solver()
+  {
+    return solver_wrapper->decision_procedure();
+  }
+
+  bool is_sat(const exprt &assumption);
+
+  exprt literal_expr(predicate_literalt, bool next) const;
+  exprt cube_expr(const abstract_cubet &, bool next) const;
+  exprt frame_expr(std::size_t level) const;
+  abstract_cubet model_cube();
+
+  // The cubes blocked at each level, using the delta encoding: a cube
+  // blocked at level j is blocked in F_i for all i <= j.
+  std::vector<std::vector<abstract_cubet>> frames;
+  void new_frame();
+  bool is_blocked(const abstract_cubet &, std::size_t level) const;
+  void add_blocked_cube(std::size_t level, const abstract_cubet &);
+  bool propagate();
+
+  std::optional<abstract_cubet> solve_bad(std::size_t level);
+  std::optional<abstract_cubet>
+  solve_relative(std::size_t level, const abstract_cubet &);
+  bool init_intersects(const abstract_cubet &);
+  abstract_cubet generalize(std::size_t level, abstract_cubet);
+
+  /// The chain of proof obligations that leads to the bad states
+  struct obligation_nodet
+  {
+    abstract_cubet cube;
+    std::optional<std::size_t> successor;
+  };
+
+  std::vector<obligation_nodet> obligation_nodes;
+
+  struct obligationt
+  {
+    abstract_cubet cube;
+    std::size_t level;
+    std::size_t node;
+
+    bool operator>(const obligationt &other) const
+    {
+      return level > other.level;
+    }
+  };
+
+  bool concretize(
+    const std::vector<abstract_cubet> &path,
+    std::size_t &infeasible_step);
+};
+
+word_level_ic3t::word_level_ic3t(
+  const transition_systemt &_transition_system,
+  const exprt &_property,
+  const exprt::operandst &_assumptions,
+  const ebmc_solver_factoryt &_solver_factory,
+  message_handlert &message_handler)
+  : transition_system(_transition_system),
+    ns(_transition_system.symbol_table),
+    property(_property),
+    assumptions(_assumptions),
+    solver_factory(_solver_factory),
+    message(message_handler)
+{
+  // the property is predicate 0
+  predicates.push_back(property);
+  predicate_set.insert(property);
+
+  initial_predicates();
+  collect_definitions();
+}
+
+/// Adds the given predicate unless it is constant, refers to the next
+/// state, or is known already. Returns true when added.
+bool word_level_ic3t::add_predicate(exprt predicate)
+{
+  predicate = simplify_expr(std::move(predicate), ns);
+
+  if(predicate.is_constant() || has_subexpr(predicate, ID_next_symbol))
+    return false;
+
+  if(!predicate_set.insert(predicate).second)
+    return false;
+
+  predicates.push_back(std::move(predicate));
+  return true;
+}
+
+/// the atoms of a Boolean formula
+static void collect_atoms(const exprt &expr, exprt::operandst &dest)
+{
+  if(expr.type().id() != ID_bool || expr.is_constant())
+    return;
+
+  bool connective =
+    expr.id() == ID_and || expr.id() == ID_or || expr.id() == ID_not ||
+    expr.id() == ID_implies || expr.id() == ID_xor || expr.id() == ID_if ||
+    ((expr.id() == ID_equal || expr.id() == ID_notequal) &&
+     to_binary_expr(expr).lhs().type().id() == ID_bool);
+
+  if(connective)
+  {
+    for(auto &op : expr.operands())
+      collect_atoms(op, dest);
+  }
+  else
+    dest.push_back(expr);
+}
+
+/// the conjuncts of a conjunction, flattened
+static void collect_conjuncts(const exprt &expr, exprt::operandst &dest)
+{
+  if(expr.id() == ID_and)
+  {
+    for(auto &op : expr.operands())
+      collect_conjuncts(op, dest);
+  }
+  else if(!expr.is_true())
+    dest.push_back(expr);
+}
+
+void word_level_ic3t::initial_predicates()
+{
+  // the atoms of the initial state constraint
+  exprt::operandst atoms;
+  collect_atoms(transition_system.trans_expr.init(), atoms);
+
+  for(auto &atom : atoms)
+    add_predicate(atom);
+}
+
+void word_level_ic3t::collect_definitions()
+{
+  std::unordered_set<irep_idt> state_variables;
+  for(auto &state_variable : transition_system.state_variables())
+    state_variables.insert(state_variable.identifier());
+
+  // next(x) == f, where f does not refer to the next state
+  exprt::operandst trans_conjuncts;
+  collect_conjuncts(transition_system.trans_expr.trans(), trans_conjuncts);
+
+  for(auto &conjunct : trans_conjuncts)
+  {
+    if(conjunct.id() != ID_equal)
+      continue;
+
+    auto &equal_expr = to_equal_expr(conjunct);
+
+    if(
+      equal_expr.lhs().id() == ID_next_symbol &&
+      !has_subexpr(equal_expr.rhs(), ID_next_symbol) &&
+      equal_expr.lhs().type() == equal_expr.rhs().type())
+    {
+      symbol_exprt symbol{
+        equal_expr.lhs().get(ID_identifier), equal_expr.lhs().type()};
+      has_next_state_function.insert(symbol.identifier());
+      next_state_functions.insert(symbol, equal_expr.rhs());
+    }
+  }
+
+  // w == f, for the wires
+  exprt::operandst invar_conjuncts;
+  collect_conjuncts(transition_system.trans_expr.invar(), invar_conjuncts);
+
+  for(auto &conjunct : invar_conjuncts)
+  {
+    if(conjunct.id() != ID_equal)
+      continue;
+
+    auto &equal_expr = to_equal_expr(conjunct);
+
+    if(
+      equal_expr.lhs().id() == ID_symbol &&
+      equal_expr.lhs().type() == equal_expr.rhs().type())
+    {
+      auto &symbol = to_symbol_expr(equal_expr.lhs());
+      if(state_variables.find(symbol.identifier()) == state_variables.end())
+        wire_definitions.insert(symbol, equal_expr.rhs());
+    }
+  }
+}
+
+/// The weakest precondition of a predicate over the next state,
+/// as predicate over the current state. Fails when the predicate
+/// depends on inputs or on state variables without next-state function.
+std::optional<exprt>
+word_level_ic3t::weakest_precondition(exprt predicate) const
+{
+  // replace returns true when nothing was replaced
+  for(std::size_t depth = 0; depth < WIRE_DEPTH_MAX; depth++)
+    if(wire_definitions.replace(predicate))
+      break;
+
+  find_symbols_sett symbols;
+  find_symbols(predicate, symbols);
+
+  for(auto &identifier : symbols)
+  {
+    if(!has_next_state_function.count(identifier))
+      return {};
+  }
+
+  next_state_functions.replace(predicate);
+
+  return simplify_expr(std::move(predicate), ns);
+}
+
+/// Refines the abstraction to exclude the given infeasible step.
+/// Returns false when no new predicate was found.
+bool word_level_ic3t::refine(const abstract_cubet &cube)
+{
+  num_refinements++;
+
+  std::size_t old_size = predicates.size();
+
+  if(num_refinements <= WP_REFINEMENT_MAX)
+  {
+    for(auto &literal : cube)
+    {
+      auto wp = weakest_precondition(predicates[literal.predicate]);
+      if(wp.has_value())
+        add_predicate(std::move(*wp));
+    }
+  }
+
+  if(predicates.size() == old_size)
+  {
+    // Use the bits of the state variables, which makes the
+    // abstraction exact.
+    for(auto &state_variable : transition_system.state_variables())
+    {
+      const auto &type = state_variable.type();
+      if(type.id() == ID_bool)
+        add_predicate(state_variable);
+      else if(can_cast_type<bitvector_typet>(type))
+      {
+        auto width = to_bitvector_type(type).get_width();
+        for(std::size_t bit = 0; bit < width; bit++)
+          add_predicate(extractbit_exprt{state_variable, bit});
+      }
+    }
+  }
+
+  message.statistics() << "Word-level IC3: refinement " << num_refinements
+                       << ", " << predicates.size() << " predicates"
+                       << messaget::eom;
+
+  if(predicates.size() == old_size)
+    return false;
+
+  build_solver();
+  return true;
+}
+
+void word_level_ic3t::build_solver()
+{
+  solver_wrapper.reset();
+  solver_wrapper.emplace(solver_factory(ns, message.get_message_handler()));
+
+  const auto &trans_expr = transition_system.trans_expr;
+
+  // The state constraints and the assumptions hold in both states,
+  // and the transition relation connects the two.
+  for(std::size_t t = 0; t < 2; t++)
+  {
+    if(!trans_expr.invar().is_true())
+      solver().set_to_true(instantiate(trans_expr.invar(), t, 2));
+
+    for(auto &assumption : assumptions)
+      solver().set_to_true(instantiate(assumption, t, 2));
+  }
+
+  if(!trans_expr.trans().is_true())
+    solver().set_to_true(instantiate(trans_expr.trans(), 0, 2));
+
+  // the initial state constraint, enabled by an activation literal
+  init_activation =
+    solver().handle(symbol_exprt{"word_ic3::init", bool_typet{}});
+  solver().set_to_true(
+    implies_exprt{init_activation, instantiate(trans_expr.init(), 0, 2)});
+
+  current_handles.clear();
+  next_handles.clear();
+
+  for(auto &predicate : predicates)
+  {
+    current_handles.push_back(
+      solver().handle(instantiate_state_predicate(predicate, 0, 2)));
+    next_handles.push_back(
+      solver().handle(instantiate_state_predicate(predicate, 1, 2)));
+  }
+
+  // the blocked cubes, each enabled by the activation literal
+  // of its level
+  frame_activations.clear();
+
+  for(std::size_t level = 0; level < frames.size(); level++)
+  {
+    frame_activations.push_back(solver().handle(symbol_exprt{
+      "word_ic3::frame" + std::to_string(level), bool_typet{}}));
+
+    for(auto &cube : frames[level])
+    {
+      solver().set_to_true(implies_exprt{
+        frame_activations[level], not_exprt{cube_expr(cube, false)}});
+    }
+  }
+}
+
+bool word_level_ic3t::is_sat(const exprt &assumption)
+{
+  num_queries++;
+
+  switch(solver()(assumption))
+  {
+  case decision_proceduret::resultt::D_SATISFIABLE:
+    return true;
+
+  case decision_proceduret::resultt::D_UNSATISFIABLE:
+    return false;
+
+  case decision_proceduret::resultt::D_ERROR:
+    throw ebmc_errort() << "Error from decision procedure";
+  }
+
+  UNREACHABLE;
+}
+
+exprt word_level_ic3t::literal_expr(predicate_literalt literal, bool next)
+  const
+{
+  const auto &handle =
+    next ? next_handles[literal.predicate] : current_handles[literal.predicate];
+  return literal.value ? handle : not_exprt{handle};
+}
+
+exprt word_level_ic3t::cube_expr(const abstract_cubet &cube, bool next) const
+{
+  exprt::operandst conjuncts;
+  conjuncts.reserve(cube.size());
+  for(auto &literal : cube)
+    conjuncts.push_back(literal_expr(literal, next));
+  return conjunction(conjuncts);
+}
+
+/// F_i, given by the activation literals of the levels >= i,
+/// and the initial states for F_0
+exprt word_level_ic3t::frame_expr(std::size_t level) const
+{
+  exprt::operandst conjuncts;
+
+  if(level == 0)
+    conjuncts.push_back(init_activation);
+
+  for(std::size_t j = level; j < frame_activations.size(); j++)
+    conjuncts.push_back(frame_activations[j]);
+
+  return conjunction(conjuncts);
+}
+
+/// the values of the predicates in the current state of the model
+abstract_cubet word_level_ic3t::model_cube()
+{
+  abstract_cubet cube;
+  cube.reserve(predicates.size());
+
+  for(std::size_t i = 0; i < predicates.size(); i++)
+    cube.push_back({i, solver().get(current_handles[i]).is_true()});
+
+  return cube;
+}
+
+void word_level_ic3t::new_frame()
+{
+  frames.emplace_back();
+  frame_activations.push_back(solver().handle(symbol_exprt{
+    "word_ic3::frame" + std::to_string(frames.size() - 1), bool_typet{}}));
+}
+
+/// Is the cube, or a subset of it, blocked at a level >= the given one?
+bool word_level_ic3t::is_blocked(const abstract_cubet &cube, std::size_t level)
+  const
+{
+  for(std::size_t j = level; j < frames.size(); j++)
+  {
+    for(auto &blocked : frames[j])
+    {
+      if(std::includes(
+           cube.begin(), cube.end(), blocked.begin(), blocked.end()))
+      {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+void word_level_ic3t::add_blocked_cube(
+  std::size_t level,
+  const abstract_cubet &cube)
+{
+  if(is_blocked(cube, level))
+    return;
+
+  // Drop the supersets at the levels <= level. They stay in the solver,
+  // which is harmless.
+  for(std::size_t j = 0; j <= level; j++)
+  {
+    auto &cubes = frames[j];
+    cubes.erase(
+      std::remove_if(
+        cubes.begin(),
+        cubes.end(),
+        [&cube](const abstract_cubet &other) {
+          return std::includes(
+            other.begin(), other.end(), cube.begin(), cube.end());
+        }),
+      cubes.end());
+  }
+
+  frames[level].push_back(cube);
+  solver().set_to_true(implies_exprt{
+    frame_activations[level], not_exprt{cube_expr(cube, false)}});
+}
+
+/// Pushes the blocked cubes forward. Returns true when two frames
+/// become equal, i.e., an inductive invariant is found.
+bool word_level_ic3t::propagate()
+{
+  for(std::size_t i = 1; i + 1 < frames.size(); i++)
+  {
+    auto cubes = frames[i];
+
+    for(auto &cube : cubes)
+    {
+      // F_i & T & cube' unsatisfiable?
+      if(!is_sat(and_exprt{frame_expr(i), cube_expr(cube, true)}))
+      {
+        auto &level_cubes = frames[i];
+        level_cubes.erase(
+          std::find(level_cubes.begin(), level_cubes.end(), cube));
+        frames[i + 1].push_back(cube);
+        solver().set_to_true(implies_exprt{
+          frame_activations[i + 1], not_exprt{cube_expr(cube, false)}});
+      }
+    }
+
+    if(frames[i].empty())
+      return true; // F_i = F_{i+1}
+  }
+
+  return false;
+}
+
+std::optional<abstract_cubet> word_level_ic3t::solve_bad(std::size_t level)
+{
+  if(is_sat(and_exprt{frame_expr(level), not_exprt{current_handles[0]}}))
+    return model_cube();
+  else
+    return {};
+}
+
+std::optional<abstract_cubet>
+word_level_ic3t::solve_relative(std::size_t level, const abstract_cubet &cube)
+{
+  // F_i & !cube & T & cube'
+  if(is_sat(and_exprt{
+       frame_expr(level),
+       not_exprt{cube_expr(cube, false)},
+       cube_expr(cube, true)}))
+  {
+    return model_cube();
+  }
+  else
+    return {};
+}
+
+bool word_level_ic3t::init_intersects(const abstract_cubet &cube)
+{
+  return is_sat(and_exprt{init_activation, cube_expr(cube, false)});
+}
+
+/// Drops literals from a cube that is inductive relative to F_level
+/// while it stays so. There are no unsatisfiable cores at the level
+/// of decision_proceduret, hence each literal costs a query.
+abstract_cubet
+word_level_ic3t::generalize(std::size_t level, abstract_cubet cube)
+{
+  for(std::size_t i = 0; i < cube.size() && cube.size() > 1;)
+  {
+    abstract_cubet candidate = cube;
+    candidate.erase(candidate.begin() + i);
+
+    if(
+      !init_intersects(candidate) &&
+      !solve_relative(level, candidate).has_value())
+    {
+      cube = std::move(candidate);
+    }
+    else
+      i++;
+  }
+
+  return cube;
+}
+
+/// Replays the abstract path with BMC. Returns true, and sets the trace,
+/// when the path is feasible. Otherwise, sets infeasible_step to the
+/// first step t such that the steps 0, ..., t are infeasible.
+bool word_level_ic3t::concretize(
+  const std::vector<abstract_cubet> &path,
+  std::size_t &infeasible_step)
+{
+  const std::size_t no_timeframes = path.size();
+
+  auto bmc_solver_wrapper =
+    solver_factory(ns, message.get_message_handler());
+  auto &bmc_solver = bmc_solver_wrapper.decision_procedure();
+
+  ::unwind(
+    transition_system.trans_expr,
+    message.get_message_handler(),
+    bmc_solver,
+    no_timeframes,
+    ns,
+    true);
+
+  for(auto &assumption : assumptions)
+    for(std::size_t t = 0; t < no_timeframes; t++)
+      bmc_solver.set_to_true(instantiate(assumption, t, no_timeframes));
+
+  exprt::operandst prop_handles;
+  for(std::size_t t = 0; t < no_timeframes; t++)
+  {
+    prop_handles.push_back(bmc_solver.handle(
+      instantiate_state_predicate(property, t, no_timeframes)));
+  }
+
+  // the cubes of the path, by step; the last one violates the property
+  exprt::operandst steps;
+  for(std::size_t t = 0; t < no_timeframes; t++)
+  {
+    exprt::operandst conjuncts;
+    for(auto &literal : path[t])
+    {
+      auto predicate = instantiate_state_predicate(
+        predicates[literal.predicate], t, no_timeframes);
+      conjuncts.push_back(
+        literal.value ? predicate : not_exprt{std::move(predicate)});
+    }
+    steps.push_back(bmc_solver.handle(conjunction(conjuncts)));
+  }
+
+  steps.back() = and_exprt{steps.back(), not_exprt{prop_handles.back()}};
+
+  auto feasible = [&](std::size_t last_step)
+  {
+    num_queries++;
+    exprt::operandst prefix(steps.begin(), steps.begin() + last_step + 1);
+    switch(bmc_solver(conjunction(prefix)))
+    {
+    case decision_proceduret::resultt::D_SATISFIABLE:
+      return true;
+    case decision_proceduret::resultt::D_UNSATISFIABLE:
+      return false;
+    case decision_proceduret::resultt::D_ERROR:
+      throw ebmc_errort() << "Error from decision procedure";
+    }
+    UNREACHABLE;
+  };
+
+  if(feasible(no_timeframes - 1))
+  {
+    trace = compute_trans_trace(
+      prop_handles,
+      bmc_solver,
+      no_timeframes,
+      ns,
+      transition_system.main_symbol->name);
+    return true;
+  }
+
+  // The first cube intersects the initial states.
+  infeasible_step = no_timeframes - 1;
+  for(std::size_t t = 1; t + 1 < no_timeframes; t++)
+    if(!feasible(t))
+    {
+      infeasible_step = t;
+      break;
+    }
+
+  return false;
+}
+
+word_level_ic3t::outcomet word_level_ic3t::operator()()
+{
+  if(simplify_expr(property, ns).is_true())
+    return outcomet::PROVED;
+
+  frames.emplace_back(); // F_0
+  build_solver();
+
+  while(true)
+  {
+    cancellation_point();
+
+    new_frame();
+    const std::size_t k = frames.size() - 1;
+
+    message.progress() << "Word-level IC3: frame " << k << " ("
+                       << num_queries << " queries, " << predicates.size()
+                       << " predicates)" << messaget::eom;
+
+    std::priority_queue<
+      obligationt,
+      std::vector<obligationt>,
+      std::greater<obligationt>>
+      obligations;
+
+    // blocking phase
+    while(true)
+    {
+      auto bad_cube = solve_bad(k);
+      if(!bad_cube.has_value())
+        break;
+
+      obligation_nodes.clear();
+      obligation_nodes.push_back({*bad_cube, {}});
+      obligations.push({std::move(*bad_cube), k, 0});
+
+      while(!obligations.empty())
+      {
+        cancellation_point();
+
+        auto [cube, level, node] = obligations.top();
+        obligations.pop();
+
+        if(is_blocked(cube, level))
+          continue;
+
+        if(init_intersects(cube))
+        {
+          // an abstract counterexample
+          std::vector<abstract_cubet> path;
+          for(std::optional<std::size_t> n = node; n.has_value();
+              n = obligation_nodes[*n].successor)
+          {
+            path.push_back(obligation_nodes[*n].cube);
+          }
+
+          std::size_t infeasible_step;
+          if(concretize(path, infeasible_step))
+          {
+            message.status()
+              << "Property refuted with counterexample of length "
+              << path.size() << messaget::eom;
+            return outcomet::REFUTED;
+          }
+
+          if(!refine(path[infeasible_step]))
+          {
+            message.warning() << "Word-level IC3: refinement failed"
+                              << messaget::eom;
+            return outcomet::INCONCLUSIVE;
+          }
+
+          // the obligations are stale
+          obligations = {};
+          break;
+        }
+
+        if(level == 0)
+        {
+          add_blocked_cube(0, cube);
+          continue;
+        }
+
+        auto predecessor = solve_relative(level - 1, cube);
+        if(predecessor.has_value())
+        {
+          auto predecessor_node = obligation_nodes.size();
+          obligation_nodes.push_back({*predecessor, node});
+          obligations.push(
+            {std::move(*predecessor), level - 1, predecessor_node});
+          obligations.push({std::move(cube), level, node});
+        }
+        else
+        {
+          add_blocked_cube(level, generalize(level - 1, cube));
+
+          // re-queue, to push the blocked cube higher
+          if(level + 1 <= k)
+            obligations.push({std::move(cube), level + 1, node});
+        }
+      }
+    }
+
+    if(propagate())
+    {
+      message.status() << "Word-level IC3: converged at frame " << k << " ("
+                       << num_queries << " queries, " << predicates.size()
+                       << " predicates, " << num_refinements
+                       << " refinements)" << messaget::eom;
+      return outcomet::PROVED;
+    }
+  }
+}
+
+static bool word_level_ic3_supports_property(const exprt &expr)
+{
+  if(expr.id() == ID_sva_always || expr.id() == ID_AG || expr.id() == ID_G)
+    return !has_temporal_operator(to_unary_expr(expr).op());
+  else
+    return false;
+}
+
+property_checker_resultt word_level_ic3(
+  const transition_systemt &transition_system,
+  const ebmc_propertiest &properties_in,
+  const ebmc_solver_factoryt &solver_factory,
+  message_handlert &message_handler)
+{
+  // copy
+  auto properties = properties_in;
+
+  messaget message{message_handler};
+
+  // The assumptions are invariants.
+  exprt::operandst assumptions;
+  bool assumption_unsupported = false;
+
+  for(auto &property : properties.properties)
+  {
+    if(!property.is_assumed())
+      continue;
+
+    if(word_level_ic3_supports_property(property.normalized_expr))
+      assumptions.push_back(to_unary_expr(property.normalized_expr).op());
+    else
+    {
+      assumption_unsupported = true;
+      property.unsupported("unsupported by word-level IC3");
+    }
+  }
+
+  for(auto &property : properties.properties)
+  {
+    if(
+      property.is_disabled() || property.is_assumed() ||
+      !property.is_unknown())
+    {
+      continue;
+    }
+
+    if(!word_level_ic3_supports_property(property.normalized_expr))
+    {
+      property.unsupported("unsupported by word-level IC3");
+      continue;
+    }
+
+    message.status() << "Checking " << property.name
+                     << " with word-level IC3" << messaget::eom;
+
+    word_level_ic3t ic3{
+      transition_system,
+      to_unary_expr(property.normalized_expr).op(),
+      assumptions,
+      solver_factory,
+      message_handler};
+
+    constexpr auto engine = "word-level IC3";
+
+    // For exists-path properties (cover), the normalized expression is
+    // the dual safety property.
+    switch(ic3())
+    {
+    case word_level_ic3t::outcomet::PROVED:
+      if(property.is_exists_path())
+        property.refuted(engine);
+      else
+        property.proved(engine);
+      break;
+
+    case word_level_ic3t::outcomet::REFUTED:
+      if(property.is_exists_path())
+        property.proved(engine);
+      else
+        property.refuted(engine);
+      property.witness_trace = std::move(ic3.trace);
+      break;
+
+    case word_level_ic3t::outcomet::INCONCLUSIVE:
+      property.inconclusive();
+      break;
+    }
+  }
+
+  // The unsupported assumptions might have prevented the counterexample.
+  if(assumption_unsupported)
+  {
+    for(auto &property : properties.properties)
+    {
+      if(property.is_refuted())
+        property.inconclusive();
+    }
+  }
+
+  return property_checker_resultt{properties};
+}
+
+property_checker_resultt word_level_ic3(
+  const cmdlinet &cmdline,
+  const transition_systemt &transition_system,
+  ebmc_propertiest &properties,
+  message_handlert &message_handler)
+{
+  if(properties.properties.empty())
+    throw ebmc_errort() << "no properties";
+
+  auto solver_factory = ebmc_solver_factory(cmdline);
+
+  return word_level_ic3(
+    transition_system, properties, solver_factory, message_handler);
+}
@@ -0,0 +1,38 @@
+/*******************************************************************\
+
+Module: Word-Level IC3
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// IC3/PDR on the word-level transition system, with implicit
+/// predicate abstraction
+
+#ifndef CPROVER_EBMC_WORD_LEVEL_IC3_H
+#define CPROVER_EBMC_WORD_LEVEL_IC3_H
+
+#include <util/cmdline.h>
+#include <util/message.h>
+
+#include "ebmc_solver_factory.h"
+#include "property_checker.h"
+
+class transition_systemt;
+class ebmc_propertiest;
+
+[[nodiscard]] property_checker_resultt word_level_ic3(
+  const cmdlinet &,
+  const transition_systemt &,
+  ebmc_propertiest &,
+  message_handlert &);
+
+// Word-level IC3 with the given solver.
+[[nodiscard]] property_checker_resultt word_level_ic3(
+  const transition_systemt &,
+  const ebmc_propertiest &,
+  const ebmc_solver_factoryt &,
+  message_handlert &);
+
+#endif // CPROVER_EBMC_WORD_LEVEL_IC3_H
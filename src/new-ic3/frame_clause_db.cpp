@@ -0,0 +1,256 @@
+/*******************************************************************\
+
+Module: IC3 Frame Clause Database
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// Storage for the frame clauses (lemmas) of IC3/PDR, with indexed
+/// subsumption queries.
+
+#include "frame_clause_db.h"
+
+#include <util/invariant.h>
+
+#include <algorithm>
+
+void frame_clause_dbt::sort(bvt &clause)
+{
+  std::sort(
+    clause.begin(),
+    clause.end(),
+    [](literalt a, literalt b) { return a.get() < b.get(); });
+}
+
+std::uint64_t frame_clause_dbt::signature(const bvt &clause)
+{
+  std::uint64_t sig = 0;
+  for(auto l : clause)
+    sig |= std::uint64_t(1) << (l.get() & 63);
+  return sig;
+}
+
+std::size_t frame_clause_dbt::new_level()
+{
+  levels.emplace_back();
+  return levels.size() - 1;
+}
+
+frame_clause_dbt::clause_idt
+frame_clause_dbt::add(const bvt &sorted_clause, std::size_t level)
+{
+  PRECONDITION(level < levels.size());
+
+  clause_idt id;
+  if(free_ids.empty())
+  {
+    id = headers.size();
+    headers.emplace_back();
+  }
+  else
+  {
+    id = free_ids.back();
+    free_ids.pop_back();
+  }
+
+  auto &h = headers[id];
+  h.signature = signature(sorted_clause);
+  h.offset = arena.size();
+  h.size = sorted_clause.size();
+  h.live = true;
+
+  arena.insert(arena.end(), sorted_clause.begin(), sorted_clause.end());
+
+  for(auto l : sorted_clause)
+  {
+    if(occurrences.size() <= l.get())
+      occurrences.resize(l.get() + 1);
+    occurrences[l.get()].push_back(id);
+  }
+
+  link_to_level(id, level);
+
+  number_of_clauses++;
+  live_literals += sorted_clause.size();
+
+  return id;
+}
+
+bool frame_clause_dbt::includes(const headert &h, const bvt &sorted_clause)
+  const
+{
+  // does the clause given by h include all literals of sorted_clause?
+  const literalt *begin = arena.data() + h.offset;
+  return std::includes(
+    begin,
+    begin + h.size,
+    sorted_clause.begin(),
+    sorted_clause.end(),
+    [](literalt a, literalt b) { return a.get() < b.get(); });
+}
+
+bool frame_clause_dbt::is_subsumed(
+  const bvt &sorted_clause,
+  std::size_t min_level) const
+{
+  const auto sig = signature(sorted_clause);
+
+  for(auto l : sorted_clause)
+  {
+    if(l.get() >= occurrences.size())
+      continue;
+
+    for(auto id : occurrences[l.get()])
+    {
+      const auto &h = headers[id];
+
+      // Each candidate is considered once only: in the list of
+      // its minimal literal.
+      if(
+        !h.live || h.level < min_level || h.size > sorted_clause.size() ||
+        (h.signature & ~sig) != 0 || arena[h.offset] != l)
+      {
+        continue;
+      }
+
+      const literalt *begin = arena.data() + h.offset;
+      if(std::includes(
+           sorted_clause.begin(),
+           sorted_clause.end(),
+           begin,
+           begin + h.size,
+           [](literalt a, literalt b) { return a.get() < b.get(); }))
+      {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+std::size_t frame_clause_dbt::remove_subsumed(
+  const bvt &sorted_clause,
+  std::size_t max_level)
+{
+  if(sorted_clause.empty())
+    return 0;
+
+  // Any clause subsumed by sorted_clause contains all of its literals.
+  // Use the shortest occurrence list.
+  const std::vector<clause_idt> *shortest = nullptr;
+
+  for(auto l : sorted_clause)
+  {
+    if(l.get() >= occurrences.size())
+      return 0; // no clause contains l
+    const auto &list = occurrences[l.get()];
+    if(shortest == nullptr || list.size() < shortest->size())
+      shortest = &list;
+  }
+
+  const auto sig = signature(sorted_clause);
+  std::size_t removed = 0;
+
+  // remove() leaves the occurrence lists alone, so iterating is safe.
+  for(auto id : *shortest)
+  {
+    const auto &h = headers[id];
+
+    if(
+      !h.live || h.level > max_level || h.size < sorted_clause.size() ||
+      (sig & ~h.signature) != 0)
+    {
+      continue;
+    }
+
+    if(includes(h, sorted_clause))
+    {
+      remove(id);
+      removed++;
+    }
+  }
+
+  return removed;
+}
+
+void frame_clause_dbt::remove(clause_idt id)
+{
+  PRECONDITION(is_live(id));
+
+  unlink_from_level(id);
+
+  auto &h = headers[id];
+  h.live = false;
+  number_of_clauses--;
+  live_literals -= h.size;
+
+  // The occurrence lists and the arena are cleaned up by
+  // collect_garbage(), which also makes the identifier available.
+}
+
+void frame_clause_dbt::set_level(clause_idt id, std::size_t level)
+{
+  PRECONDITION(is_live(id));
+  PRECONDITION(level < levels.size());
+
+  unlink_from_level(id);
+  link_to_level(id, level);
+}
+
+void frame_clause_dbt::link_to_level(clause_idt id, std::size_t level)
+{
+  auto &h = headers[id];
+  h.level = level;
+  h.position = levels[level].size();
+  levels[level].push_back(id);
+}
+
+void frame_clause_dbt::unlink_from_level(clause_idt id)
+{
+  // swap with the last entry of the level, then pop
+  const auto &h = headers[id];
+  auto &list = levels[h.level];
+  PRECONDITION(h.position < list.size() && list[h.position] == id);
+
+  auto last = list.back();
+  list[h.position] = last;
+  headers[last].position = h.position;
+  list.pop_back();
+}
+
+void frame_clause_dbt::collect_garbage()
+{
+  if(arena.size() - live_literals < live_literals)
+    return; // not worth it
+
+  std::vector<literalt> new_arena;
+  new_arena.reserve(live_literals);
+
+  for(auto &list : occurrences)
+    list.clear();
+
+  free_ids.clear();
+
+  for(clause_idt id = 0; id < headers.size(); id++)
+  {
+    auto &h = headers[id];
+
+    if(!h.live)
+    {
+      free_ids.push_back(id);
+      continue;
+    }
+
+    const literalt *begin = arena.data() + h.offset;
+    h.offset = new_arena.size();
+    new_arena.insert(new_arena.end(), begin, begin + h.size);
+
+    for(std::size_t i = h.offset; i < new_arena.size(); i++)
+      occurrences[new_arena[i].get()].push_back(id);
+  }
+
+  arena.swap(new_arena);
+}
@@ -0,0 +1,177 @@
+/*******************************************************************\
+
+Module: IC3 Frame Clause Database
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// Storage for the frame clauses (lemmas) of IC3/PDR, with indexed
+/// subsumption queries.
+
+#ifndef CPROVER_NEW_IC3_FRAME_CLAUSE_DB_H
+#define CPROVER_NEW_IC3_FRAME_CLAUSE_DB_H
+
+#include <solvers/prop/literal.h>
+
+#include <cstdint>
+#include <vector>
+
+/// The frame clauses of IC3, stored in a single contiguous arena.
+/// Each clause is kept sorted by literal code, together with a 64-bit
+/// literal-set signature and the frame level it is stored at (using
+/// the delta encoding of ic3_solvert).
+///
+/// Every literal has an occurrence list of the clauses that contain it.
+/// A clause C that subsumes a query clause Q has its minimal literal
+/// in Q, hence checking whether Q is subsumed only visits the lists of
+/// the literals of Q, skipping clauses whose minimal literal differs.
+/// Finding the clauses subsumed by Q only visits the shortest list
+/// among the literals of Q. The signatures reject most candidates
+/// without touching the arena.
+///
+/// Clause identifiers stay valid until the clause is removed. Removed
+/// clauses are reclaimed by collect_garbage(), which compacts the arena
+/// and rebuilds the occurrence lists.
+class frame_clause_dbt
+{
+public:
+  using clause_idt = std::size_t;
+
+  /// A read-only view on the literals of a clause in the arena.
+  class clause_viewt
+  {
+  public:
+    clause_viewt(const literalt *_begin, const literalt *_end)
+      : _begin(_begin), _end(_end)
+    {
+    }
+
+    const literalt *begin() const
+    {
+      return _begin;
+    }
+
+    const literalt *end() const
+    {
+      return _end;
+    }
+
+    std::size_t size() const
+    {
+      return _end - _begin;
+    }
+
+    bvt to_bvt() const
+    {
+      return bvt(_begin, _end);
+    }
+
+  protected:
+    const literalt *_begin, *_end;
+  };
+
+  /// Sort the literals of a clause into the order used by the database.
+  static void sort(bvt &);
+
+  /// The signature of a clause: each literal sets bit (code & 63).
+  static std::uint64_t signature(const bvt &);
+
+  /// Adds a new, empty level, and returns its number.
+  std::size_t new_level();
+
+  std::size_t number_of_levels() const
+  {
+    return levels.size();
+  }
+
+  /// Adds a clause, given sorted, at the given level.
+  clause_idt add(const bvt &sorted_clause, std::size_t level);
+
+  /// Returns true iff a clause stored at a level >= min_level
+  /// subsumes the given sorted clause.
+  bool is_subsumed(const bvt &sorted_clause, std::size_t min_level) const;
+
+  /// Removes all clauses stored at a level <= max_level that are
+  /// subsumed by the given sorted clause. Returns the number of
+  /// clauses removed.
+  std::size_t remove_subsumed(const bvt &sorted_clause, std::size_t max_level);
+
+  /// Removes the given clause.
+  void remove(clause_idt);
+
+  /// Moves the given clause to another level.
+  void set_level(clause_idt, std::size_t level);
+
+  bool is_live(clause_idt id) const
+  {
+    return id < headers.size() && headers[id].live;
+  }
+
+  std::size_t level(clause_idt id) const
+  {
+    return headers[id].level;
+  }
+
+  clause_viewt literals(clause_idt id) const
+  {
+    const auto &h = headers[id];
+    const literalt *begin = arena.data() + h.offset;
+    return {begin, begin + h.size};
+  }
+
+  /// The clauses stored at exactly the given level, in no particular
+  /// order. Invalidated by any modification of that level.
+  const std::vector<clause_idt> &clauses_at(std::size_t level) const
+  {
+    return levels[level];
+  }
+
+  /// Number of clauses over all levels
+  std::size_t size() const
+  {
+    return number_of_clauses;
+  }
+
+  /// Number of literals over all clauses
+  std::size_t number_of_literals() const
+  {
+    return live_literals;
+  }
+
+  /// Compacts the arena and the occurrence lists if at least half
+  /// of the arena is garbage. Clause identifiers of removed clauses
+  /// may be reused afterwards.
+  void collect_garbage();
+
+protected:
+  struct headert
+  {
+    std::uint64_t signature;
+    std::uint32_t offset, size;
+    std::size_t level;
+    // position in levels[level]
+    std::size_t position;
+    bool live;
+  };
+
+  std::vector<literalt> arena;
+  std::vector<headert> headers;
+  std::vector<clause_idt> free_ids;
+
+  // indexed by literalt::get()
+  std::vector<std::vector<clause_idt>> occurrences;
+
+  std::vector<std::vector<clause_idt>> levels;
+
+  std::size_t number_of_clauses = 0;
+  std::size_t live_literals = 0;
+
+  void unlink_from_level(clause_idt);
+  void link_to_level(clause_idt, std::size_t level);
+
+  bool includes(const headert &, const bvt &sorted_clause) const;
+};
+
+#endif // CPROVER_NEW_IC3_FRAME_CLAUSE_DB_H
@@ -0,0 +1,135 @@
+/*******************************************************************\
+
+Module: IC3 Inductive Invariants
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// Reading and writing the inductive invariants found by IC3
+
+#include "ic3_invariant.h"
+
+#include <util/message.h>
+
+#include <trans-netlist/netlist.h>
+
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <unordered_map>
+
+/// the latch bits of the netlist, by name
+static std::unordered_map<std::string, literalt>
+latch_names(const netlistt &netlist)
+{
+  std::unordered_map<std::string, literalt> result;
+
+  for(const auto &[id, var] : netlist.var_map.map)
+  {
+    if(!var.is_latch())
+      continue;
+
+    for(std::size_t bit_nr = 0; bit_nr < var.bits.size(); bit_nr++)
+    {
+      literalt l = var.bits[bit_nr].current;
+      if(!l.is_constant())
+        result.emplace(bv_varidt{id, bit_nr}.as_string(), l);
+    }
+  }
+
+  return result;
+}
+
+void write_ic3_invariants(
+  const ic3_invariantst &invariants,
+  const netlistt &netlist,
+  std::ostream &out)
+{
+  // by variable number
+  std::unordered_map<unsigned, std::pair<std::string, literalt>> names;
+  for(const auto &[name, l] : latch_names(netlist))
+    names.emplace(l.var_no(), std::make_pair(name, l));
+
+  for(const auto &[identifier, clauses] : invariants)
+  {
+    out << "property " << identifier << '\n';
+
+    for(const auto &clause : clauses)
+    {
+      bool first = true;
+      for(auto l : clause)
+      {
+        const auto &[name, latch_literal] = names.at(l.var_no());
+        if(!first)
+          out << ' ';
+        first = false;
+        if(l.sign() != latch_literal.sign())
+          out << '!';
+        out << name;
+      }
+      out << '\n';
+    }
+  }
+}
+
+ic3_invariantst read_ic3_invariants(
+  std::istream &in,
+  const netlistt &netlist,
+  message_handlert &message_handler)
+{
+  const auto names = latch_names(netlist);
+
+  ic3_invariantst result;
+  std::vector<bvt> *clauses = nullptr;
+  std::size_t dropped = 0;
+
+  std::string line;
+  while(std::getline(in, line))
+  {
+    if(line.empty())
+      continue;
+
+    if(line.compare(0, 9, "property ") == 0)
+    {
+      clauses = &result[line.substr(9)];
+      continue;
+    }
+
+    if(clauses == nullptr)
+      continue; // clause without property
+
+    std::istringstream line_stream(line);
+    std::string token;
+    bvt clause;
+    bool known = true;
+
+    while(line_stream >> token)
+    {
+      bool negated = token[0] == '!';
+      auto it = names.find(negated ? token.substr(1) : token);
+      if(it == names.end())
+      {
+        known = false;
+        break;
+      }
+      clause.push_back(it->second ^ negated);
+    }
+
+    if(known)
+      clauses->push_back(std::move(clause));
+    else
+      dropped++;
+  }
+
+  if(dropped != 0)
+  {
+    messaget message{message_handler};
+    message.warning() << "dropped " << dropped
+                      << " invariant clause(s) over unknown latches"
+                      << messaget::eom;
+  }
+
+  return result;
+}
@@ -0,0 +1,44 @@
+/*******************************************************************\
+
+Module: IC3 Inductive Invariants
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// Reading and writing the inductive invariants found by IC3
+
+#ifndef CPROVER_NEW_IC3_IC3_INVARIANT_H
+#define CPROVER_NEW_IC3_IC3_INVARIANT_H
+
+#include <util/irep.h>
+
+#include <solvers/prop/literal.h>
+
+#include <iosfwd>
+#include <map>
+#include <vector>
+
+class message_handlert;
+class netlistt;
+
+/// Inductive invariants, as clauses over the netlist literals of the
+/// latches, by property identifier
+using ic3_invariantst = std::map<irep_idt, std::vector<bvt>>;
+
+/// Writes the invariants as a clause file over the latch names.
+/// Each property starts with a line `property <identifier>`, followed
+/// by one clause per line, given by the latch bits that are separated
+/// by spaces, with a leading `!` for negation.
+void write_ic3_invariants(
+  const ic3_invariantst &,
+  const netlistt &,
+  std::ostream &);
+
+/// Reads invariants written by write_ic3_invariants.
+/// Clauses over latches that are not in the netlist are dropped.
+ic3_invariantst
+read_ic3_invariants(std::istream &, const netlistt &, message_handlert &);
+
+#endif // CPROVER_NEW_IC3_IC3_INVARIANT_H
@@ -14,6 +14,7 @@ Author: Daniel Kroening, dkr@amazon.com
 
 #include <util/invariant.h>
 
+#include <ebmc/engine_budget.h>
 #include <ic3/minisat/minisat/core/Solver.h>
 #include <solvers/sat/cnf_clause_list.h>
 #include <solvers/sat/satcheck.h>
@@ -42,33 +43,6 @@ public:
   }
 };
 
-/// A frame clause: literals sorted by literal code, plus a Bloom-style
-/// signature for constant-time subsumption rejection.
-struct ic3_solvert::frame_clauset
-{
-  clauset clause; // sorted by literalt::get()
-  // Bloom signature: each literal sets bit (lit_code & 63). 64 bits
-  // matches the register width on x86-64, giving a single-instruction
-  // shift and a cheap early-reject in subsumes().
-  uint64_t sig;
-
-  explicit frame_clauset(clauset c) : clause(std::move(c))
-  {
-    std::sort(
-      clause.begin(),
-      clause.end(),
-      [](literalt a, literalt b) { return a.get() < b.get(); });
-    sig = 0;
-    for(auto l : clause)
-      sig |= uint64_t(1) << (l.get() & 63);
-  }
-
-  bool operator==(const frame_clauset &other) const
-  {
-    return clause == other.clause;
-  }
-};
-
 clauset negate_cube(const cubet &cube)
 {
   clauset clause;
@@ -78,24 +52,6 @@ clauset negate_cube(const cubet &cube)
   return clause;
 }
 
-/// Check if clause a subsumes clause b (a ⊆ b as literal sets).
-/// Both literal vectors must be sorted by literal code.
-bool ic3_solvert::subsumes(
-  const ic3_solvert::frame_clauset &a,
-  const ic3_solvert::frame_clauset &b)
-{
-  if(a.clause.size() > b.clause.size())
-    return false;
-  if((a.sig & ~b.sig) != 0)
-    return false;
-  return std::includes(
-    b.clause.begin(),
-    b.clause.end(),
-    a.clause.begin(),
-    a.clause.end(),
-    [](literalt x, literalt y) { return x.get() < y.get(); });
-}
-
 /// Translate a (non-constant) CBMC literal to an IC3-MiniSAT literal.
 static inline IctMinisat::Lit to_minisat(literalt l)
 {
@@ -104,19 +60,34 @@ static inline IctMinisat::Lit to_minisat(literalt l)
 
 /// Add a clause of CBMC literals to an IC3-MiniSAT solver.
 /// Tautologies are skipped; false literals are dropped.
-static void add_minisat_clause(IctMinisat::Solver &S, const bvt &clause)
+static void add_minisat_clause(
+  IctMinisat::Solver &S,
+  const literalt *begin,
+  const literalt *end)
 {
   IctMinisat::vec<IctMinisat::Lit> mc;
-  for(auto l : clause)
+  for(auto it = begin; it != end; it++)
   {
-    if(l.is_true())
+    if(it->is_true())
       return;
-    if(!l.is_false())
-      mc.push(to_minisat(l));
+    if(!it->is_false())
+      mc.push(to_minisat(*it));
   }
   S.addClause(mc);
 }
 
+static void add_minisat_clause(IctMinisat::Solver &S, const bvt &clause)
+{
+  add_minisat_clause(S, clause.data(), clause.data() + clause.size());
+}
+
+static void add_minisat_clause(
+  IctMinisat::Solver &S,
+  const frame_clause_dbt::clause_viewt &clause)
+{
+  add_minisat_clause(S, clause.begin(), clause.end());
+}
+
 // ============================================================
 // ic3_solvert implementation
 // ============================================================
@@ -159,7 +130,8 @@ ic3_solvert::ic3_solvert(
           continue;
         literalt next = bmc_map.translate(0, bit.next);
         current_to_latch[current.var_no()] = latches.size();
-        latches.push_back({current, next});
+        netlist_to_latch[bit.current.var_no()] = latches.size();
+        latches.push_back({current, next, bit.current});
       }
     }
     else if(var.is_input() || var.is_nondet())
@@ -168,7 +140,10 @@ ic3_solvert::ic3_solvert(
       {
         literalt current = bmc_map.translate(0, bit.current);
         if(!current.is_constant())
+        {
           input_lits.push_back(current);
+          input_netlist_lits.push_back(bit.current);
+        }
       }
     }
   }
@@ -207,7 +182,7 @@ ic3_solvert::ic3_solvert(
   }
 
   // F_0
-  frame_clauses.emplace_back();
+  frame_clauses.new_level();
 
   messaget message{message_handler};
   message.statistics() << "IC3: " << latches.size() << " latches, "
@@ -219,26 +194,18 @@ ic3_solvert::~ic3_solvert() = default;
 
 std::size_t ic3_solvert::number_of_frames() const
 {
-  return frame_clauses.size();
+  return frame_clauses.number_of_levels();
 }
 
 std::size_t ic3_solvert::total_clauses() const
 {
-  std::size_t n = 0;
-  for(const auto &f : frame_clauses)
-    n += f.size();
-  return n;
+  return frame_clauses.size();
 }
 
 double ic3_solvert::average_clause_size() const
 {
-  std::size_t n = 0, lits = 0;
-  for(const auto &f : frame_clauses)
-    for(const auto &c : f)
-    {
-      n++;
-      lits += c.clause.size();
-    }
+  std::size_t n = frame_clauses.size();
+  std::size_t lits = frame_clauses.number_of_literals();
   return n == 0 ? 0.0 : double(lits) / double(n);
 }
 
@@ -277,9 +244,80 @@ cubet ic3_solvert::extract_state(const IctMinisat::Solver &S)
   return cube;
 }
 
+bvt ic3_solvert::extract_inputs(const IctMinisat::Solver &S) const
+{
+  bvt inputs;
+  inputs.reserve(input_lits.size());
+  for(std::size_t i = 0; i < input_lits.size(); i++)
+  {
+    auto val = S.modelValue(to_minisat(input_lits[i]));
+    if(val == IctMinisat::l_True)
+      inputs.push_back(input_netlist_lits[i]);
+    else if(val == IctMinisat::l_False)
+      inputs.push_back(!input_netlist_lits[i]);
+  }
+  return inputs;
+}
+
+bvt ic3_solvert::extract_inputs(const propt &solver) const
+{
+  bvt inputs;
+  inputs.reserve(input_lits.size());
+  for(std::size_t i = 0; i < input_lits.size(); i++)
+  {
+    auto val = solver.l_get(input_lits[i]);
+    if(val.is_true())
+      inputs.push_back(input_netlist_lits[i]);
+    else if(val.is_false())
+      inputs.push_back(!input_netlist_lits[i]);
+  }
+  return inputs;
+}
+
+bvt ic3_solvert::extract_latches(const propt &solver) const
+{
+  bvt state;
+  state.reserve(latches.size());
+  for(const auto &latch : latches)
+  {
+    if(solver.l_get(latch.current).is_true())
+      state.push_back(latch.netlist_current);
+    else
+      state.push_back(!latch.netlist_current);
+  }
+  return state;
+}
+
+bvt ic3_solvert::initial_state_in(const cubet &cube)
+{
+  auto result = init_solver->prop_solve(cube);
+  INVARIANT(
+    result == propt::resultt::P_SATISFIABLE,
+    "cube must intersect the initial states");
+
+  return extract_latches(*init_solver);
+}
+
+ic3_resultt ic3_solvert::counterexample(std::size_t node)
+{
+  bvt initial_state = initial_state_in(obligation_nodes[node].cube);
+
+  std::vector<bvt> inputs;
+  std::optional<std::size_t> n = node;
+  while(n.has_value())
+  {
+    inputs.push_back(obligation_nodes[*n].inputs);
+    n = obligation_nodes[*n].successor;
+  }
+
+  return ic3_resultt::refuted(std::move(initial_state), std::move(inputs));
+}
+
 void ic3_solvert::new_frame()
 {
-  frame_clauses.emplace_back();
+  // a good moment to reclaim the clauses removed by subsumption
+  frame_clauses.collect_garbage();
+  frame_clauses.new_level();
 }
 
 std::unique_ptr<IctMinisat::Solver> ic3_solvert::new_minisat_solver()
@@ -293,69 +331,106 @@ std::unique_ptr<IctMinisat::Solver> ic3_solvert::new_minisat_solver()
   return S;
 }
 
+/// A rough estimate of the memory used by a MiniSAT solver: the clause
+/// arena (a header word per clause, plus the literals and, for learnt
+/// clauses, the activity), and the per-variable data, including the
+/// watch lists.
+static std::size_t estimated_memory(const IctMinisat::Solver &S)
+{
+  auto clause_words = S.clauses_literals + S.learnts_literals +
+                      S.num_clauses + 2 * S.num_learnts;
+  return 4 * clause_words + 64 * std::size_t(S.nVars());
+}
+
+bool ic3_solvert::needs_recycling(
+  const IctMinisat::Solver &S,
+  std::size_t released) const
+{
+  const auto &policy = recycle_policy;
+
+  if(
+    policy.max_released_activations != 0 &&
+    released >= policy.max_released_activations)
+  {
+    return true;
+  }
+
+  if(
+    policy.max_learnt_clauses != 0 &&
+    std::size_t(S.nLearnts()) >= policy.max_learnt_clauses)
+  {
+    return true;
+  }
+
+  if(policy.max_memory != 0 && estimated_memory(S) >= policy.max_memory)
+    return true;
+
+  return false;
+}
+
 IctMinisat::Solver &ic3_solvert::get_solver(std::size_t level)
 {
   while(frame_solvers.size() <= level)
+  {
     frame_solvers.emplace_back();
+    released_activations.push_back(0);
+  }
+
   auto &fs = frame_solvers[level];
+
+  // Rebuilt below. No reference to a frame solver is held across calls
+  // to get_solver.
+  if(fs && needs_recycling(*fs, released_activations[level]))
+  {
+    fs.reset();
+    num_recycles++;
+  }
+
   if(!fs)
   {
     fs = new_minisat_solver();
+    released_activations[level] = 0;
     if(level == 0)
       for(auto l : init_units)
         add_minisat_clause(*fs, {l});
-    for(std::size_t j = level; j < frame_clauses.size(); j++)
-      for(const auto &cl : frame_clauses[j])
-        add_minisat_clause(*fs, cl.clause);
+    for(std::size_t j = level; j < frame_clauses.number_of_levels(); j++)
+      for(auto id : frame_clauses.clauses_at(j))
+        add_minisat_clause(*fs, frame_clauses.literals(id));
   }
   return *fs;
 }
 
 void ic3_solvert::add_clause(std::size_t level, const clauset &clause)
 {
-  PRECONDITION(level < frame_clauses.size());
+  PRECONDITION(level < frame_clauses.number_of_levels());
 
-  frame_clauset new_clause(clause);
+  clauset new_clause = clause;
+  frame_clause_dbt::sort(new_clause);
 
   // Redundant if subsumed by a clause at the same or a higher level.
-  for(std::size_t j = level; j < frame_clauses.size(); j++)
-    for(const auto &existing : frame_clauses[j])
-      if(subsumes(existing, new_clause))
-        return;
+  if(frame_clauses.is_subsumed(new_clause, level))
+    return;
 
   // Remove clauses the new one subsumes; they are at levels <= level,
   // where the new clause is active as well. The subsumed clauses stay
   // in already-built solvers, which is harmless.
-  for(std::size_t j = 0; j <= level; j++)
-  {
-    auto &cls = frame_clauses[j];
-    cls.erase(
-      std::remove_if(
-        cls.begin(),
-        cls.end(),
-        [&](const frame_clauset &c) { return subsumes(new_clause, c); }),
-      cls.end());
-  }
+  frame_clauses.remove_subsumed(new_clause, level);
 
   for(std::size_t i = 0; i <= level && i < frame_solvers.size(); i++)
     if(frame_solvers[i])
-      add_minisat_clause(*frame_solvers[i], new_clause.clause);
+      add_minisat_clause(*frame_solvers[i], new_clause);
 
-  frame_clauses[level].push_back(std::move(new_clause));
+  frame_clauses.add(new_clause, level);
   num_clauses_added++;
 }
 
 bool ic3_solvert::is_blocked(const cubet &cube, std::size_t level)
 {
   // The cube is blocked iff some frame clause subsumes its negation.
-  frame_clauset negated(negate_cube(cube));
-
-  for(std::size_t j = level; j < frame_clauses.size(); j++)
-    for(const auto &clause : frame_clauses[j])
-      if(subsumes(clause, negated))
-        return true;
+  clauset negated = negate_cube(cube);
+  frame_clause_dbt::sort(negated);
 
-  return false;
+  return frame_clauses.is_subsumed(negated, level);
 }
 
 bool ic3_solvert::initial_state_is_bad()
@@ -423,6 +498,14 @@ cubet ic3_solvert::lift(
   const cubet &full_state,
   const bvt &target_clause)
 {
+  // The lifting solver has the base CNF only.
+  if(needs_recycling(*lift_minisat, lift_released_activations))
+  {
+    lift_minisat = new_minisat_solver();
+    lift_released_activations = 0;
+    num_recycles++;
+  }
+
   auto &S = *lift_minisat;
   using namespace IctMinisat;
 
@@ -471,6 +554,7 @@ cubet ic3_solvert::lift(
 
   // Release activation literal (permanently set ~act, freeing the variable)
   S.releaseVar(~act);
+  lift_released_activations++;
 
   return result.empty() ? full_state : result;
 }
@@ -479,7 +563,8 @@ bool ic3_solvert::relative_induction(
   std::size_t level,
   const cubet &cube,
   cubet *predecessor,
-  bool lift_predecessor)
+  bool lift_predecessor,
+  bvt *predecessor_inputs)
 {
   // A literal with constant-false next-state function makes the cube
   // trivially unreachable; the solver's conflict would be stale.
@@ -535,6 +620,9 @@ bool ic3_solvert::relative_induction(
   }
   else if(predecessor != nullptr)
   {
+    if(predecessor_inputs != nullptr)
+      *predecessor_inputs = extract_inputs(S);
+
     cubet full_state = extract_state(S);
     if(lift_predecessor)
     {
@@ -553,21 +641,24 @@ bool ic3_solvert::relative_induction(
   {
     // Release the activation literal
     S.releaseVar(~act);
+    released_activations[level]++;
   }
 
   return unsat;
 }
 
-std::optional<cubet>
-ic3_solvert::solve_relative(std::size_t level, const cubet &cube)
+std::optional<cubet> ic3_solvert::solve_relative(
+  std::size_t level,
+  const cubet &cube,
+  bvt &inputs)
 {
   cubet predecessor;
-  if(relative_induction(level, cube, &predecessor, true))
+  if(relative_induction(level, cube, &predecessor, true, &inputs))
     return std::nullopt;
   return predecessor;
 }
 
-std::optional<cubet> ic3_solvert::solve_bad(std::size_t level)
+std::optional<cubet> ic3_solvert::solve_bad(std::size_t level, bvt &inputs)
 {
   if(prop_current.is_true())
     return std::nullopt;
@@ -581,6 +672,7 @@ std::optional<cubet> ic3_solvert::solve_bad(std::size_t level)
   num_queries++;
   if(S.solve(assumptions))
   {
+    inputs = extract_inputs(S);
     // Lift against the property: act -> prop
     return lift(S, extract_state(S), {prop_current});
   }
@@ -615,7 +707,8 @@ bool ic3_solvert::ctg_down(
       relative_induction(level, predecessor, nullptr, false))
     {
       add_clause(
-        std::min(level + 1, frame_clauses.size() - 1), negate_cube(core));
+        std::min(level + 1, frame_clauses.number_of_levels() - 1),
+        negate_cube(core));
       ctg_budget--;
       continue;
     }
@@ -696,25 +789,26 @@ cubet ic3_solvert::generalize(std::size_t level, cubet cube)
   return cube;
 }
 
-bool ic3_solvert::propagate()
+std::optional<std::size_t> ic3_solvert::propagate()
 {
-  for(std::size_t i = 1; i + 1 < frame_clauses.size(); i++)
+  for(std::size_t i = 1; i + 1 < frame_clauses.number_of_levels(); i++)
   {
-    // The clauses of F_i's delta; a copy, since pushing mutates the frame.
-    auto clauses = frame_clauses[i];
+    // The clauses of F_i's delta; a copy of the identifiers, since
+    // pushing mutates the level.
+    auto clauses = frame_clauses.clauses_at(i);
 
-    for(const auto &fc : clauses)
+    for(auto id : clauses)
     {
       // The clause itself is in the level-i solver already, so the
       // query F_i ∧ T ∧ cube' needs no activation literal.
       auto &S = get_solver(i);
-      cubet cube = negate_cube(fc.clause);
 
       bool trivially_unsat = false;
       IctMinisat::vec<IctMinisat::Lit> assumptions;
-      for(auto l : cube)
+      for(auto l : frame_clauses.literals(id))
       {
-        literalt nl = to_next(l);
+        // the cube is the negated clause
+        literalt nl = to_next(!l);
         if(nl.is_false())
         {
           trivially_unsat = true;
@@ -729,22 +823,207 @@ bool ic3_solvert::propagate()
       {
         // Holds at F_{i+1}: move the delta entry up. The solvers at
         // levels <= i contain the clause already; only level i+1 needs it.
-        auto &cls = frame_clauses[i];
-        auto it = std::find(cls.begin(), cls.end(), fc);
-        if(it != cls.end())
-          cls.erase(it);
+        frame_clauses.set_level(id, i + 1);
 
         if(i + 1 < frame_solvers.size() && frame_solvers[i + 1])
-          add_minisat_clause(*frame_solvers[i + 1], fc.clause);
-        frame_clauses[i + 1].push_back(fc);
+        {
+          add_minisat_clause(
+            *frame_solvers[i + 1], frame_clauses.literals(id));
+        }
       }
     }
 
-    if(frame_clauses[i].empty())
-      return true; // F_i = F_{i+1}: inductive invariant found
+    if(frame_clauses.clauses_at(i).empty())
+      return i; // F_i = F_{i+1}: inductive invariant found
   }
 
-  return false;
+  return {};
+}
+
+std::vector<bvt> ic3_solvert::invariant(std::size_t level) const
+{
+  std::vector<bvt> result;
+
+  for(std::size_t j = level; j < frame_clauses.number_of_levels(); j++)
+    for(auto id : frame_clauses.clauses_at(j))
+      result.push_back(netlist_clause(frame_clauses.literals(id)));
+
+  return result;
+}
+
+bvt ic3_solvert::netlist_clause(frame_clause_dbt::clause_viewt clause) const
+{
+  bvt result;
+
+  for(auto l : clause)
+  {
+    const auto &latch = latches[current_to_latch.at(l.var_no())];
+    result.push_back(
+      latch.netlist_current ^ (l.sign() != latch.current.sign()));
+  }
+
+  return result;
+}
+
+std::optional<clauset> ic3_solvert::solver_clause(const bvt &clause) const
+{
+  clauset result;
+
+  for(auto l : clause)
+  {
+    auto it = netlist_to_latch.find(l.var_no());
+    if(it == netlist_to_latch.end())
+      return {};
+    const auto &latch = latches[it->second];
+    result.push_back(
+      latch.current ^ (l.sign() != latch.netlist_current.sign()));
+  }
+
+  return result;
+}
+
+std::vector<ic3_solvert::frame_clauset> ic3_solvert::frames() const
+{
+  std::vector<frame_clauset> result;
+
+  for(std::size_t j = 0; j < frame_clauses.number_of_levels(); j++)
+    for(auto id : frame_clauses.clauses_at(j))
+      result.emplace_back(j, netlist_clause(frame_clauses.literals(id)));
+
+  return result;
+}
+
+void ic3_solvert::restore_frames(
+  std::size_t number_of_levels,
+  const std::vector<frame_clauset> &clauses)
+{
+  PRECONDITION(number_of_frames() == 1);
+
+  while(number_of_frames() < number_of_levels)
+    new_frame();
+
+  std::size_t restored = 0;
+
+  for(const auto &[level, clause] : clauses)
+  {
+    auto translated = solver_clause(clause);
+    if(translated.has_value() && level < number_of_levels)
+    {
+      add_clause(level, *translated);
+      restored++;
+    }
+  }
+
+  messaget message{message_handler};
+  message.statistics() << "IC3: restored " << number_of_levels
+                       << " frames with " << restored << " clauses"
+                       << messaget::eom;
+}
+
+std::size_t ic3_solvert::seed(const std::vector<bvt> &candidates)
+{
+  PRECONDITION(number_of_frames() == 1);
+
+  // translate into solver literals
+  std::vector<clauset> clauses;
+  for(const auto &candidate : candidates)
+  {
+    auto clause = solver_clause(candidate);
+
+    // Must hold initially.
+    if(clause.has_value() && !init_intersects(negate_cube(*clause)))
+      clauses.push_back(std::move(*clause));
+  }
+
+  // Houdini: drop the clauses that are not preserved by a transition
+  // from the conjunction of the remaining ones, until none is dropped.
+  auto S = new_minisat_solver();
+  std::vector<IctMinisat::Lit> acts;
+  acts.reserve(clauses.size());
+  for(const auto &clause : clauses)
+  {
+    auto act = IctMinisat::mkLit(S->newVar());
+    IctMinisat::vec<IctMinisat::Lit> act_clause;
+    act_clause.push(~act);
+    for(auto l : clause)
+      act_clause.push(to_minisat(l));
+    S->addClause(act_clause);
+    acts.push_back(act);
+  }
+
+  std::vector<bool> alive(clauses.size(), true);
+
+  bool changed = true;
+  while(changed)
+  {
+    changed = false;
+
+    for(std::size_t i = 0; i < clauses.size(); i++)
+    {
+      if(!alive[i])
+        continue;
+
+      IctMinisat::vec<IctMinisat::Lit> assumptions;
+      for(std::size_t j = 0; j < clauses.size(); j++)
+        if(alive[j])
+          assumptions.push(acts[j]);
+
+      // the negation of clause i in the next state
+      bool trivially_unsat = false;
+      for(auto l : clauses[i])
+      {
+        literalt nl = to_next(!l);
+        if(nl.is_false())
+        {
+          trivially_unsat = true;
+          break;
+        }
+        if(!nl.is_true())
+          assumptions.push(to_minisat(nl));
+      }
+
+      num_queries++;
+      if(trivially_unsat || !S->solve(assumptions))
+        continue;
+
+      // The model may violate further clauses in the next state.
+      for(std::size_t j = 0; j < clauses.size(); j++)
+      {
+        if(!alive[j])
+          continue;
+        bool satisfied = false;
+        for(auto l : clauses[j])
+        {
+          literalt nl = to_next(l);
+          if(
+            nl.is_true() ||
+            (!nl.is_false() &&
+             S->modelValue(to_minisat(nl)) != IctMinisat::l_False))
+          {
+            satisfied = true;
+          }
+        }
+        if(!satisfied)
+          alive[j] = false;
+      }
+
+      alive[i] = false;
+      changed = true;
+    }
+  }
+
+  seed_clauses.clear();
+  for(std::size_t i = 0; i < clauses.size(); i++)
+    if(alive[i])
+      seed_clauses.push_back(std::move(clauses[i]));
+
+  messaget message{message_handler};
+  message.statistics() << "IC3: " << seed_clauses.size() << " of "
+                       << candidates.size()
+                       << " seeded invariant clauses are inductive"
+                       << messaget::eom;
+
+  return seed_clauses.size();
 }
 
 // ============================================================
@@ -759,6 +1038,8 @@ struct proof_obligationt
   // Number of transitions from this cube to the property-violating
   // state; used for the counterexample length when refuting.
   std::size_t depth;
+  // the node in the obligation chain, for the counterexample
+  std::size_t node;
 
   bool operator>(const proof_obligationt &other) const
   {
@@ -776,18 +1057,31 @@ ic3_resultt ic3_solvert::solve()
   if(initial_state_is_bad())
   {
     message.status() << "Property violated in initial state" << messaget::eom;
-    return ic3_resultt::refuted(1);
+    // initial_state_is_bad() leaves the model in the init solver
+    return ic3_resultt::refuted(
+      extract_latches(*init_solver), {extract_inputs(*init_solver)});
   }
 
   while(true)
   {
+    cancellation_point();
+
     new_frame();
     std::size_t k = number_of_frames() - 1;
 
+    // The seeded clauses are inductive, and hold in F_1.
+    if(k == 1)
+    {
+      for(const auto &clause : seed_clauses)
+        add_clause(1, clause);
+      seed_clauses.clear();
+    }
+
     message.progress() << "IC3: frame " << k << " (" << num_queries
                        << " queries, " << num_lifts << " lifts, "
                        << total_clauses() << " clauses, avg size "
-                       << average_clause_size() << ")" << messaget::eom;
+                       << average_clause_size() << ", " << num_recycles
+                       << " solver rebuilds)" << messaget::eom;
 
     std::priority_queue<
       proof_obligationt,
@@ -798,15 +1092,21 @@ ic3_resultt ic3_solvert::solve()
     // Blocking phase
     while(true)
     {
-      auto bad_cube = solve_bad(k);
+      bvt bad_inputs;
+      auto bad_cube = solve_bad(k, bad_inputs);
       if(!bad_cube.has_value())
         break;
 
-      obligations.push({bad_cube.value(), k, 0});
+      // the chain is only needed while the obligations are pending
+      obligation_nodes.clear();
+      obligation_nodes.push_back({bad_cube.value(), std::move(bad_inputs), {}});
+      obligations.push({bad_cube.value(), k, 0, 0});
 
       while(!obligations.empty())
       {
-        auto [cube, level, depth] = obligations.top();
+        cancellation_point();
+
+        auto [cube, level, depth, node] = obligations.top();
         obligations.pop();
 
         if(is_blocked(cube, level))
@@ -818,7 +1118,7 @@ ic3_resultt ic3_solvert::solve()
           // depth transitions away: depth + 1 states in total.
           message.status() << "Property refuted with counterexample of length "
                            << depth + 1 << messaget::eom;
-          return ic3_resultt::refuted(depth + 1);
+          return counterexample(node);
         }
 
         if(level == 0)
@@ -827,11 +1127,14 @@ ic3_resultt ic3_solvert::solve()
           continue;
         }
 
-        auto pred = solve_relative(level - 1, cube);
+        bvt inputs;
+        auto pred = solve_relative(level - 1, cube, inputs);
         if(pred.has_value())
         {
-          obligations.push({pred.value(), level - 1, depth + 1});
-          obligations.push({std::move(cube), level, depth});
+          auto pred_node = obligation_nodes.size();
+          obligation_nodes.push_back({pred.value(), std::move(inputs), node});
+          obligations.push({pred.value(), level - 1, depth + 1, pred_node});
+          obligations.push({std::move(cube), level, depth, node});
         }
         else
         {
@@ -840,21 +1143,26 @@ ic3_resultt ic3_solvert::solve()
 
           // Re-queue at level+1 to push the blocking clause higher
           if(level + 1 <= k)
-            obligations.push({std::move(cube), level + 1, depth});
+            obligations.push({std::move(cube), level + 1, depth, node});
         }
       }
     } // end blocking phase
 
     // Propagation: push clauses from F_i to F_{i+1}
-    if(propagate())
+    auto converged = propagate();
+    if(converged.has_value())
     {
       auto end_time = std::chrono::steady_clock::now();
       message.status()
         << "IC3: converged at frame " << k << " in " << std::fixed
         << std::setprecision(3)
         << std::chrono::duration<double>(end_time - start_time).count()
-        << " seconds (" << num_queries << " queries)" << messaget::eom;
-      return ic3_resultt::proved();
+        << " seconds (" << num_queries << " queries, " << num_recycles
+        << " solver rebuilds)" << messaget::eom;
+      return ic3_resultt::proved(invariant(*converged));
     }
+
+    if(frame_callback)
+      frame_callback(*this);
   }
 }
@@ -17,6 +17,9 @@ Author: Daniel Kroening, dkr@amazon.com
 #include <solvers/sat/satcheck.h>
 #include <trans-netlist/netlist.h>
 
+#include "frame_clause_db.h"
+
+#include <functional>
 #include <memory>
 #include <optional>
 #include <unordered_map>
@@ -56,23 +59,56 @@ struct ic3_resultt
   /// state before a minimal-length one is explored.
   std::size_t counterexample_length = 0;
 
-  static ic3_resultt proved()
+  /// When REFUTED, the counterexample, as netlist literals that are
+  /// true: the values of the latches in the initial state, and the
+  /// values of the inputs for each of the counterexample_length
+  /// timeframes. All other values follow by simulating the netlist.
+  bvt initial_state;
+  std::vector<bvt> inputs;
+
+  /// When PROVED, an inductive invariant that implies the property,
+  /// as clauses over the netlist literals of the latches.
+  std::vector<bvt> invariant;
+
+  static ic3_resultt proved(std::vector<bvt> invariant)
   {
-    return {outcomet::PROVED, 0};
+    return {outcomet::PROVED, 0, {}, {}, std::move(invariant)};
   }
 
-  static ic3_resultt refuted(std::size_t counterexample_length)
+  static ic3_resultt refuted(bvt initial_state, std::vector<bvt> inputs)
   {
-    return {outcomet::REFUTED, counterexample_length};
+    auto counterexample_length = inputs.size();
+    return {
+      outcomet::REFUTED,
+      counterexample_length,
+      std::move(initial_state),
+      std::move(inputs),
+      {}};
   }
 };
 
+/// When to rebuild a frame solver from the base CNF and the current
+/// frame clauses. Rebuilding discards the learnt clauses, the variables
+/// of released activation literals, and the clauses that have since
+/// been subsumed. A threshold of zero disables the criterion.
+struct ic3_recycle_policyt
+{
+  // activation literals released since the solver was built
+  std::size_t max_released_activations = 20000;
+
+  // learnt clauses currently held by the solver
+  std::size_t max_learnt_clauses = 100000;
+
+  // estimated size of the solver, in bytes
+  std::size_t max_memory = std::size_t(512) << 20;
+};
+
 /// The IC3 solver uses per-frame SAT solvers via CNF replay.
 /// The netlist is encoded once into a cnf_clause_listt, then replayed
 /// into each per-frame solver. The per-frame solvers use IC3's MiniSAT,
-/// whose releaseVar allows disposable activation literals without
-/// unbounded solver growth, and keep their learnt clauses for the
-/// whole run.
+/// whose releaseVar allows disposable activation literals. The
+/// per-frame solvers keep their learnt clauses until the recycling
+/// policy triggers a rebuild.
 ///
 /// Frames are kept as deltas: a clause stored at level j holds in
 /// F_i for all i <= j, and the solver for level i contains the
@@ -92,37 +128,86 @@ public:
   /// the result includes the length of the counterexample trace.
   ic3_resultt solve();
 
-private:
-  message_handlert &message_handler;
+  /// Offer candidate invariant clauses over the netlist literals of
+  /// the latches, e.g., the invariant of an earlier run on a modified
+  /// design. The largest subset of the candidates that holds initially
+  /// and is inductive is added to the first frame, from where
+  /// propagation pushes it. Candidates with unknown literals are
+  /// ignored. Must be called before solve(); returns the number of
+  /// clauses kept.
+  std::size_t seed(const std::vector<bvt> &candidates);
+
+  void set_recycle_policy(const ic3_recycle_policyt &_recycle_policy)
+  {
+    recycle_policy = _recycle_policy;
+  }
+
+  /// A frame clause, with the level it is stored at, over the netlist
+  /// literals of the latches
+  using frame_clauset = std::pair<std::size_t, bvt>;
+
+  /// The frame clauses, e.g., for a checkpoint
+  std::vector<frame_clauset> frames() const;
+
+  /// Recreates the given number of frames with the frame clauses
+  /// of an earlier run on the same netlist and property, as returned
+  /// by frames(). Must be called before solve().
+  void restore_frames(
+    std::size_t number_of_levels,
+    const std::vector<frame_clauset> &);
+
+  /// Called by solve() at the end of each frame that does not converge
+  void set_frame_callback(std::function<void(const ic3_solvert &)> callback)
+  {
+    frame_callback = std::move(callback);
+  }
 
-  struct frame_clauset;
+  std::size_t number_of_frames() const;
 
-  static bool subsumes(const frame_clauset &a, const frame_clauset &b);
+private:
+  message_handlert &message_handler;
 
   bool initial_state_is_bad();
-  std::optional<cubet> solve_relative(std::size_t level, const cubet &);
-  std::optional<cubet> solve_bad(std::size_t level);
+  std::optional<cubet>
+  solve_relative(std::size_t level, const cubet &, bvt &inputs);
+  std::optional<cubet> solve_bad(std::size_t level, bvt &inputs);
   cubet generalize(std::size_t level, cubet cube);
   bool init_intersects(const cubet &);
   bool is_blocked(const cubet &, std::size_t level);
   void add_clause(std::size_t level, const clauset &clause);
   void new_frame();
-  std::size_t number_of_frames() const;
-  bool propagate();
+  std::optional<std::size_t> propagate();
+
+  // clauses from seed(), over solver literals
+  std::vector<clauset> seed_clauses;
+
+  std::function<void(const ic3_solvert &)> frame_callback;
+
+  // the clauses of F_i, over netlist literals
+  std::vector<bvt> invariant(std::size_t level) const;
+
+  // translates between the solver and the netlist literals of the
+  // latches; solver_clause is empty when a literal is not a latch
+  bvt netlist_clause(frame_clause_dbt::clause_viewt) const;
+  std::optional<clauset> solver_clause(const bvt &) const;
 
   cubet core;
 
   std::size_t num_queries = 0, num_lifts = 0, num_clauses_added = 0;
+  std::size_t num_recycles = 0;
   std::size_t total_clauses() const;
   double average_clause_size() const;
 
   struct latch_infot
   {
     literalt current, next;
+    // the current-state literal in the netlist, for counterexamples
+    literalt netlist_current;
   };
 
   std::vector<latch_infot> latches;
   std::unordered_map<unsigned, std::size_t> current_to_latch;
+  std::unordered_map<unsigned, std::size_t> netlist_to_latch;
 
   null_message_handlert solver_message_handler;
 
@@ -137,12 +222,19 @@ private:
   bool init_is_unique_state = false;
 
   std::unique_ptr<IctMinisat::Solver> lift_minisat;
+  std::size_t lift_released_activations = 0;
 
   bvt input_lits;
+  bvt input_netlist_lits; // parallel to input_lits
 
   std::vector<std::unique_ptr<IctMinisat::Solver>> frame_solvers;
+  // parallel to frame_solvers
+  std::vector<std::size_t> released_activations;
 
-  std::vector<std::vector<frame_clauset>> frame_clauses;
+  ic3_recycle_policyt recycle_policy;
+  bool needs_recycling(const IctMinisat::Solver &, std::size_t released) const;
+
+  frame_clause_dbt frame_clauses;
 
   std::unique_ptr<IctMinisat::Solver> new_minisat_solver();
 
@@ -165,6 +257,31 @@ private:
 
   cubet extract_state(const IctMinisat::Solver &);
 
+  // the input values, as true netlist literals
+  bvt extract_inputs(const IctMinisat::Solver &) const;
+  bvt extract_inputs(const propt &) const;
+
+  // the latch values, as true netlist literals
+  bvt extract_latches(const propt &) const;
+
+  // a full initial state within the given cube, as true netlist literals
+  bvt initial_state_in(const cubet &);
+
+  /// The chain of proof obligations that leads to the bad states.
+  /// From any state in the cube of a node, the inputs of the node lead
+  /// into the cube of the successor node, or, when there is none, to a
+  /// violation of the property.
+  struct obligation_nodet
+  {
+    cubet cube;
+    bvt inputs;
+    std::optional<std::size_t> successor;
+  };
+
+  std::vector<obligation_nodet> obligation_nodes;
+
+  ic3_resultt counterexample(std::size_t node);
+
   cubet lift(
     const IctMinisat::Solver &query_solver,
     const cubet &full_state,
@@ -174,7 +291,8 @@ private:
     std::size_t level,
     const cubet &cube,
     cubet *predecessor,
-    bool lift_predecessor);
+    bool lift_predecessor,
+    bvt *predecessor_inputs = nullptr);
 
   void repair_init(const cubet &cube, cubet &reduced);
 
@@ -15,19 +15,31 @@ Author: Daniel Kroening, dkr@amazon.com
 
 #include "new_ic3_engine.h"
 
+#include <util/string2int.h>
+#include <util/unicode.h>
+
+#include <ebmc/checkpoint.h>
+#include <ebmc/coi_hash.h>
 #include <ebmc/ebmc_error.h>
 #include <ebmc/liveness_to_safety.h>
 #include <ebmc/netlist.h>
 #include <ebmc/report_results.h>
+#include <solvers/sat/satcheck.h>
 #include <temporal-logic/ctl.h>
 #include <temporal-logic/ltl.h>
 #include <temporal-logic/temporal_logic.h>
 #include <trans-netlist/aig_prop.h>
 #include <trans-netlist/instantiate_netlist.h>
+#include <trans-netlist/trans_trace_netlist.h>
+#include <trans-netlist/unwind_netlist.h>
 #include <verilog/sva_expr.h>
 
+#include "ic3_invariant.h"
 #include "ic3_solver.h"
 
+#include <fstream>
+#include <sstream>
+
 static bool new_ic3_supports_property(const exprt &expr)
 {
   if(!is_temporal_operator(expr))
@@ -41,6 +53,143 @@ static bool new_ic3_supports_property(const exprt &expr)
   return false;
 }
 
+/// Turns the initial state and the inputs of an IC3 counterexample
+/// into a trace. All inputs and the initial state are fixed, so the
+/// solver only needs to propagate.
+static std::optional<trans_tracet> ic3_trace(
+  const netlistt &netlist,
+  literalt prop_lit,
+  const ic3_resultt &result,
+  const namespacet &ns,
+  message_handlert &message_handler)
+{
+  const std::size_t no_timeframes = result.inputs.size();
+
+  satcheckt solver{message_handler};
+  const auto bmc_map = bmc_mapt{netlist, no_timeframes, solver};
+
+  messaget message{message_handler};
+  ::unwind(netlist, bmc_map, message, solver);
+
+  for(auto l : result.initial_state)
+    solver.l_set_to_true(bmc_map.translate(0, l));
+
+  for(std::size_t t = 0; t < no_timeframes; t++)
+    for(auto l : result.inputs[t])
+      solver.l_set_to_true(bmc_map.translate(t, l));
+
+  bvt prop_bv;
+  prop_bv.reserve(no_timeframes);
+  for(std::size_t t = 0; t < no_timeframes; t++)
+    prop_bv.push_back(bmc_map.translate(t, prop_lit));
+
+  // the property must fail in the last timeframe
+  solver.l_set_to_false(prop_bv.back());
+
+  if(solver.prop_solve() != propt::resultt::P_SATISFIABLE)
+  {
+    message.warning() << "failed to replay IC3 counterexample"
+                      << messaget::eom;
+    return {};
+  }
+
+  return compute_trans_trace(prop_bv, bmc_map, solver, ns);
+}
+
+static std::size_t
+size_option(const cmdlinet &cmdline, const char *option, std::size_t value)
+{
+  if(!cmdline.isset(option))
+    return value;
+
+  auto value_opt = string2optional_size_t(cmdline.get_value(option));
+
+  if(!value_opt.has_value())
+    throw ebmc_errort() << "failed to parse --" << option;
+
+  return *value_opt;
+}
+
+static ic3_recycle_policyt recycle_policy(const cmdlinet &cmdline)
+{
+  ic3_recycle_policyt policy;
+
+  policy.max_released_activations = size_option(
+    cmdline, "ic3-recycle-activations", policy.max_released_activations);
+
+  policy.max_learnt_clauses =
+    size_option(cmdline, "ic3-recycle-learnts", policy.max_learnt_clauses);
+
+  // given in megabytes
+  policy.max_memory =
+    size_option(cmdline, "ic3-recycle-memory", policy.max_memory >> 20) << 20;
+
+  return policy;
+}
+
+/// The engine state of a checkpoint: the property that is being
+/// checked, the number of frames, and the frame clauses, with the
+/// literals given by their codes.
+static std::vector<std::string>
+ic3_checkpoint_state(const irep_idt &identifier, const ic3_solvert &solver)
+{
+  std::vector<std::string> state;
+
+  state.push_back("property " + id2string(identifier));
+  state.push_back("frames " + std::to_string(solver.number_of_frames()));
+
+  for(const auto &[level, clause] : solver.frames())
+  {
+    std::string line = "clause " + std::to_string(level);
+    for(auto l : clause)
+      line += ' ' + std::to_string(l.get());
+    state.push_back(std::move(line));
+  }
+
+  return state;
+}
+
+/// Restores the frames of the checkpoint, if it is for the given
+/// property. Returns true if so.
+static bool restore_ic3_frames(
+  const std::vector<std::string> &state,
+  const irep_idt &identifier,
+  ic3_solvert &solver)
+{
+  if(state.empty() || state.front() != "property " + id2string(identifier))
+    return false;
+
+  std::size_t number_of_frames = 0;
+  std::vector<ic3_solvert::frame_clauset> clauses;
+
+  for(const auto &line : state)
+  {
+    std::istringstream in(line);
+    std::string keyword;
+    in >> keyword;
+
+    if(keyword == "frames")
+      in >> number_of_frames;
+    else if(keyword == "clause")
+    {
+      std::size_t level;
+      in >> level;
+      bvt clause;
+      unsigned code;
+      while(in >> code)
+        clause.push_back(literalt(code >> 1, code & 1));
+      clauses.emplace_back(level, std::move(clause));
+    }
+  }
+
+  if(number_of_frames < 2)
+    return false;
+
+  solver.restore_frames(number_of_frames, clauses);
+
+  return true;
+}
+
 property_checker_resultt new_ic3_engine(
   const cmdlinet &cmdline,
   transition_systemt &transition_system,
@@ -75,6 +224,34 @@ property_checker_resultt new_ic3_engine(
                        << ", nodes: " << netlist.number_of_nodes()
                        << messaget::eom;
 
+  const auto policy = recycle_policy(cmdline);
+
+  std::optional<checkpointert> checkpointer;
+
+  if(has_checkpoint_options(cmdline))
+  {
+    checkpointer.emplace(
+      cmdline, "new-ic3", netlist_hash(netlist), message_handler);
+    checkpointer->restore_results(properties);
+  }
+
+  // invariants from an earlier run, to seed IC3 with
+  ic3_invariantst seed_invariants;
+
+  if(cmdline.isset("read-invariant"))
+  {
+    const auto file_name = cmdline.get_value("read-invariant");
+    std::ifstream in{widen_if_needed(file_name)};
+
+    if(!in)
+      throw ebmc_errort{}.with_exit_code(1) << "failed to open " << file_name;
+
+    seed_invariants = read_ic3_invariants(in, netlist, message_handler);
+  }
+
+  // the invariants of the proved properties
+  ic3_invariantst invariants;
+
   for(auto &property : properties.properties)
   {
     if(property.is_disabled() || !property.is_unknown())
@@ -104,6 +281,32 @@ property_checker_resultt new_ic3_engine(
     }();
 
     ic3_solvert solver{prop_netlist, prop_lit, message_handler};
+    solver.set_recycle_policy(policy);
+
+    // the frames of a checkpoint take the place of the seed
+    bool restored = checkpointer.has_value() &&
+                    restore_ic3_frames(
+                      checkpointer->resumed_state(),
+                      property.identifier,
+                      solver);
+
+    auto seed_it = seed_invariants.find(property.identifier);
+    if(!restored && seed_it != seed_invariants.end())
+      solver.seed(seed_it->second);
+
+    if(checkpointer.has_value())
+    {
+      solver.set_frame_callback(
+        [&checkpointer, &properties, &property](const ic3_solvert &s)
+        {
+          if(checkpointer->is_due())
+          {
+            checkpointer->save(
+              properties, ic3_checkpoint_state(property.identifier, s));
+          }
+        });
+    }
+
     auto result = solver.solve();
 
     // record the outcome produced by this engine
@@ -119,14 +322,31 @@ property_checker_resultt new_ic3_engine(
         property.refuted(engine);
       else
         property.proved(engine);
+      invariants[property.identifier] = std::move(result.invariant);
       break;
     case ic3_resultt::outcomet::REFUTED:
       if(property.is_exists_path())
         property.proved(engine);
       else
         property.refuted(engine);
+      property.witness_trace =
+        ic3_trace(prop_netlist, prop_lit, result, ns, message_handler);
       break;
     }
+
+    if(checkpointer.has_value() && checkpointer->is_due())
+      checkpointer->save(properties, {});
+  }
+
+  if(cmdline.isset("write-invariant"))
+  {
+    const auto file_name = cmdline.get_value("write-invariant");
+    std::ofstream out{widen_if_needed(file_name)};
+
+    if(!out)
+      throw ebmc_errort{}.with_exit_code(1) << "failed to open " << file_name;
+
+    write_ic3_invariants(invariants, netlist, out);
   }
 
   return property_checker_resultt{properties};
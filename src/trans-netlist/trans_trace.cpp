@@ -276,6 +276,53 @@ Function: json
 
 \*******************************************************************/
 
+std::optional<json_objectt> json(
+  const trans_tracet::statet::assignmentt &a,
+  const namespacet &ns)
+{
+  DATA_INVARIANT(a.lhs.id() == ID_symbol, "assignment lhs must be symbol");
+  const symbolt &symbol = ns.lookup(to_symbol_expr(a.lhs));
+
+  if(symbol.is_auxiliary)
+    return {}; // drop
+
+  json_objectt json_assignment;
+
+  std::string lhs_string = from_expr(ns, symbol.name, a.lhs);
+
+  std::string value_string =
+    a.rhs.is_nil() ? "" : from_expr(ns, symbol.name, a.rhs);
+
+  std::string type_string = from_type(ns, symbol.name, symbol.type);
+
+  json_assignment["lhs"] = json_stringt(lhs_string);
+  json_assignment["identifier"] = json_stringt(id2string(symbol.name));
+  json_assignment["base_name"] = json_stringt(id2string(symbol.base_name));
+  json_assignment["display_name"] =
+    json_stringt(id2string(symbol.display_name()));
+  json_assignment["value"] = json_stringt(value_string);
+  json_assignment["lhs_type"] = json_stringt(type_string);
+  json_assignment["mode"] = json_stringt(id2string(symbol.mode));
+  json_assignment["state_var"] = jsont::json_boolean(symbol.is_state_var);
+
+  if(a.location.is_not_nil())
+    json_assignment["location"] = json(a.location);
+
+  return json_assignment;
+}
+
+/*******************************************************************\
+
+Function: json
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
 jsont json(const trans_tracet &trace, const namespacet &ns)
 {
   json_objectt json_trace;
@@ -289,35 +336,10 @@ jsont json(const trans_tracet &trace, const namespacet &ns)
 
     for(const auto &a : state.assignments)
     {
-      json_objectt json_assignment;
-
-      DATA_INVARIANT(a.lhs.id() == ID_symbol, "assignment lhs must be symbol");
-      const symbolt &symbol = ns.lookup(to_symbol_expr(a.lhs));
-
-      if(symbol.is_auxiliary)
-        continue; // drop
-
-      std::string lhs_string = from_expr(ns, symbol.name, a.lhs);
-
-      std::string value_string =
-        a.rhs.is_nil() ? "" : from_expr(ns, symbol.name, a.rhs);
-
-      std::string type_string = from_type(ns, symbol.name, symbol.type);
-
-      json_assignment["lhs"] = json_stringt(lhs_string);
-      json_assignment["identifier"] = json_stringt(id2string(symbol.name));
-      json_assignment["base_name"] = json_stringt(id2string(symbol.base_name));
-      json_assignment["display_name"] =
-        json_stringt(id2string(symbol.display_name()));
-      json_assignment["value"] = json_stringt(value_string);
-      json_assignment["lhs_type"] = json_stringt(type_string);
-      json_assignment["mode"] = json_stringt(id2string(symbol.mode));
-      json_assignment["state_var"] = jsont::json_boolean(symbol.is_state_var);
-
-      if(a.location.is_not_nil())
-        json_assignment["location"] = json(a.location);
+      auto json_assignment = json(a, ns);
 
-      json_assignments.push_back(std::move(json_assignment));
+      if(json_assignment.has_value())
+        json_assignments.push_back(std::move(*json_assignment));
     }
 
     json_states.push_back(std::move(json_assignments));
@@ -14,7 +14,10 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/threeval.h>
 #include <util/ui_message.h>
 
+#include <optional>
+
 class jsont;
+class json_objectt;
 
 class trans_tracet
 {
@@ -68,6 +71,10 @@ public:
 
 jsont json(const trans_tracet &, const namespacet &);
 
+// empty for the assignments to auxiliary symbols
+std::optional<json_objectt>
+json(const trans_tracet::statet::assignmentt &, const namespacet &);
+
 xmlt xml(const trans_tracet &, const namespacet &);
 
 void show_trans_trace(
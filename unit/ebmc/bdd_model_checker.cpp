@@ -13,7 +13,7 @@ Author: Daniel Kroening, kroening@kroening.com
 /// States: s=0 and s=1.
 /// Transition: s always goes to !s (toggle).
 /// No constraints.
-static bdd_transition_relationt make_toggle_system(mini_bdd_mgrt &mgr)
+static bdd_transition_relationt make_toggle_system(ebmc_bdd_mgrt &mgr)
 {
   auto s = mgr.Var("s");
   auto s_next = mgr.Var("s'");
@@ -34,7 +34,7 @@ static bdd_transition_relationt make_toggle_system(mini_bdd_mgrt &mgr)
 ///   (1,0) -> (1,1)
 ///   (1,1) -> (1,0)
 /// So (0,0) is absorbing, and {(1,0),(1,1)} form a cycle.
-static bdd_transition_relationt make_counter_system(mini_bdd_mgrt &mgr)
+static bdd_transition_relationt make_counter_system(ebmc_bdd_mgrt &mgr)
 {
   auto s0 = mgr.Var("s0");
   auto s1 = mgr.Var("s1");
@@ -54,7 +54,7 @@ static bdd_transition_relationt make_counter_system(mini_bdd_mgrt &mgr)
 /// Transition: next(s) = i.
 /// The input is unconstrained, so every current state has a successor with
 /// s=1 and a successor with s=0.
-static bdd_transition_relationt make_input_driven_system(mini_bdd_mgrt &mgr)
+static bdd_transition_relationt make_input_driven_system(ebmc_bdd_mgrt &mgr)
 {
   auto i = mgr.Var("i");
   auto i_next = mgr.Var("i'");
@@ -71,7 +71,7 @@ static bdd_transition_relationt make_input_driven_system(mini_bdd_mgrt &mgr)
 
 SCENARIO("BDD model checker EX on toggle system")
 {
-  mini_bdd_mgrt mgr;
+  ebmc_bdd_mgrt mgr;
   auto tr = make_toggle_system(mgr);
   auto s = tr.variables[0].current;
   bdd_model_checkert mc(tr);
@@ -97,7 +97,7 @@ SCENARIO("BDD model checker EX on toggle system")
 
 SCENARIO("BDD model checker AX on toggle system")
 {
-  mini_bdd_mgrt mgr;
+  ebmc_bdd_mgrt mgr;
   auto tr = make_toggle_system(mgr);
   auto s = tr.variables[0].current;
   bdd_model_checkert mc(tr);
@@ -113,7 +113,7 @@ SCENARIO("BDD model checker AX on toggle system")
 
 SCENARIO("BDD model checker EX projects current inputs")
 {
-  mini_bdd_mgrt mgr;
+  ebmc_bdd_mgrt mgr;
   auto tr = make_input_driven_system(mgr);
   auto s = tr.variables[1].current;
   bdd_model_checkert mc(tr);
@@ -134,7 +134,7 @@ SCENARIO("BDD model checker EX projects current inputs")
 
 SCENARIO("BDD model checker EF on toggle system")
 {
-  mini_bdd_mgrt mgr;
+  ebmc_bdd_mgrt mgr;
   auto tr = make_toggle_system(mgr);
   auto s = tr.variables[0].current;
   bdd_model_checkert mc(tr);
@@ -158,7 +158,7 @@ SCENARIO("BDD model checker EF on toggle system")
 
 SCENARIO("BDD model checker EG on toggle system")
 {
-  mini_bdd_mgrt mgr;
+  ebmc_bdd_mgrt mgr;
   auto tr = make_toggle_system(mgr);
   auto s = tr.variables[0].current;
   bdd_model_checkert mc(tr);
@@ -179,7 +179,7 @@ SCENARIO("BDD model checker EG on toggle system")
 
 SCENARIO("BDD model checker AG on toggle system")
 {
-  mini_bdd_mgrt mgr;
+  ebmc_bdd_mgrt mgr;
   auto tr = make_toggle_system(mgr);
   auto s = tr.variables[0].current;
   bdd_model_checkert mc(tr);
@@ -200,7 +200,7 @@ SCENARIO("BDD model checker AG on toggle system")
 
 SCENARIO("BDD model checker AF on toggle system")
 {
-  mini_bdd_mgrt mgr;
+  ebmc_bdd_mgrt mgr;
   auto tr = make_toggle_system(mgr);
   auto s = tr.variables[0].current;
   bdd_model_checkert mc(tr);
@@ -216,7 +216,7 @@ SCENARIO("BDD model checker AF on toggle system")
 
 SCENARIO("BDD model checker EU on toggle system")
 {
-  mini_bdd_mgrt mgr;
+  ebmc_bdd_mgrt mgr;
   auto tr = make_toggle_system(mgr);
   auto s = tr.variables[0].current;
   bdd_model_checkert mc(tr);
@@ -242,7 +242,7 @@ SCENARIO("BDD model checker EU on toggle system")
 
 SCENARIO("BDD model checker AU on toggle system")
 {
-  mini_bdd_mgrt mgr;
+  ebmc_bdd_mgrt mgr;
   auto tr = make_toggle_system(mgr);
   auto s = tr.variables[0].current;
   bdd_model_checkert mc(tr);
@@ -258,7 +258,7 @@ SCENARIO("BDD model checker AU on toggle system")
 
 SCENARIO("BDD model checker ER on toggle system")
 {
-  mini_bdd_mgrt mgr;
+  ebmc_bdd_mgrt mgr;
   auto tr = make_toggle_system(mgr);
   auto s = tr.variables[0].current;
   bdd_model_checkert mc(tr);
@@ -274,7 +274,7 @@ SCENARIO("BDD model checker ER on toggle system")
 
 SCENARIO("BDD model checker AR on toggle system")
 {
-  mini_bdd_mgrt mgr;
+  ebmc_bdd_mgrt mgr;
   auto tr = make_toggle_system(mgr);
   auto s = tr.variables[0].current;
   bdd_model_checkert mc(tr);
@@ -290,7 +290,7 @@ SCENARIO("BDD model checker AR on toggle system")
 
 SCENARIO("BDD model checker on counter system with absorbing state")
 {
-  mini_bdd_mgrt mgr;
+  ebmc_bdd_mgrt mgr;
   auto tr = make_counter_system(mgr);
   auto s0 = tr.variables[0].current;
   auto s1 = tr.variables[1].current;
@@ -334,7 +334,7 @@ SCENARIO("BDD model checker on counter system with absorbing state")
 
 SCENARIO("BDD model checker with constraints")
 {
-  mini_bdd_mgrt mgr;
+  ebmc_bdd_mgrt mgr;
   auto tr = make_toggle_system(mgr);
   auto s = tr.variables[0].current;
 
@@ -350,3 +350,111 @@ SCENARIO("BDD model checker with constraints")
     }
   }
 }
+
+/// Build a system with an input i and state variables s0, s1, s2.
+/// Transition: next(s0) = i, next(s1) = s0 & !i, next(s2) = s1 | s2,
+/// with the constraint !(s0 & s2).
+static bdd_transition_relationt make_shift_system(ebmc_bdd_mgrt &mgr)
+{
+  auto i = mgr.Var("i");
+  auto i_next = mgr.Var("i'");
+  auto s0 = mgr.Var("s0");
+  auto s0_next = mgr.Var("s0'");
+  auto s1 = mgr.Var("s1");
+  auto s1_next = mgr.Var("s1'");
+  auto s2 = mgr.Var("s2");
+  auto s2_next = mgr.Var("s2'");
+
+  bdd_transition_relationt tr;
+  tr.variables.push_back({i, i_next, true});
+  tr.variables.push_back({s0, s0_next});
+  tr.variables.push_back({s1, s1_next});
+  tr.variables.push_back({s2, s2_next});
+  tr.transition_conjuncts.push_back(s0_next == i);
+  tr.transition_conjuncts.push_back(s1_next == (s0 & !i));
+  tr.transition_conjuncts.push_back(s2_next == (s1 | s2));
+  tr.constraint_conjuncts.push_back(!(s0 & s2));
+
+  return tr;
+}
+
+SCENARIO("BDD model checker with a partitioned transition relation")
+{
+  ebmc_bdd_mgrt mgr;
+  auto tr = make_shift_system(mgr);
+  auto s0 = tr.variables[1].current;
+  auto s1 = tr.variables[2].current;
+  auto s2 = tr.variables[3].current;
+
+  GIVEN("One cluster per conjunct, and a single cluster")
+  {
+    bdd_model_checkert partitioned(tr, 1);
+    bdd_model_checkert monolithic(tr, 1000000);
+
+    REQUIRE(partitioned.number_of_clusters() == 4);
+    REQUIRE(monolithic.number_of_clusters() == 1);
+
+    THEN("the pre-images agree")
+    {
+      for(auto &f : {s0, s1, s2, s0 & s1, s1 ^ s2, !s0 | s2, mgr.True()})
+        REQUIRE((partitioned.EX(f) == monolithic.EX(f)).is_true());
+    }
+
+    THEN("EX(s2) holds where s1 | s2, within the constraint")
+    {
+      auto expected = (s1 | s2) & !(s0 & s2);
+      REQUIRE((partitioned.EX(s2) == expected).is_true());
+    }
+
+    THEN("the fixpoints agree")
+    {
+      REQUIRE((partitioned.EF(s2) == monolithic.EF(s2)).is_true());
+      REQUIRE((partitioned.EG(!s2) == monolithic.EG(!s2)).is_true());
+    }
+  }
+}
+
+SCENARIO("BDD model checker image on counter system")
+{
+  ebmc_bdd_mgrt mgr;
+  auto tr = make_counter_system(mgr);
+  auto s0 = tr.variables[0].current;
+  auto s1 = tr.variables[1].current;
+  bdd_model_checkert mc(tr);
+
+  GIVEN("The states (0,1) and (1,1)")
+  {
+    THEN("their successors are (1,1) and (1,0)")
+    {
+      auto result = mc.image(s1);
+      REQUIRE((result == s0).is_true());
+    }
+  }
+
+  GIVEN("The state (0,0)")
+  {
+    THEN("its only successor is (0,0)")
+    {
+      auto result = mc.image(!s0 & !s1);
+      REQUIRE((result == (!s0 & !s1)).is_true());
+    }
+  }
+}
+
+SCENARIO("BDD model checker image leaves the inputs unconstrained")
+{
+  ebmc_bdd_mgrt mgr;
+  auto tr = make_input_driven_system(mgr);
+  auto i = tr.variables[0].current;
+  auto s = tr.variables[1].current;
+  bdd_model_checkert mc(tr);
+
+  GIVEN("The states where s=0 and i=1")
+  {
+    THEN("the successors are the states where s=1")
+    {
+      auto result = mc.image(!s & i);
+      REQUIRE((result == s).is_true());
+    }
+  }
+}
@@ -0,0 +1,120 @@
+/*******************************************************************\
+
+Module: BDD Quantification and Renaming Unit Tests
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+#include <ebmc/bdd_operations.h>
+#include <testing-utils/use_catch.h>
+
+SCENARIO("Quantification over a set of variables")
+{
+  ebmc_bdd_mgrt mgr;
+  auto a = mgr.Var("a");
+  auto b = mgr.Var("b");
+  auto c = mgr.Var("c");
+  auto d = mgr.Var("d");
+
+  auto f = (a & !b) | (c ^ d);
+  auto g = (b | d) & (a == c);
+
+  bdd_varsett vars(std::vector<unsigned>{b.var(), d.var()});
+
+  GIVEN("The same quantification, one variable at a time")
+  {
+    auto f_exists = exists(exists(f, b.var()), d.var());
+    auto fg_exists = exists(exists(f & g, b.var()), d.var());
+
+    THEN("exists agrees")
+    {
+      REQUIRE((exists(f, vars) == f_exists).is_true());
+    }
+
+    THEN("and_exists agrees")
+    {
+      REQUIRE((and_exists(f, g, vars) == fg_exists).is_true());
+      REQUIRE((and_exists(g, f, vars) == fg_exists).is_true());
+    }
+
+    THEN("the empty set quantifies nothing")
+    {
+      REQUIRE((exists(f, bdd_varsett{}) == f).is_true());
+      REQUIRE((and_exists(f, g, bdd_varsett{}) == (f & g)).is_true());
+    }
+  }
+}
+
+SCENARIO("Simultaneous renaming of variables")
+{
+  ebmc_bdd_mgrt mgr;
+  auto a = mgr.Var("a");
+  auto a_next = mgr.Var("a'");
+  auto b = mgr.Var("b");
+  auto b_next = mgr.Var("b'");
+
+  auto f = (a & !b) | (!a & b_next);
+
+  GIVEN("A renaming that preserves the variable order")
+  {
+    std::map<unsigned, unsigned> mapping{
+      {a.var(), a_next.var()}, {b.var(), b_next.var()}};
+
+    THEN("it agrees with substitution")
+    {
+      auto expected =
+        substitute(substitute(f, a.var(), a_next), b.var(), b_next);
+      REQUIRE((permute(f, mapping) == expected).is_true());
+    }
+  }
+
+  GIVEN("A swap of two variables")
+  {
+    std::map<unsigned, unsigned> mapping{
+      {a.var(), b.var()}, {b.var(), a.var()}};
+
+    THEN("the result has the variables exchanged")
+    {
+      auto expected = (b & !a) | (!b & b_next);
+      REQUIRE((permute(f, mapping) == expected).is_true());
+    }
+  }
+}
+
+SCENARIO("Simplification with a care set")
+{
+  ebmc_bdd_mgrt mgr;
+  auto a = mgr.Var("a");
+  auto b = mgr.Var("b");
+  auto c = mgr.Var("c");
+
+  auto f = (a & b) | (!a & c);
+
+  GIVEN("A care set that fixes a")
+  {
+    THEN("the result is the cofactor")
+    {
+      REQUIRE((simplify(f, a) == b).is_true());
+      REQUIRE((simplify(f, !a) == c).is_true());
+    }
+  }
+
+  GIVEN("Any care set")
+  {
+    auto care = (a | b) & !c;
+
+    THEN("the result agrees with f on the care set")
+    {
+      auto result = simplify(f, care);
+      REQUIRE(((result & care) == (f & care)).is_true());
+      REQUIRE(bdd_size(result) <= bdd_size(f));
+    }
+
+    THEN("the constant care sets")
+    {
+      REQUIRE((simplify(f, mgr.True()) == f).is_true());
+      REQUIRE(simplify(f, mgr.False()).is_false());
+    }
+  }
+}
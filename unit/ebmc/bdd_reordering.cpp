@@ -0,0 +1,84 @@
+/*******************************************************************\
+
+Module: BDD Variable Reordering Unit Tests
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+#include <ebmc/bdd_reordering.h>
+#include <testing-utils/use_catch.h>
+
+SCENARIO("Sifting finds a better order")
+{
+  ebmc_bdd_mgrt mgr;
+  std::vector<ebmc_bddt> a, b;
+
+  // the worst order for the function below
+  for(std::size_t i = 0; i < 4; i++)
+    a.push_back(mgr.Var("a" + std::to_string(i)));
+  for(std::size_t i = 0; i < 4; i++)
+    b.push_back(mgr.Var("b" + std::to_string(i)));
+
+  ebmc_bddt f = mgr.False();
+  for(std::size_t i = 0; i < 4; i++)
+    f = f | (a[i] & b[i]);
+
+  GIVEN("One group per variable")
+  {
+    std::vector<std::vector<unsigned>> groups;
+    for(const auto &v : a)
+      groups.push_back({v.var()});
+    for(const auto &v : b)
+      groups.push_back({v.var()});
+
+    auto mapping = sift({f}, groups);
+    auto g = permute(f, mapping);
+
+    THEN("the BDD is smaller")
+    {
+      REQUIRE(bdd_size(g) < bdd_size(f));
+    }
+
+    THEN("the function is unchanged")
+    {
+      std::map<unsigned, unsigned> inverse;
+      for(const auto &[from, to] : mapping)
+        inverse[to] = from;
+      REQUIRE((permute(g, inverse) == f).is_true());
+    }
+  }
+}
+
+SCENARIO("Sifting keeps groups together")
+{
+  ebmc_bdd_mgrt mgr;
+  std::vector<ebmc_bddt> x, x_next;
+
+  for(std::size_t i = 0; i < 3; i++)
+  {
+    x.push_back(mgr.Var("x" + std::to_string(i)));
+    x_next.push_back(mgr.Var("x" + std::to_string(i) + "'"));
+  }
+
+  // next(x0) = x2, next(x1) = x0, next(x2) = x1
+  auto f = (x_next[0] == x[2]) & (x_next[1] == x[0]) & (x_next[2] == x[1]);
+
+  std::vector<std::vector<unsigned>> groups;
+  for(std::size_t i = 0; i < 3; i++)
+    groups.push_back({x[i].var(), x_next[i].var()});
+
+  auto mapping = sift({f}, groups);
+
+  auto renamed = [&mapping](unsigned var)
+  {
+    auto entry = mapping.find(var);
+    return entry == mapping.end() ? var : entry->second;
+  };
+
+  THEN("each next-state variable follows its current-state variable")
+  {
+    for(std::size_t i = 0; i < 3; i++)
+      REQUIRE(renamed(x_next[i].var()) == renamed(x[i].var()) + 1);
+  }
+}
@@ -0,0 +1,81 @@
+/*******************************************************************\
+
+Module: Complement-Edge BDD Package Unit Tests
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+#include <ebmc/ce_bdd.h>
+#include <testing-utils/use_catch.h>
+
+SCENARIO("BDDs with complement edges are canonical")
+{
+  ce_bdd_mgrt mgr;
+  auto a = mgr.Var("a");
+  auto b = mgr.Var("b");
+  auto c = mgr.Var("c");
+
+  auto f = (a & b) | (!a & c);
+
+  THEN("equivalent BDDs have the same node number")
+  {
+    REQUIRE(((f & b) | (f & !b)).node_number() == f.node_number());
+    REQUIRE((!(!a | !b)).node_number() == (a & b).node_number());
+    REQUIRE((a ^ b).node_number() == (!(a == b)).node_number());
+  }
+
+  THEN("the constants are recognized")
+  {
+    REQUIRE((f | !f).is_true());
+    REQUIRE((f & !f).is_false());
+    REQUIRE((f ^ f).is_false());
+    REQUIRE((f == f).is_true());
+  }
+
+  THEN("negation shares the nodes")
+  {
+    REQUIRE((!f).var() == f.var());
+    REQUIRE((!f).low().node_number() == (!f.low()).node_number());
+    REQUIRE((!f).high().node_number() == (!f.high()).node_number());
+  }
+
+  THEN("quantification and substitution agree with the cofactors")
+  {
+    REQUIRE((exists(f, a.var()) == (b | c)).is_true());
+    REQUIRE((substitute(f, a.var(), mgr.True()) == b).is_true());
+  }
+
+  THEN("cubes lists the paths to true")
+  {
+    REQUIRE(cubes(a & !b) == "a & !b\n");
+    REQUIRE(cubes(mgr.False()) == "false\n");
+  }
+}
+
+SCENARIO("Unreferenced BDD nodes are collected")
+{
+  ce_bdd_mgrt mgr;
+  std::vector<ce_bddt> vars;
+
+  for(std::size_t i = 0; i < 10; i++)
+    vars.push_back(mgr.Var("v" + std::to_string(i)));
+
+  const std::size_t nodes_before = mgr.number_of_nodes();
+
+  GIVEN("A BDD that is no longer referenced")
+  {
+    {
+      ce_bddt f = mgr.False();
+      for(std::size_t i = 0; i + 1 < vars.size(); i += 2)
+        f = f | (vars[i] ^ vars[i + 1]);
+      REQUIRE(mgr.number_of_nodes() > nodes_before);
+    }
+
+    THEN("its nodes are freed by the garbage collection")
+    {
+      mgr.collect_garbage();
+      REQUIRE(mgr.number_of_nodes() == nodes_before);
+    }
+  }
+}
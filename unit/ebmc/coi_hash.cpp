@@ -0,0 +1,201 @@
+/*******************************************************************\
+
+Module: Structural Hash of the Cone of Influence Unit Tests
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+#include <solvers/prop/literal_expr.h>
+
+#include <ebmc/coi_hash.h>
+#include <testing-utils/use_catch.h>
+#include <trans-netlist/netlist.h>
+
+static literalt netlist_xor(netlistt &netlist, literalt a, literalt b)
+{
+  return !netlist.new_and_node(
+    !netlist.new_and_node(a, !b), !netlist.new_and_node(!a, b));
+}
+
+/// Two independent 2-bit counters main.a and main.b, with the property
+/// main.p_a for the first and main.p_b for the second. The nodes of
+/// main.b are created first when requested, which changes the
+/// numbering of all nodes.
+static netlistt
+two_counters(bool b_first, bool saturating_b, std::size_t padding)
+{
+  netlistt netlist;
+
+  // the constant
+  netlist.new_input();
+
+  for(std::size_t i = 0; i < padding; i++)
+    netlist.new_input();
+
+  auto counter = [&netlist](const std::string &name, bool saturating)
+  {
+    auto bit0 = netlist.new_input(), bit1 = netlist.new_input();
+    auto next1 = saturating ? !netlist.new_and_node(!bit1, !bit0)
+                            : netlist_xor(netlist, bit1, bit0);
+
+    auto &var = netlist.var_map.map["main." + name];
+    var.vartype = var_mapt::vart::vartypet::LATCH;
+    var.bits.push_back({bit0, !bit0});
+    var.bits.push_back({bit1, next1});
+
+    netlist.properties["main.p_" + name] =
+      unary_exprt{ID_AG, literal_exprt{!netlist.new_and_node(bit0, bit1)}};
+
+    return netlist.new_and_node(!bit0, !bit1);
+  };
+
+  literalt initial_a, initial_b;
+
+  if(b_first)
+  {
+    initial_b = counter("b", saturating_b);
+    initial_a = counter("a", false);
+  }
+  else
+  {
+    initial_a = counter("a", false);
+    initial_b = counter("b", saturating_b);
+  }
+
+  // a single conjunction over all latches
+  netlist.initial.push_back(netlist.new_and_node(initial_a, initial_b));
+
+  return netlist;
+}
+
+static ebmc_propertiest two_properties()
+{
+  ebmc_propertiest properties;
+  properties.properties.emplace_back();
+  properties.properties.back().identifier = "main.p_a";
+  properties.properties.emplace_back();
+  properties.properties.back().identifier = "main.p_b";
+  return properties;
+}
+
+SCENARIO("cone of influence hashes")
+{
+  const auto properties = two_properties();
+  const auto hashes = cone_of_influence_hashes(
+    two_counters(false, false, 0), properties);
+
+  REQUIRE(hashes.size() == 2);
+  REQUIRE(hashes.at("main.p_a").size() == 16);
+
+  GIVEN("The same design with different node numbers")
+  {
+    const auto renumbered = cone_of_influence_hashes(
+      two_counters(true, false, 5), properties);
+
+    THEN("the hashes are the same")
+    {
+      REQUIRE(renumbered == hashes);
+    }
+  }
+
+  GIVEN("A change to the second counter")
+  {
+    const auto changed = cone_of_influence_hashes(
+      two_counters(false, true, 0), properties);
+
+    THEN("only the hash of its property changes")
+    {
+      REQUIRE(changed.at("main.p_a") == hashes.at("main.p_a"));
+      REQUIRE(changed.at("main.p_b") != hashes.at("main.p_b"));
+    }
+  }
+
+  GIVEN("A constraint on the second counter")
+  {
+    auto netlist = two_counters(false, false, 0);
+    netlist.constraints.push_back(
+      netlist.var_map.map["main.b"].bits[0].current);
+    const auto constrained = cone_of_influence_hashes(netlist, properties);
+
+    THEN("only the hash of its property changes")
+    {
+      REQUIRE(constrained.at("main.p_a") == hashes.at("main.p_a"));
+      REQUIRE(constrained.at("main.p_b") != hashes.at("main.p_b"));
+    }
+  }
+
+  GIVEN("A constraint that is false")
+  {
+    auto netlist = two_counters(false, false, 0);
+    netlist.constraints.push_back(const_literal(false));
+    const auto constrained = cone_of_influence_hashes(netlist, properties);
+
+    THEN("all hashes change")
+    {
+      REQUIRE(constrained.at("main.p_a") != hashes.at("main.p_a"));
+      REQUIRE(constrained.at("main.p_b") != hashes.at("main.p_b"));
+    }
+  }
+
+  THEN("structurally equal cones with different names differ")
+  {
+    REQUIRE(hashes.at("main.p_a") != hashes.at("main.p_b"));
+  }
+}
+
+SCENARIO("clustering of properties by their cones")
+{
+  const auto properties = two_properties();
+
+  GIVEN("Two independent counters")
+  {
+    const auto clusters =
+      cluster_properties(two_counters(false, false, 0), properties);
+
+    THEN("the properties are in different clusters")
+    {
+      REQUIRE(clusters.size() == 2);
+      REQUIRE(clusters[0] == std::set<irep_idt>{"main.p_a"});
+      REQUIRE(clusters[1] == std::set<irep_idt>{"main.p_b"});
+    }
+  }
+
+  GIVEN("A constraint over both counters")
+  {
+    auto netlist = two_counters(false, false, 0);
+    // a disjunction, which is not split
+    netlist.constraints.push_back(!netlist.new_and_node(
+      !netlist.var_map.map["main.a"].bits[0].current,
+      !netlist.var_map.map["main.b"].bits[0].current));
+    const auto clusters = cluster_properties(netlist, properties);
+
+    THEN("the properties are in one cluster")
+    {
+      REQUIRE(clusters.size() == 1);
+      REQUIRE(clusters[0] == std::set<irep_idt>{"main.p_a", "main.p_b"});
+    }
+  }
+}
+
+SCENARIO("netlist hash")
+{
+  const auto hash = netlist_hash(two_counters(false, false, 0));
+
+  REQUIRE(hash.size() == 16);
+
+  THEN("the hash is the same for the same netlist")
+  {
+    REQUIRE(netlist_hash(two_counters(false, false, 0)) == hash);
+  }
+
+  THEN("the hash depends on the node numbering")
+  {
+    REQUIRE(netlist_hash(two_counters(true, false, 0)) != hash);
+  }
+
+  THEN("the hash depends on the logic")
+  {
+    REQUIRE(netlist_hash(two_counters(false, true, 0)) != hash);
+  }
+}
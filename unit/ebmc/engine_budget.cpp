@@ -0,0 +1,124 @@
+/*******************************************************************\
+
+Module: Resource Budgets for Engines Unit Tests
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+#include <ebmc/engine_budget.h>
+#include <testing-utils/use_catch.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+SCENARIO("cancellation points enforce the budget of the innermost token")
+{
+  GIVEN("No token")
+  {
+    THEN("a cancellation point does nothing")
+    {
+      REQUIRE(cancellation_tokent::active() == nullptr);
+      REQUIRE_NOTHROW(cancellation_point());
+    }
+  }
+
+  GIVEN("An unlimited token")
+  {
+    cancellation_tokent token{engine_budgett{}};
+
+    THEN("the budget is never exhausted")
+    {
+      REQUIRE(cancellation_tokent::active() == &token);
+      REQUIRE_FALSE(token.exhausted().has_value());
+      REQUIRE_FALSE(token.seconds_left().has_value());
+      REQUIRE_NOTHROW(cancellation_point());
+    }
+  }
+
+  GIVEN("A token with a time limit of one second")
+  {
+    engine_budgett budget;
+    budget.time_limit = 1;
+    cancellation_tokent token{budget};
+
+    THEN("the budget is exhausted after a second")
+    {
+      REQUIRE_NOTHROW(cancellation_point());
+      REQUIRE(token.seconds_left() == 1);
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+
+      REQUIRE(token.seconds_left() == 0);
+      REQUIRE_THROWS_AS(cancellation_point(), budget_exhaustedt);
+    }
+
+    THEN("a nested token takes precedence, until it goes out of scope")
+    {
+      {
+        cancellation_tokent inner{engine_budgett{}};
+        REQUIRE(cancellation_tokent::active() == &inner);
+      }
+
+      REQUIRE(cancellation_tokent::active() == &token);
+    }
+
+    THEN("the token is not active in another thread")
+    {
+      const cancellation_tokent *other = &token;
+
+      std::thread([&other]() { other = cancellation_tokent::active(); })
+        .join();
+
+      REQUIRE(other == nullptr);
+      REQUIRE(cancellation_tokent::active() == &token);
+    }
+  }
+}
+
+SCENARIO("a watchdog interrupts once the budget is exhausted")
+{
+  GIVEN("A token with a time limit of one second")
+  {
+    engine_budgett budget;
+    budget.time_limit = 1;
+    cancellation_tokent token{budget};
+
+    THEN("the watchdog calls the function once")
+    {
+      std::atomic<std::size_t> calls{0};
+
+      budget_watchdogt watchdog(&token, [&calls]() { calls++; });
+
+      REQUIRE_FALSE(watchdog.fired());
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(1200));
+
+      REQUIRE(watchdog.fired());
+      REQUIRE(calls == 1);
+    }
+
+    THEN("a watchdog that goes out of scope in time does not fire")
+    {
+      std::atomic<std::size_t> calls{0};
+
+      {
+        budget_watchdogt watchdog(&token, [&calls]() { calls++; });
+      }
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(1200));
+
+      REQUIRE(calls == 0);
+    }
+  }
+
+  GIVEN("No token")
+  {
+    THEN("the watchdog does nothing")
+    {
+      budget_watchdogt watchdog(nullptr, []() { FAIL(); });
+      REQUIRE_FALSE(watchdog.fired());
+    }
+  }
+}
@@ -0,0 +1,114 @@
+/*******************************************************************\
+
+Module: Forked Worker Unit Tests
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+#include <ebmc/ebmc_error.h>
+#include <ebmc/forked_worker.h>
+#include <testing-utils/use_catch.h>
+
+#include <chrono>
+#include <thread>
+
+/// Records the messages it is given
+class recording_message_handlert : public message_handlert
+{
+public:
+  void print(unsigned level, const std::string &message) override
+  {
+    message_handlert::print(level, message);
+    messages.push_back(message);
+  }
+
+  void flush(unsigned) override
+  {
+  }
+
+  std::vector<std::string> messages;
+};
+
+SCENARIO("forked_workert passes on results and messages")
+{
+  GIVEN("A worker that sends two results and a message")
+  {
+    recording_message_handlert message_handler;
+
+    forked_workert worker(
+      [](message_handlert &worker_message_handler,
+         const forked_workert::sendt &send)
+      {
+        send("first");
+        messaget message(worker_message_handler);
+        message.status() << "two\nlines" << messaget::eom;
+        send("second\\");
+      },
+      message_handler);
+
+    THEN("the parent receives them in order")
+    {
+      auto lines = worker.wait();
+      REQUIRE(lines == std::vector<std::string>{"first", "second\\"});
+      REQUIRE(
+        message_handler.messages == std::vector<std::string>{"two\nlines"});
+      REQUIRE(!worker.is_running());
+    }
+  }
+}
+
+SCENARIO("forked_workert reports failures")
+{
+  GIVEN("A worker that throws")
+  {
+    null_message_handlert message_handler;
+
+    forked_workert worker(
+      [](message_handlert &, const forked_workert::sendt &)
+      { throw ebmc_errort() << "worker error"; },
+      message_handler);
+
+    THEN("waiting for it throws")
+    {
+      REQUIRE_THROWS_AS(worker.wait(), ebmc_errort);
+    }
+  }
+}
+
+SCENARIO("forked_workert waits for any of several workers")
+{
+  GIVEN("A worker that is done quickly and one that is not")
+  {
+    null_message_handlert message_handler;
+
+    forked_workert slow(
+      [](message_handlert &, const forked_workert::sendt &)
+      {
+        while(true)
+          std::this_thread::sleep_for(std::chrono::seconds(1));
+      },
+      message_handler);
+
+    forked_workert fast(
+      [](message_handlert &, const forked_workert::sendt &send)
+      { send("done"); },
+      message_handler);
+
+    THEN("waiting returns once the quick one has sent its result")
+    {
+      std::vector<std::string> lines;
+
+      while(lines.empty())
+      {
+        forked_workert::wait_for_any({&slow, &fast});
+        lines = fast.poll();
+      }
+
+      REQUIRE(lines == std::vector<std::string>{"done"});
+      REQUIRE(slow.is_running());
+      slow.cancel();
+      REQUIRE(!slow.is_running());
+    }
+  }
+}
@@ -0,0 +1,90 @@
+/*******************************************************************\
+
+Module: Property Results as Text Unit Tests
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+#include <util/arith_tools.h>
+#include <util/bitvector_types.h>
+#include <util/std_expr.h>
+
+#include <ebmc/ebmc_error.h>
+#include <ebmc/property_results.h>
+#include <testing-utils/use_catch.h>
+
+SCENARIO("property results survive the conversion to a line")
+{
+  GIVEN("A refuted property with a trace")
+  {
+    ebmc_propertiest::propertyt property;
+    property.identifier = "main.p0";
+    property.refuted("BMC");
+    property.bound = 5;
+
+    const unsignedbv_typet type{4};
+    trans_tracet trace;
+    trace.mode = "Verilog";
+    trace.states.resize(2);
+    trace.states[0].assignments.emplace_back(
+      symbol_exprt{"main.cnt", type}, from_integer(0, type));
+    trace.states[1].assignments.emplace_back(
+      symbol_exprt{"main.cnt", type}, from_integer(1, type));
+    trace.states[1].property_failed = true;
+    property.witness_trace = trace;
+
+    const auto line = property_results_to_line(property);
+
+    THEN("the line is a single line")
+    {
+      REQUIRE(line.find('\n') == std::string::npos);
+    }
+
+    THEN("reading the line gives the same results")
+    {
+      const auto result = property_results_from_line(line);
+      REQUIRE(result.identifier == "main.p0");
+      REQUIRE(result.is_refuted());
+      REQUIRE(result.bound == 5);
+      REQUIRE(result.proof_via == std::optional<std::string>{"BMC"});
+      REQUIRE(!result.failure_reason.has_value());
+      REQUIRE(result.has_witness_trace());
+
+      const auto &states = result.witness_trace->states;
+      REQUIRE(result.witness_trace->mode == "Verilog");
+      REQUIRE(states.size() == 2);
+      REQUIRE(!states[0].property_failed);
+      REQUIRE(states[1].property_failed);
+      REQUIRE(states[1].assignments.size() == 1);
+      REQUIRE(
+        states[1].assignments.front().lhs == symbol_exprt{"main.cnt", type});
+      REQUIRE(states[1].assignments.front().rhs == from_integer(1, type));
+    }
+  }
+
+  GIVEN("A property that is unsupported")
+  {
+    ebmc_propertiest::propertyt property;
+    property.identifier = "main.p1";
+    property.unsupported("no liveness");
+
+    THEN("the reason is kept")
+    {
+      const auto result =
+        property_results_from_line(property_results_to_line(property));
+      REQUIRE(result.is_unsupported());
+      REQUIRE(
+        result.failure_reason == std::optional<std::string>{"no liveness"});
+      REQUIRE(!result.has_witness_trace());
+    }
+  }
+
+  GIVEN("A line that is not hexadecimal")
+  {
+    THEN("reading it throws")
+    {
+      REQUIRE_THROWS_AS(property_results_from_line("xyz"), ebmc_errort);
+    }
+  }
+}
@@ -0,0 +1,167 @@
+/*******************************************************************\
+
+Module: SAT Portfolio Unit Tests
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+#include <ebmc/engine_budget.h>
+#include <ebmc/sat_portfolio.h>
+#include <testing-utils/use_catch.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+#ifdef HAVE_MINISAT2
+
+/// A member that only starts to solve once it is interrupted, and
+/// hence, always loses
+class losing_membert : public sat_portfoliot::membert
+{
+public:
+  explicit losing_membert(std::unique_ptr<membert> _inner)
+    : inner(std::move(_inner))
+  {
+  }
+
+  cnft &cnf() override
+  {
+    return inner->cnf();
+  }
+
+  std::string description() const override
+  {
+    return "losing " + inner->description();
+  }
+
+  propt::resultt solve(const bvt &assumptions) override
+  {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      if(condition.wait_for(
+           lock, std::chrono::seconds(10), [this] { return terminated; }))
+      {
+        interruptions++;
+      }
+    }
+
+    return inner->solve(assumptions);
+  }
+
+  void terminate_solve() override
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      terminated = true;
+    }
+
+    inner->terminate_solve();
+    condition.notify_all();
+  }
+
+  void reset_termination() override
+  {
+    terminated = false;
+    inner->reset_termination();
+  }
+
+  std::size_t interruptions = 0;
+
+protected:
+  std::unique_ptr<membert> inner;
+  std::mutex mutex;
+  std::condition_variable condition;
+  bool terminated = false;
+};
+
+SCENARIO("sat_portfoliot answers repeated queries after interrupting")
+{
+  GIVEN("A portfolio with a member that always loses")
+  {
+    null_message_handlert message_handler;
+
+    auto loser_ptr =
+      std::make_unique<losing_membert>(sat_portfoliot::minisat(1));
+    auto &loser = *loser_ptr;
+
+    std::vector<std::unique_ptr<sat_portfoliot::membert>> members;
+    members.push_back(sat_portfoliot::minisat(std::nullopt));
+    members.push_back(std::move(loser_ptr));
+
+    sat_portfoliot portfolio(message_handler, std::move(members));
+
+    // a xor b, with room for decisions
+    literalt a = portfolio.new_variable();
+    literalt b = portfolio.new_variable();
+    literalt c = portfolio.new_variable();
+    portfolio.lcnf({a, b});
+    portfolio.lcnf({!a, !b});
+    portfolio.lcnf({c, a});
+
+    THEN("each query is answered by the other member")
+    {
+      REQUIRE(portfolio.prop_solve() == propt::resultt::P_SATISFIABLE);
+      REQUIRE(portfolio.l_get(a) != portfolio.l_get(b));
+
+      REQUIRE(portfolio.prop_solve({a}) == propt::resultt::P_SATISFIABLE);
+      REQUIRE(portfolio.l_get(a).is_true());
+      REQUIRE(portfolio.l_get(b).is_false());
+
+      REQUIRE(
+        portfolio.prop_solve({a, b}) == propt::resultt::P_UNSATISFIABLE);
+      REQUIRE((portfolio.is_in_conflict(a) || portfolio.is_in_conflict(b)));
+
+      // a clause given after the interrupts reaches the loser as well
+      portfolio.lcnf({!c});
+      REQUIRE(portfolio.prop_solve() == propt::resultt::P_SATISFIABLE);
+      REQUIRE(portfolio.l_get(a).is_true());
+      REQUIRE(portfolio.l_get(c).is_false());
+
+      REQUIRE(loser.interruptions == 4);
+
+      AND_THEN("the interrupted member still solves on its own")
+      {
+        REQUIRE(
+          loser.cnf().prop_solve({!a}) == propt::resultt::P_UNSATISFIABLE);
+      }
+    }
+  }
+}
+
+SCENARIO("sat_portfoliot is interrupted once the budget is exhausted")
+{
+  GIVEN("A portfolio whose only member waits until it is interrupted")
+  {
+    null_message_handlert message_handler;
+
+    auto loser_ptr =
+      std::make_unique<losing_membert>(sat_portfoliot::minisat(1));
+    auto &loser = *loser_ptr;
+
+    std::vector<std::unique_ptr<sat_portfoliot::membert>> members;
+    members.push_back(std::move(loser_ptr));
+
+    sat_portfoliot portfolio(message_handler, std::move(members));
+
+    literalt a = portfolio.new_variable();
+    portfolio.lcnf({a});
+
+    engine_budgett budget;
+    budget.time_limit = 1;
+    cancellation_tokent token{budget};
+
+    THEN("the query has no answer once the budget is exhausted")
+    {
+      const auto start = std::chrono::steady_clock::now();
+
+      REQUIRE(portfolio.prop_solve() == propt::resultt::P_ERROR);
+      REQUIRE(loser.interruptions == 1);
+      REQUIRE(
+        std::chrono::steady_clock::now() - start < std::chrono::seconds(5));
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,211 @@
+/*******************************************************************\
+
+Module: IC3 Frame Clause Database Unit Tests
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+#include <new-ic3/frame_clause_db.h>
+#include <testing-utils/use_catch.h>
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+static bvt sorted_clause(std::initializer_list<literalt> literals)
+{
+  bvt clause = literals;
+  frame_clause_dbt::sort(clause);
+  return clause;
+}
+
+SCENARIO("frame_clause_dbt subsumption queries")
+{
+  GIVEN("A database with the clause (a | !b) at level 1")
+  {
+    literalt a{1, false}, b{2, false}, c{3, false};
+
+    frame_clause_dbt db;
+    db.new_level();
+    db.new_level();
+    db.new_level();
+    db.add(sorted_clause({a, !b}), 1);
+
+    THEN("it subsumes (a | !b | c) at levels up to 1")
+    {
+      auto clause = sorted_clause({c, !b, a});
+      REQUIRE(db.is_subsumed(clause, 0));
+      REQUIRE(db.is_subsumed(clause, 1));
+      REQUIRE(!db.is_subsumed(clause, 2));
+    }
+
+    THEN("it does not subsume clauses without one of its literals")
+    {
+      REQUIRE(!db.is_subsumed(sorted_clause({a, c}), 0));
+      REQUIRE(!db.is_subsumed(sorted_clause({a, b}), 0));
+      REQUIRE(!db.is_subsumed(sorted_clause({a}), 0));
+    }
+
+    THEN("a stronger clause at level 1 removes it")
+    {
+      REQUIRE(db.remove_subsumed(sorted_clause({a}), 0) == 0);
+      REQUIRE(db.remove_subsumed(sorted_clause({a}), 1) == 1);
+      REQUIRE(db.size() == 0);
+      REQUIRE(db.clauses_at(1).empty());
+    }
+  }
+}
+
+SCENARIO("frame_clause_dbt moves clauses between levels")
+{
+  GIVEN("A database with three clauses at level 1")
+  {
+    literalt a{1, false}, b{2, false}, c{3, false};
+
+    frame_clause_dbt db;
+    db.new_level();
+    db.new_level();
+    db.new_level();
+    auto id1 = db.add(sorted_clause({a}), 1);
+    auto id2 = db.add(sorted_clause({b}), 1);
+    auto id3 = db.add(sorted_clause({c}), 1);
+
+    WHEN("two of them are pushed to level 2")
+    {
+      db.set_level(id1, 2);
+      db.set_level(id3, 2);
+
+      THEN("the level lists are updated")
+      {
+        REQUIRE(db.clauses_at(1) == std::vector<std::size_t>{id2});
+        REQUIRE(db.clauses_at(2).size() == 2);
+        REQUIRE(db.level(id1) == 2);
+        REQUIRE(db.level(id3) == 2);
+        REQUIRE(db.is_subsumed(sorted_clause({a, b}), 2));
+        REQUIRE(!db.is_subsumed(sorted_clause({b, !c}), 2));
+      }
+    }
+
+    WHEN("one is removed and the garbage is collected")
+    {
+      db.remove(id2);
+      db.remove(id3);
+      db.collect_garbage();
+
+      THEN("the remaining clause keeps its identifier and literals")
+      {
+        REQUIRE(db.size() == 1);
+        REQUIRE(db.is_live(id1));
+        REQUIRE(!db.is_live(id2));
+        REQUIRE(db.literals(id1).to_bvt() == bvt{a});
+        REQUIRE(db.is_subsumed(sorted_clause({a, c}), 1));
+        REQUIRE(!db.is_subsumed(sorted_clause({b, c}), 1));
+      }
+    }
+  }
+}
+
+/// The pairwise subsumption check the database replaces
+static bool naive_subsumes(const bvt &a, const bvt &b)
+{
+  return a.size() <= b.size() &&
+         std::includes(
+           b.begin(),
+           b.end(),
+           a.begin(),
+           a.end(),
+           [](literalt x, literalt y) { return x.get() < y.get(); });
+}
+
+static std::vector<bvt>
+random_clauses(std::size_t number, unsigned number_of_variables)
+{
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<unsigned> var_dist(1, number_of_variables);
+  std::uniform_int_distribution<unsigned> size_dist(2, 20);
+  std::vector<bvt> result;
+
+  for(std::size_t i = 0; i < number; i++)
+  {
+    bvt clause;
+    for(std::size_t j = size_dist(rng); j != 0; j--)
+      clause.push_back(literalt{var_dist(rng), (rng() & 1) != 0});
+    frame_clause_dbt::sort(clause);
+    clause.erase(std::unique(clause.begin(), clause.end()), clause.end());
+    result.push_back(std::move(clause));
+  }
+
+  return result;
+}
+
+SCENARIO("frame_clause_dbt agrees with pairwise subsumption")
+{
+  // few variables, to get plenty of subsumption
+  auto clauses = random_clauses(2000, 12);
+
+  frame_clause_dbt db;
+  db.new_level();
+
+  for(std::size_t i = 0; i < clauses.size(); i++)
+  {
+    bool naive = false;
+    for(std::size_t j = 0; j < i && !naive; j++)
+      naive = naive_subsumes(clauses[j], clauses[i]);
+
+    REQUIRE(db.is_subsumed(clauses[i], 0) == naive);
+    db.add(clauses[i], 0);
+  }
+}
+
+// Microbenchmark, not run by default; run with
+// ./unit_tests "[benchmark]"
+SCENARIO("frame_clause_dbt benchmark", "[.][benchmark]")
+{
+  const std::size_t number = 20000;
+  auto clauses = random_clauses(number, 2000);
+
+  auto naive_start = std::chrono::steady_clock::now();
+  std::vector<bvt> naive_db;
+  std::size_t naive_subsumed = 0;
+  for(const auto &clause : clauses)
+  {
+    bool subsumed = false;
+    for(const auto &existing : naive_db)
+      if(naive_subsumes(existing, clause))
+      {
+        subsumed = true;
+        break;
+      }
+    if(subsumed)
+      naive_subsumed++;
+    else
+      naive_db.push_back(clause);
+  }
+  auto naive_stop = std::chrono::steady_clock::now();
+
+  auto db_start = std::chrono::steady_clock::now();
+  frame_clause_dbt db;
+  db.new_level();
+  std::size_t db_subsumed = 0;
+  for(const auto &clause : clauses)
+  {
+    if(db.is_subsumed(clause, 0))
+      db_subsumed++;
+    else
+    {
+      db.remove_subsumed(clause, 0);
+      db.add(clause, 0);
+    }
+  }
+  auto db_stop = std::chrono::steady_clock::now();
+
+  REQUIRE(naive_subsumed == db_subsumed);
+
+  WARN(
+    "pairwise: "
+    << std::chrono::duration<double>(naive_stop - naive_start).count()
+    << "s, indexed: "
+    << std::chrono::duration<double>(db_stop - db_start).count() << "s for "
+    << number << " clauses");
+}
@@ -84,6 +84,8 @@ SCENARIO("ic3_solvert refutes a property violated in the initial state")
       auto result = solver.solve();
       REQUIRE(result.outcome == ic3_resultt::outcomet::REFUTED);
       REQUIRE(result.counterexample_length == 1);
+      REQUIRE(result.inputs.size() == 1);
+      REQUIRE(result.initial_state == bvt{current});
     }
   }
 }
@@ -314,6 +316,82 @@ SCENARIO("ic3_solvert reports the length of a deeper counterexample")
       auto result = solver.solve();
       REQUIRE(result.outcome == ic3_resultt::outcomet::REFUTED);
       REQUIRE(result.counterexample_length == 4);
+      REQUIRE(result.inputs.size() == 4);
+
+      // the initial state is given over the netlist latches
+      REQUIRE(result.initial_state.size() == 2);
+      for(auto l : result.initial_state)
+        REQUIRE(((l == !b0) || (l == !b1)));
+    }
+  }
+}
+
+SCENARIO("ic3_solvert resumes from the frames of an earlier run")
+{
+  GIVEN("A 2-bit counter that saturates at 2, property = counter != 3")
+  {
+    netlistt netlist;
+
+    literalt b0 = netlist.new_input();
+    literalt b1 = netlist.new_input();
+
+    // next_b0 = !b0 AND !b1, next_b1 = b0 AND !b1: 0, 1, 2, 0, ...
+    literalt next_b0 = netlist.new_and_node(!b0, !b1);
+    literalt next_b1 = netlist.new_and_node(b0, !b1);
+
+    auto add_latch = [&netlist](irep_idt name, literalt current, literalt next)
+    {
+      var_mapt::vart var;
+      var.vartype = var_mapt::vart::vartypet::LATCH;
+      var.type = bool_typet{};
+      var.bits.resize(1);
+      var.bits[0].current = current;
+      var.bits[0].next = next;
+      netlist.var_map.map.emplace(name, var);
+      netlist.var_map.add(name, 0, var);
+    };
+
+    add_latch("b0", b0, next_b0);
+    add_latch("b1", b1, next_b1);
+
+    netlist.initial.push_back(!b0);
+    netlist.initial.push_back(!b1);
+
+    literalt prop_lit = !netlist.new_and_node(b0, b1);
+
+    null_message_handlert mh;
+
+    // the frames at the end of the first frame
+    std::size_t number_of_frames = 0;
+    std::vector<ic3_solvert::frame_clauset> frames;
+
+    ic3_solvert first(netlist, prop_lit, mh);
+    first.set_frame_callback(
+      [&](const ic3_solvert &solver)
+      {
+        if(number_of_frames == 0)
+        {
+          number_of_frames = solver.number_of_frames();
+          frames = solver.frames();
+        }
+      });
+
+    REQUIRE(first.solve().outcome == ic3_resultt::outcomet::PROVED);
+
+    THEN("A second run that restores the frames proves the property")
+    {
+      REQUIRE(number_of_frames == 2);
+
+      // the frame clauses are over the latches of the netlist
+      for(const auto &[level, clause] : frames)
+        for(auto l : clause)
+          REQUIRE(((l.var_no() == b0.var_no()) || (l.var_no() == b1.var_no())));
+
+      ic3_solvert second(netlist, prop_lit, mh);
+      second.restore_frames(number_of_frames, frames);
+
+      REQUIRE(second.number_of_frames() == number_of_frames);
+      REQUIRE(second.solve().outcome == ic3_resultt::outcomet::PROVED);
     }
   }
 }